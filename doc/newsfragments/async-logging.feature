@@ -0,0 +1 @@
+Added `--log-async` option that writes log messages from a background thread so that logging at high verbosity does not stall the event loop.
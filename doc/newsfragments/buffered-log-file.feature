@@ -0,0 +1 @@
+The log file is now kept open and buffered, and `--log-max-size` and `--log-generations` control how it is rotated.
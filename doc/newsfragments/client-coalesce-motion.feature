@@ -0,0 +1 @@
+Added the `--coalesce-motion <ms>|refresh` client option, which moves the mouse at most once per interval or per display refresh instead of once per received motion.
@@ -0,0 +1 @@
+The server measures the round-trip time and jitter of each client link from keep-alive messages, reports them in its metrics and logs a warning when a link degrades.
@@ -0,0 +1 @@
+Added per event type dispatch latency statistics. Sending SIGUSR2 (or the IDST IPC message) to input-leaps/input-leapc enables them, further requests log p50/p99/p99.9 queue wait and handler times.
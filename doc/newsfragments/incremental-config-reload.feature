@@ -0,0 +1 @@
+Reloading the server configuration now applies only what changed: clients stay connected unless their screen was removed, and are only sent options that changed.
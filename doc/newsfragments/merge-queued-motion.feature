@@ -0,0 +1 @@
+The server merges queued mouse motion on the primary screen so the cursor catches up under load instead of replaying a backlog.
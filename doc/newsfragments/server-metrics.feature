@@ -0,0 +1 @@
+The server can report live metrics such as per-client traffic, screen switches and event queue latency in the Prometheus text format, over IPC or on a Unix socket given with `--metrics-socket`.
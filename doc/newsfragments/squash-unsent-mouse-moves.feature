@@ -0,0 +1 @@
+Mouse moves that are still waiting to be sent to a slow client are now replaced by newer ones instead of queueing up behind them.
@@ -0,0 +1,218 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/AsyncLogWriter.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace inputleap {
+
+namespace {
+
+std::atomic<std::uint64_t> s_next_writer_id{1};
+
+// the ring of the current thread.  The ring is shared with the writer, which keeps draining it
+// after the thread has exited.
+struct ThreadRing {
+    ~ThreadRing()
+    {
+        if (ring) {
+            ring->abandon();
+        }
+    }
+
+    std::uint64_t writer_id = 0;
+    std::shared_ptr<LogRing> ring;
+};
+
+thread_local ThreadRing t_ring;
+
+} // namespace
+
+AsyncLogWriter::AsyncLogWriter(WriteFunc write, std::size_t ring_capacity) :
+    write_(std::move(write)),
+    ring_capacity_(ring_capacity),
+    id_(s_next_writer_id.fetch_add(1))
+{
+    thread_ = std::thread([this]() { run(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_cv_.notify_all();
+    thread_.join();
+}
+
+LogRing* AsyncLogWriter::ring_for_current_thread()
+{
+    if (t_ring.writer_id != id_) {
+        if (t_ring.ring) {
+            t_ring.ring->abandon();
+        }
+        t_ring.ring = std::make_shared<LogRing>(ring_capacity_);
+        t_ring.writer_id = id_;
+
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(t_ring.ring);
+    }
+    return t_ring.ring.get();
+}
+
+bool AsyncLogWriter::push(ELevel priority, std::time_t time, const char* file, int line,
+                          const char* text, std::size_t length)
+{
+    LogRing* ring = ring_for_current_thread();
+
+    LogRing::Record record;
+    record.sequence = sequence_.fetch_add(1, std::memory_order_relaxed);
+    record.time = time;
+    record.file = file;
+    record.line = line;
+    record.priority = priority;
+    record.length = static_cast<std::uint32_t>(std::min(length, ring->max_text_length()));
+
+    if (!ring->push(record, text)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // pairs with the fence in run().  either the writer sees the message before it sleeps or we
+    // see that it's sleeping.  it holds the mutex until it waits so the wake-up can't be lost.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        wake_cv_.notify_one();
+    }
+    return true;
+}
+
+void AsyncLogWriter::flush()
+{
+    // messages logged by the outputters themselves are written by the next pass
+    if (std::this_thread::get_id() == thread_.get_id()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::uint64_t request = ++flush_requested_;
+    wake_cv_.notify_all();
+    flushed_cv_.wait(lock, [this, request]() { return flush_done_ >= request; });
+}
+
+void AsyncLogWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        std::uint64_t flush_request = flush_requested_;
+        bool stop = stop_;
+
+        lock.unlock();
+        std::size_t written = write_pending();
+        report_dropped();
+        lock.lock();
+
+        if (flush_done_ < flush_request) {
+            flush_done_ = flush_request;
+            flushed_cv_.notify_all();
+        }
+        if (stop) {
+            break;
+        }
+        if (written == 0 && !stop_ && flush_requested_ == flush_done_) {
+            // sleep until a message, a flush or shutdown.  there is no timeout so an idle writer
+            // never wakes up.
+            sleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!has_pending()) {
+                wake_cv_.wait(lock);
+            }
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool AsyncLogWriter::has_pending()
+{
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (const auto& ring : rings_) {
+        if (ring->front() != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t AsyncLogWriter::write_pending()
+{
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+    }
+
+    // merge the rings by sequence number so messages keep the order they were logged in
+    std::size_t written = 0;
+    while (true) {
+        LogRing* oldest_ring = nullptr;
+        const LogRing::Record* oldest = nullptr;
+        for (const auto& ring : rings) {
+            const LogRing::Record* record = ring->front();
+            if (record != nullptr && (oldest == nullptr || record->sequence < oldest->sequence)) {
+                oldest_ring = ring.get();
+                oldest = record;
+            }
+        }
+        if (oldest == nullptr) {
+            break;
+        }
+        write_(static_cast<ELevel>(oldest->priority), oldest->time, oldest->file, oldest->line,
+               oldest->text());
+        oldest_ring->pop();
+        written++;
+    }
+
+    // forget rings of threads that have exited once they are drained
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                [](const std::shared_ptr<LogRing>& ring) {
+                                    return ring->is_abandoned() && ring->front() == nullptr;
+                                }),
+                 rings_.end());
+    return written;
+}
+
+void AsyncLogWriter::report_dropped()
+{
+    std::uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped == reported_dropped_) {
+        return;
+    }
+
+    char message[100];
+    std::snprintf(message, sizeof(message),
+                  "%llu log messages dropped because the log ring was full",
+                  static_cast<unsigned long long>(dropped - reported_dropped_));
+    reported_dropped_ = dropped;
+    write_(kWARNING, std::time(nullptr), __FILE__, __LINE__, message);
+}
+
+} // namespace inputleap
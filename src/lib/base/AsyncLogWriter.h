@@ -0,0 +1,111 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "base/ELevel.h"
+#include "base/LogRing.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace inputleap {
+
+//! Background writer for log messages
+/*!
+Moves the expensive part of logging off the threads that log.  Each thread that calls
+\c push() gets its own LogRing, so pushing a message is a copy into memory owned by that thread
+and never takes a lock after the first call.  A background thread takes the messages out of all
+rings in the order they were pushed and hands them to the write function.
+
+When a ring is full the message is dropped and counted.  The writer reports the number of
+dropped messages through the write function once space is available again.
+*/
+class AsyncLogWriter {
+public:
+    using WriteFunc = std::function<void(ELevel priority, std::time_t time,
+                                         const char* file, int line, const char* text)>;
+
+    static const std::size_t kDefaultRingCapacity = 64 * 1024;
+
+    //! Start the writer thread, \c write is called only on that thread
+    explicit AsyncLogWriter(WriteFunc write,
+                            std::size_t ring_capacity = kDefaultRingCapacity);
+
+    //! Write all pending messages and stop the writer thread
+    ~AsyncLogWriter();
+
+    //! @name manipulators
+    //@{
+
+    //! Queue a message
+    /*!
+    Copies \c length bytes of \c text into the ring of the calling thread, truncating messages
+    that are larger than a ring can hold.  Returns false if the message was dropped.
+    */
+    bool push(ELevel priority, std::time_t time, const char* file, int line,
+              const char* text, std::size_t length);
+
+    //! Wait until all messages pushed before the call have been written
+    void flush();
+
+    //@}
+    //! @name accessors
+    //@{
+
+    //! Returns the number of messages dropped because a ring was full
+    std::uint64_t dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+
+    //@}
+
+private:
+    LogRing* ring_for_current_thread();
+    void run();
+    bool has_pending();
+    std::size_t write_pending();
+    void report_dropped();
+
+    WriteFunc write_;
+    std::size_t ring_capacity_;
+    std::uint64_t id_;
+
+    std::atomic<std::uint64_t> sequence_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::uint64_t reported_dropped_ = 0;
+
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<LogRing>> rings_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable flushed_cv_;
+    std::atomic<bool> sleeping_{false};
+    bool stop_ = false;
+    std::uint64_t flush_requested_ = 0;
+    std::uint64_t flush_done_ = 0;
+
+    std::thread thread_;
+};
+
+} // namespace inputleap
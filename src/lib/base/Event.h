@@ -20,6 +20,7 @@
 
 #include "EventTypes.h"
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -140,12 +141,19 @@ public:
     */
     Flags getFlags() const { return flags_; }
 
+    /// Returns the time the event was added to the queue. Only set while dispatch statistics
+    /// are enabled, otherwise it is the clock's epoch.
+    std::chrono::steady_clock::time_point enqueue_time() const { return enqueue_time_; }
+
+    void set_enqueue_time(std::chrono::steady_clock::time_point time) { enqueue_time_ = time; }
+
 private:
     EventType type_ = EventType::UNKNOWN;
     void* target_ = nullptr;
     EventDataBase* data_ = nullptr;
     Flags flags_ = 0;
     EventDataBase* data_object_ = nullptr;
+    std::chrono::steady_clock::time_point enqueue_time_;
 };
 
 } // namespace inputleap
@@ -0,0 +1,129 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/EventDispatchStats.h"
+#include "base/MetricsText.h"
+#include "base/String.h"
+
+namespace inputleap {
+
+EventDispatchStats::TypeStats& EventDispatchStats::stats_for(EventType type)
+{
+    // note -- mutex_ must be locked on entry
+    auto& stats = stats_[static_cast<std::size_t>(type)];
+    if (!stats) {
+        stats = std::make_unique<TypeStats>();
+    }
+    return *stats;
+}
+
+void EventDispatchStats::record_queue_wait(EventType type, std::uint64_t us)
+{
+    if (type >= EventType::EVENT_COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_for(type).queue_wait.record(us);
+}
+
+void EventDispatchStats::record_handler(EventType type, std::uint64_t us)
+{
+    if (type >= EventType::EVENT_COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_for(type).handler.record(us);
+}
+
+void EventDispatchStats::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& stats : stats_) {
+        stats.reset();
+    }
+}
+
+std::uint64_t EventDispatchStats::handler_count(EventType type) const
+{
+    if (type >= EventType::EVENT_COUNT) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& stats = stats_[static_cast<std::size_t>(type)];
+    return stats ? stats->handler.count() : 0;
+}
+
+static std::string format_histogram(const LatencyHistogram& histogram)
+{
+    if (histogram.count() == 0) {
+        return "-";
+    }
+    return string::sprintf("p50=%llu p99=%llu p999=%llu max=%llu",
+        static_cast<unsigned long long>(histogram.value_at_percentile(50.0)),
+        static_cast<unsigned long long>(histogram.value_at_percentile(99.0)),
+        static_cast<unsigned long long>(histogram.value_at_percentile(99.9)),
+        static_cast<unsigned long long>(histogram.max()));
+}
+
+std::string EventDispatchStats::report() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::string result = "event dispatch latency (us):";
+    bool any = false;
+    for (std::size_t i = 0; i < stats_.size(); ++i) {
+        const auto& stats = stats_[i];
+        if (!stats) {
+            continue;
+        }
+        any = true;
+        result += string::sprintf("\n  %s: n=%llu wait[%s] handler[%s]",
+            event_type_to_string(static_cast<EventType>(i)),
+            static_cast<unsigned long long>(stats->handler.count()),
+            format_histogram(stats->queue_wait).c_str(),
+            format_histogram(stats->handler).c_str());
+    }
+    if (!any) {
+        result += " no samples";
+    }
+    return result;
+}
+
+void EventDispatchStats::write_metrics(MetricsText& metrics) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    metrics.family("inputleap_event_queue_wait_seconds", "summary",
+                   "Time events waited in the queue before dispatch.");
+    for (std::size_t i = 0; i < stats_.size(); ++i) {
+        if (stats_[i]) {
+            metrics.summary("inputleap_event_queue_wait_seconds", stats_[i]->queue_wait,
+                            {{"type", event_type_to_string(static_cast<EventType>(i))}});
+        }
+    }
+
+    metrics.family("inputleap_event_handler_seconds", "summary",
+                   "Time event handlers took.");
+    for (std::size_t i = 0; i < stats_.size(); ++i) {
+        if (stats_[i]) {
+            metrics.summary("inputleap_event_handler_seconds", stats_[i]->handler,
+                            {{"type", event_type_to_string(static_cast<EventType>(i))}});
+        }
+    }
+}
+
+} // namespace inputleap
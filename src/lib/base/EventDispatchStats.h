@@ -0,0 +1,76 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "base/EventTypes.h"
+#include "base/LatencyHistogram.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace inputleap {
+
+class MetricsText;
+
+//! Per event type dispatch latency statistics
+/*!
+Keeps two histograms for every event type: the time an event spent in the queue between
+\c IEventQueue::add_event() and dispatch, and the time its handler took.  Histograms are
+allocated on the first sample of each type.  All values are in microseconds.  Thread safe.
+*/
+class EventDispatchStats {
+public:
+    //! Record the time spent in the queue by an event of \p type
+    void record_queue_wait(EventType type, std::uint64_t us);
+
+    //! Record the time spent by the handler of an event of \p type
+    void record_handler(EventType type, std::uint64_t us);
+
+    //! Forget all recorded samples
+    void reset();
+
+    //! Number of handler samples recorded for \p type
+    std::uint64_t handler_count(EventType type) const;
+
+    //! Human readable report
+    /*!
+    Returns one line per event type that has samples, listing the sample count and the p50,
+    p99, p99.9 and maximum of queue wait and handler time.
+    */
+    std::string report() const;
+
+    //! Add the queue wait and handler times per event type as summaries to \p metrics
+    void write_metrics(MetricsText& metrics) const;
+
+private:
+    struct TypeStats {
+        LatencyHistogram queue_wait;
+        LatencyHistogram handler;
+    };
+
+    TypeStats& stats_for(EventType type);
+
+    mutable std::mutex mutex_;
+    std::array<std::unique_ptr<TypeStats>,
+               static_cast<std::size_t>(EventType::EVENT_COUNT)> stats_;
+};
+
+} // namespace inputleap
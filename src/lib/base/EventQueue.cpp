@@ -23,6 +23,8 @@
 #include "base/Stopwatch.h"
 #include "base/EventTypes.h"
 #include "base/Log.h"
+#include "base/MetricsText.h"
+#include "base/String.h"
 #include "base/XBase.h"
 
 namespace inputleap {
@@ -36,11 +38,50 @@ interrupt(Arch::ESignal, void* data)
     events->add_event(EventType::QUIT);
 }
 
+// user signal handler.  the first signal enables dispatch statistics, the
+// following ones log them.
+static
+void
+dump_dispatch_stats(Arch::ESignal, void* data)
+{
+    EventQueue* events = static_cast<EventQueue*>(data);
+    if (!events->is_dispatch_stats_enabled()) {
+        events->set_dispatch_stats_enabled(true);
+        LOG((CLOG_NOTE "event dispatch statistics enabled"));
+        return;
+    }
+    LOG((CLOG_NOTE "%s", events->get_dispatch_stats_report().c_str()));
+}
+
+static bool is_input_event(EventType type)
+{
+    switch (type) {
+    case EventType::KEY_STATE_KEY_DOWN:
+    case EventType::KEY_STATE_KEY_UP:
+    case EventType::KEY_STATE_KEY_REPEAT:
+    case EventType::PRIMARY_SCREEN_BUTTON_DOWN:
+    case EventType::PRIMARY_SCREEN_BUTTON_UP:
+    case EventType::PRIMARY_SCREEN_WHEEL:
+    case EventType::PRIMARY_SCREEN_HOTKEY_DOWN:
+    case EventType::PRIMARY_SCREEN_HOTKEY_UP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static std::uint64_t to_microseconds(std::chrono::steady_clock::duration duration)
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    return us > 0 ? static_cast<std::uint64_t>(us) : 0;
+}
+
 EventQueue::EventQueue() :
     m_systemTarget(0)
 {
     ARCH->setSignalHandler(Arch::kINTERRUPT, &interrupt, this);
     ARCH->setSignalHandler(Arch::kTERMINATE, &interrupt, this);
+    ARCH->setSignalHandler(Arch::kUSER, &dump_dispatch_stats, this);
     buffer_ = std::make_unique<SimpleEventQueueBuffer>();
 }
 
@@ -48,6 +89,7 @@ EventQueue::~EventQueue()
 {
     ARCH->setSignalHandler(Arch::kINTERRUPT, nullptr, nullptr);
     ARCH->setSignalHandler(Arch::kTERMINATE, nullptr, nullptr);
+    ARCH->setSignalHandler(Arch::kUSER, nullptr, nullptr);
 }
 
 void
@@ -62,8 +104,10 @@ EventQueue::loop()
     LOG((CLOG_DEBUG "event queue is ready"));
     while (!m_pending.empty()) {
         LOG((CLOG_DEBUG "add pending events to buffer"));
-        Event& event = m_pending.front();
-        add_event_to_buffer(std::move(event));
+        if (m_pending.front().second) {
+            stop_merging();
+        }
+        add_event_to_buffer(std::move(m_pending.front().first));
         m_pending.pop();
     }
 
@@ -96,6 +140,7 @@ EventQueue::adoptBuffer(IEventQueueBuffer* buffer)
     }
     m_events.clear();
     m_oldEventIDs.clear();
+    m_mergeableEvents.clear();
 
     // use new buffer
     buffer_.reset(buffer);
@@ -168,18 +213,35 @@ EventQueue::dispatchEvent(const Event& event)
 {
     void* target   = event.getTarget();
 
-    const auto* type_handler = get_handler(event.getType(), target);
-    if (type_handler) {
-        (*type_handler)(event);
-        return true;
+    const auto* handler = get_handler(event.getType(), target);
+    if (handler == nullptr) {
+        handler = get_handler(EventType::UNKNOWN, target);
+    }
+    if (handler == nullptr) {
+        return false;
     }
 
-    const auto* any_handler = get_handler(EventType::UNKNOWN, target);
-    if (any_handler) {
-        (*any_handler)(event);
-        return true;
+    if (dispatch_stats_enabled_.load(std::memory_order_relaxed)) {
+        dispatch_with_stats(event, *handler);
+    } else {
+        (*handler)(event);
+    }
+    return true;
+}
+
+void EventQueue::dispatch_with_stats(const Event& event, const EventHandler& handler)
+{
+    EventType type = event.getType();
+
+    auto start = std::chrono::steady_clock::now();
+    if (event.enqueue_time() != std::chrono::steady_clock::time_point{}) {
+        dispatch_stats_.record_queue_wait(type, to_microseconds(start - event.enqueue_time()));
     }
-    return false;
+
+    handler(event);
+
+    dispatch_stats_.record_handler(type,
+                                   to_microseconds(std::chrono::steady_clock::now() - start));
 }
 
 void EventQueue::add_event(Event&& event)
@@ -195,12 +257,27 @@ void EventQueue::add_event(Event&& event)
         break;
     }
 
+    if (dispatch_stats_enabled_.load(std::memory_order_relaxed)) {
+        event.set_enqueue_time(std::chrono::steady_clock::now());
+    }
+
+    // input for any target keeps queued events from being merged into,
+    // even input that's delivered immediately, since input handlers
+    // forward events
+    if (is_input_event(event.getType())) {
+        stop_merging();
+        if (!is_ready_) {
+            m_pendingAfterInput = true;
+        }
+    }
+
     if ((event.getFlags() & Event::kDeliverImmediately) != 0) {
         dispatchEvent(event);
         Event::deleteData(event);
     }
     else if (!is_ready_) {
-        m_pending.push(std::move(event));
+        m_pending.push(std::make_pair(std::move(event), m_pendingAfterInput));
+        m_pendingAfterInput = false;
     } else {
         add_event_to_buffer(std::move(event));
     }
@@ -210,6 +287,22 @@ void EventQueue::add_event_to_buffer(Event&& event)
 {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    // merge into the queued event for the target if it's of the same type.
+    // any other event for the target keeps it from being merged into.
+    void* target = event.getTarget();
+    auto mergeable = m_mergeableEvents.find(target);
+    if (mergeable != m_mergeableEvents.end()) {
+        Event& queued = m_events[mergeable->second];
+        if (queued.getType() == event.getType()) {
+            m_mergers[event.getType()](queued, event);
+            Event::deleteData(event);
+            merged_events_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_mergeableEvents.erase(mergeable);
+    }
+    bool canMerge = (m_mergers.count(event.getType()) != 0);
+
     // store the event's data locally
     std::uint32_t eventID = save_event(std::move(event));
 
@@ -219,6 +312,39 @@ void EventQueue::add_event_to_buffer(Event&& event)
         auto removed_event = removeEvent(eventID);
         Event::deleteData(removed_event);
     }
+    else if (canMerge) {
+        m_mergeableEvents[target] = eventID;
+    }
+}
+
+void EventQueue::stop_merging()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    m_mergeableEvents.clear();
+}
+
+void EventQueue::set_event_merger(EventType type, const EventMerger& merger)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (merger) {
+        m_mergers[type] = merger;
+        return;
+    }
+
+    m_mergers.erase(type);
+    for (auto i = m_mergeableEvents.begin(); i != m_mergeableEvents.end(); ) {
+        if (m_events[i->second].getType() == type) {
+            i = m_mergeableEvents.erase(i);
+        }
+        else {
+            ++i;
+        }
+    }
+}
+
+std::uint64_t EventQueue::get_merged_event_count() const
+{
+    return merged_events_.load(std::memory_order_relaxed);
 }
 
 EventQueueTimer*
@@ -352,6 +478,12 @@ Event EventQueue::removeEvent(std::uint32_t eventID)
     Event event = std::move(index->second);
     m_events.erase(index);
 
+    // nothing can be merged into it anymore
+    auto mergeable = m_mergeableEvents.find(event.getTarget());
+    if (mergeable != m_mergeableEvents.end() && mergeable->second == eventID) {
+        m_mergeableEvents.erase(mergeable);
+    }
+
     // save old id for reuse
     m_oldEventIDs.push_back(eventID);
 
@@ -423,6 +555,42 @@ EventQueue::getSystemTarget()
     return &m_systemTarget;
 }
 
+void EventQueue::set_dispatch_stats_enabled(bool enabled)
+{
+    dispatch_stats_enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+bool EventQueue::is_dispatch_stats_enabled() const
+{
+    return dispatch_stats_enabled_.load(std::memory_order_relaxed);
+}
+
+std::string EventQueue::get_dispatch_stats_report() const
+{
+    return dispatch_stats_.report() +
+            string::sprintf("\nmerged queued events: %llu",
+                            static_cast<unsigned long long>(get_merged_event_count()));
+}
+
+void EventQueue::write_metrics(MetricsText& metrics) const
+{
+    std::size_t depth;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        depth = m_events.size();
+    }
+    metrics.family("inputleap_event_queue_depth", "gauge", "Events waiting in the queue.");
+    metrics.sample("inputleap_event_queue_depth", static_cast<std::uint64_t>(depth));
+
+    metrics.family("inputleap_event_queue_merged_events_total", "counter",
+                   "Events merged into an event that was already queued.");
+    metrics.sample("inputleap_event_queue_merged_events_total", get_merged_event_count());
+
+    if (is_dispatch_stats_enabled()) {
+        dispatch_stats_.write_metrics(metrics);
+    }
+}
+
 void
 EventQueue::waitForReady() const
 {
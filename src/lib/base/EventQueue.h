@@ -21,15 +21,18 @@
 #include "arch/IArchMultithread.h"
 #include "base/IEventQueue.h"
 #include "base/Event.h"
+#include "base/EventDispatchStats.h"
 #include "base/PriorityQueue.h"
 #include "base/Stopwatch.h"
 
+#include <atomic>
 #include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <set>
+#include <utility>
 
 namespace inputleap {
 
@@ -57,6 +60,12 @@ public:
     void removeHandlers(void* target) override;
     void* getSystemTarget() override;
     void waitForReady() const override;
+    void set_dispatch_stats_enabled(bool enabled) override;
+    bool is_dispatch_stats_enabled() const override;
+    std::string get_dispatch_stats_report() const override;
+    void set_event_merger(EventType type, const EventMerger& merger) override;
+    std::uint64_t get_merged_event_count() const override;
+    void write_metrics(MetricsText& metrics) const override;
 
 private:
     std::uint32_t save_event(Event&& event);
@@ -64,6 +73,8 @@ private:
     bool hasTimerExpired(Event& event);
     double getNextTimerTimeout() const;
     void add_event_to_buffer(Event&& event);
+    void stop_merging();
+    void dispatch_with_stats(const Event& event, const EventHandler& handler);
 
 private:
     class Timer {
@@ -118,6 +129,12 @@ private:
     // event handlers
     HandlerTable m_handlers;
 
+    // the queued event, per target, that later events of its type are
+    // merged into.  an entry is dropped when its event leaves the queue.
+    std::map<EventType, EventMerger> m_mergers;
+    std::map<void*, std::uint32_t> m_mergeableEvents;
+    std::atomic<std::uint64_t> merged_events_{0};
+
 private:
     // returns nullptr if handler is not found
     const EventHandler* get_handler(EventType type, void* target) const;
@@ -125,7 +142,15 @@ private:
     mutable std::mutex          ready_mutex_;
     mutable std::condition_variable ready_cv_;
     bool                        is_ready_ = false;
-    std::queue<Event> m_pending;
+    // events added before the buffer is ready, each with whether input
+    // came before it.  queued events can't be merged into across input.
+    std::queue<std::pair<Event, bool>> m_pending;
+    bool m_pendingAfterInput = false;
+
+    // dispatch latency statistics; the flag is checked before touching the clock so that
+    // disabled statistics cost a single relaxed load per event
+    std::atomic<bool> dispatch_stats_enabled_{false};
+    EventDispatchStats dispatch_stats_;
 };
 
 } // namespace inputleap
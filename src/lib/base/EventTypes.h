@@ -189,6 +189,11 @@ enum class EventType : std::uint32_t {
     SERVER_APP_FORCE_RECONNECT,
     SERVER_APP_RESET_SERVER,
 
+    /** This event is sent when a client connects to the metrics socket. The event data is the
+        file descriptor of the connection.
+    */
+    METRICS_SOCKET_CONNECTION,
+
     /// This event is sent when key is down. Event data is an instance of KeyInfo (count == 1)
     KEY_STATE_KEY_DOWN,
     /// This event is sent when key is up. Event data is an instance of KeyInfo (count == 1)
@@ -277,4 +282,7 @@ enum class EventType : std::uint32_t {
     EVENT_COUNT,
 };
 
+/// Returns the name of the event type as spelled in the source, e.g. "KEY_STATE_KEY_DOWN"
+const char* event_type_to_string(EventType type);
+
 } // namespace inputleap
@@ -26,6 +26,7 @@
 namespace inputleap {
 
 class IEventQueueBuffer;
+class MetricsText;
 
 // Opaque type for timer info.  This is defined by subclasses of
 // IEventQueueBuffer.
@@ -41,6 +42,7 @@ timers which generate events periodically.
 class IEventQueue {
 public:
     using EventHandler = std::function<void(const Event&)>;
+    using EventMerger = std::function<void(Event& queued, const Event& later)>;
 
     virtual ~IEventQueue() { }
 
@@ -168,6 +170,23 @@ public:
     */
     virtual void waitForReady() const = 0;
 
+    //! Enable or disable dispatch latency statistics
+    /*!
+    While enabled, the queue records for every event type how long events waited in the queue
+    and how long their handlers took.  Disabling keeps the samples collected so far.
+    */
+    virtual void set_dispatch_stats_enabled(bool enabled) = 0;
+
+    //! Merge events of a type while they are queued
+    /*!
+    While an event of type \p type is waiting in the queue, later events of
+    that type for the same target are merged into it by \p merger instead
+    of being queued after it.  Any other event for the target ends the
+    merging, so the order of events for a target is kept.  Passing an empty
+    \p merger queues events of the type as usual again.
+    */
+    virtual void set_event_merger(EventType type, const EventMerger& merger) = 0;
+
     //@}
     //! @name accessors
     //@{
@@ -178,6 +197,30 @@ public:
     */
     virtual void* getSystemTarget() = 0;
 
+    //! Check if dispatch latency statistics are collected
+    virtual bool is_dispatch_stats_enabled() const = 0;
+
+    //! Get dispatch latency statistics
+    /*!
+    Returns a human readable report of the p50/p99/p99.9 queue wait and handler times per
+    event type, see \c set_dispatch_stats_enabled().
+    */
+    virtual std::string get_dispatch_stats_report() const = 0;
+
+    //! Get the number of merged events
+    /*!
+    Returns how many events were merged into queued events, see
+    \c set_event_merger().
+    */
+    virtual std::uint64_t get_merged_event_count() const = 0;
+
+    //! Get metrics
+    /*!
+    Adds the queue depth, the merged event count and, while dispatch
+    statistics are enabled, the dispatch latencies to \p metrics.
+    */
+    virtual void write_metrics(MetricsText& metrics) const = 0;
+
     //@}
 };
 
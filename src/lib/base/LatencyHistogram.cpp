@@ -0,0 +1,89 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace inputleap {
+
+constexpr std::uint64_t LatencyHistogram::kMaxTrackableValue;
+
+unsigned LatencyHistogram::bucket_index(std::uint64_t value)
+{
+    if (value < kSubBucketCount) {
+        return static_cast<unsigned>(value);
+    }
+
+    // shift is chosen so that (value >> shift) lands in [kSubBucketCount, 2 * kSubBucketCount)
+    unsigned shift = 0;
+    while ((value >> shift) >= 2 * kSubBucketCount) {
+        ++shift;
+    }
+    unsigned sub_bucket = static_cast<unsigned>(value >> shift);
+    return (shift + 1) * kSubBucketCount + (sub_bucket - kSubBucketCount);
+}
+
+std::uint64_t LatencyHistogram::highest_equivalent_value(unsigned index)
+{
+    if (index < 2 * kSubBucketCount) {
+        return index;
+    }
+    unsigned shift = index / kSubBucketCount - 1;
+    std::uint64_t sub_bucket = index % kSubBucketCount + kSubBucketCount;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t value)
+{
+    value = std::min(value, kMaxTrackableValue);
+    buckets_[bucket_index(value)]++;
+    count_++;
+    max_ = std::max(max_, value);
+    sum_ += value;
+}
+
+void LatencyHistogram::reset()
+{
+    buckets_.fill(0);
+    count_ = 0;
+    max_ = 0;
+    sum_ = 0;
+}
+
+std::uint64_t LatencyHistogram::value_at_percentile(double percentile) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    auto target = static_cast<std::uint64_t>(std::ceil(percentile / 100.0 * count_));
+    target = std::max<std::uint64_t>(target, 1);
+
+    std::uint64_t seen = 0;
+    for (unsigned i = 0; i < kBucketCount; ++i) {
+        seen += buckets_[i];
+        if (seen >= target) {
+            return std::min(highest_equivalent_value(i), max_);
+        }
+    }
+    return max_;
+}
+
+} // namespace inputleap
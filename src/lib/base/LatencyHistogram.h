@@ -0,0 +1,74 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace inputleap {
+
+//! Fixed-precision latency histogram
+/*!
+Records non-negative integer values (typically microseconds) into log-linear buckets in the
+style of HdrHistogram: values below 16 are stored exactly, larger values are stored in one of
+8 linear sub-buckets per power of two, which bounds the relative error to 12.5%.  Recording is
+a handful of shifts and an increment and never allocates.  Not thread safe.
+*/
+class LatencyHistogram {
+public:
+    //! Largest value that is tracked precisely; larger values are clamped to it
+    static constexpr std::uint64_t kMaxTrackableValue = (std::uint64_t{1} << 40) - 1;
+
+    //! Record a single value
+    void record(std::uint64_t value);
+
+    //! Forget all recorded values
+    void reset();
+
+    //! Number of recorded values
+    std::uint64_t count() const { return count_; }
+
+    //! Largest recorded value
+    std::uint64_t max() const { return max_; }
+
+    //! Sum of the recorded values
+    std::uint64_t sum() const { return sum_; }
+
+    //! Value at the given percentile
+    /*!
+    Returns the highest value that is equivalent (i.e. falls into the same bucket) to the value
+    at \p percentile, which must be within [0, 100].  The result never exceeds max().  Returns
+    0 if nothing has been recorded.
+    */
+    std::uint64_t value_at_percentile(double percentile) const;
+
+private:
+    static constexpr unsigned kSubBucketBits = 3;
+    static constexpr unsigned kSubBucketCount = 1u << kSubBucketBits;
+    static constexpr unsigned kBucketCount = (40 - kSubBucketBits + 1) * kSubBucketCount;
+
+    static unsigned bucket_index(std::uint64_t value);
+    static std::uint64_t highest_equivalent_value(unsigned index);
+
+    std::array<std::uint64_t, kBucketCount> buckets_ = {};
+    std::uint64_t count_ = 0;
+    std::uint64_t max_ = 0;
+    std::uint64_t sum_ = 0;
+};
+
+} // namespace inputleap
@@ -18,6 +18,7 @@
 
 #include "arch/Arch.h"
 #include "arch/XArch.h"
+#include "base/AsyncLogWriter.h"
 #include "base/Log.h"
 #include "base/log_outputters.h"
 #include "common/Version.h"
@@ -79,6 +80,10 @@ Log::Log(Log* src)
 
 Log::~Log()
 {
+    // write out queued messages while the outputters still exist
+    m_async = false;
+    m_asyncWriter.reset();
+
     // clean up
     for (OutputterList::iterator index    = m_outputters.begin();
                                     index != m_outputters.end(); ++index) {
@@ -113,22 +118,12 @@ Log::getFilterName(int level) const
 }
 
 void
-Log::print(const char* file, int line, const char* fmt, ...)
+Log::print(int level, const char* file, int line, const char* fmt, ...)
 {
-    // check if fmt begins with a priority argument
-    ELevel priority = kINFO;
-    if ((strlen(fmt) > 2) && (fmt[0] == '%' && fmt[1] == 'z')) {
-
-        // 060 in octal is 0 (48 in decimal), so subtracting this converts ascii
-        // number it a true number. we could use atoi instead, but this is how
-        // it was done originally.
-        priority = static_cast<ELevel>(fmt[2] - '\060');
+    ELevel priority = static_cast<ELevel>(level);
 
-        // move the pointer on past the debug priority char
-        fmt += 3;
-    }
-
-    // done if below priority threshold
+    // done if below priority threshold.  the LOG() macros have already
+    // checked this but print() may also be called directly.
     if (priority > getFilter()) {
         return;
     }
@@ -165,14 +160,34 @@ Log::print(const char* file, int line, const char* fmt, ...)
         }
     }
 
+    if (m_async.load(std::memory_order_acquire)) {
+        // fatal messages may be followed by an abort and printed messages by an exit, so they
+        // cannot wait for the writer thread
+        if (priority != kPRINT && priority != kFATAL) {
+            m_asyncWriter->push(priority, std::time(nullptr), file, line, buffer, strlen(buffer));
+        } else {
+            m_asyncWriter->flush();
+            writeMessage(priority, std::time(nullptr), file, line, buffer);
+        }
+    } else {
+        writeMessage(priority, std::time(nullptr), file, line, buffer);
+    }
+
+    // clean up
+    if (buffer != stack) {
+        delete[] buffer;
+    }
+}
+
+void
+Log::writeMessage(ELevel priority, std::time_t t, const char* file, int line, const char* text)
+{
     // print the prefix to the buffer.    leave space for priority label.
     // do not prefix time and file for kPRINT (CLOG_PRINT)
     if (priority != kPRINT) {
 
         struct tm *tm;
         char timestamp[50];
-        time_t t;
-        time(&t);
         tm = localtime(&t);
         sprintf(timestamp, "%04i-%02i-%02iT%02i:%02i:%02i", tm->tm_year + 1900, tm->tm_mon+1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec);
 
@@ -180,7 +195,7 @@ Log::print(const char* file, int line, const char* fmt, ...)
         size_t size = 10;
         size += strlen(timestamp);
         size += strlen(g_priority[priority]);
-        size += strlen(buffer);
+        size += strlen(text);
 #ifndef NDEBUG
         size += strlen(file);
         // assume there is no file contains over 100k lines of code
@@ -189,20 +204,15 @@ Log::print(const char* file, int line, const char* fmt, ...)
         char* message = new char[size];
 
 #ifndef NDEBUG
-        sprintf(message, "[%s] %s: %s\n\t%s,%d", timestamp, g_priority[priority], buffer, file, line);
+        sprintf(message, "[%s] %s: %s\n\t%s,%d", timestamp, g_priority[priority], text, file, line);
 #else
-        sprintf(message, "[%s] %s: %s", timestamp, g_priority[priority], buffer);
+        sprintf(message, "[%s] %s: %s", timestamp, g_priority[priority], text);
 #endif
 
         output(priority, message);
         delete[] message;
     } else {
-        output(priority, buffer);
-    }
-
-    // clean up
-    if (buffer != stack) {
-        delete[] buffer;
+        output(priority, text);
     }
 }
 
@@ -268,19 +278,50 @@ Log::setFilter(const char* maxPriority)
 void
 Log::setFilter(int maxPriority)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     m_maxPriority = maxPriority;
 }
 
 int
 Log::getFilter() const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     return m_maxPriority;
 }
 
 void
-Log::output(ELevel priority, char* msg)
+Log::setAsync(bool enabled)
+{
+    if (enabled) {
+        if (!m_asyncWriter) {
+            m_asyncWriter.reset(new AsyncLogWriter(
+                [this](ELevel priority, std::time_t t, const char* file, int line,
+                       const char* text) {
+                    writeMessage(priority, t, file, line, text);
+                }));
+        }
+        m_async.store(true, std::memory_order_release);
+    }
+    else {
+        m_async.store(false, std::memory_order_release);
+        if (m_asyncWriter) {
+            m_asyncWriter->flush();
+        }
+    }
+}
+
+bool
+Log::isAsync() const
+{
+    return m_async.load(std::memory_order_acquire);
+}
+
+std::uint64_t
+Log::getDroppedCount() const
+{
+    return m_asyncWriter ? m_asyncWriter->dropped_count() : 0;
+}
+
+void
+Log::output(ELevel priority, const char* msg)
 {
     assert(priority >= -1 && priority < g_numPriority);
     assert(msg != nullptr);
@@ -23,7 +23,11 @@
 #include "common/common.h"
 
 #include <stdarg.h>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
 #include <list>
+#include <memory>
 #include <mutex>
 
 #define CLOG (Log::getInstance())
@@ -31,6 +35,7 @@
 
 namespace inputleap {
 
+class AsyncLogWriter;
 class ILogOutputter;
 class Thread;
 
@@ -96,22 +101,52 @@ public:
     //! Set the minimum priority filter (by ordinal).
     void setFilter(int);
 
+    //! Enable or disable asynchronous output
+    /*!
+    In asynchronous mode \c print() only formats the message text and
+    copies it into a lock-free ring owned by the calling thread.  A
+    background thread adds the timestamp and priority and passes the
+    message to the outputters.  If a ring is full the message is dropped
+    and counted, see \c getDroppedCount().  FATAL and PRINT messages are
+    still written before \c print() returns, after everything queued
+    before them.  Disabling asynchronous mode waits until all queued
+    messages have been written.  Must not be called concurrently with
+    itself.
+    */
+    void setAsync(bool enabled);
+
     //@}
     //! @name accessors
     //@{
 
     //! Print a log message
     /*!
-    Print a log message using the printf-like \c format and arguments
-    preceded by the filename and line number.  If \c file is nullptr then
-    neither the file nor the line are printed.
+    Print a log message with the given \c priority using the printf-like
+    \c format and arguments preceded by the filename and line number.  If
+    \c file is nullptr then neither the file nor the line are printed.
     */
-    void print(const char* file, int line,
+    void print(int priority, const char* file, int line,
                             const char* format, ...);
 
     //! Get the minimum priority level.
     int getFilter() const;
 
+    //! Check if messages with the given priority pass the filter
+    /*!
+    Used by the LOG() macros to skip evaluating the arguments of messages
+    that would be discarded.  Does not lock.
+    */
+    static bool isEnabled(int priority)
+    {
+        return priority <= s_log->m_maxPriority.load(std::memory_order_relaxed);
+    }
+
+    //! Check if asynchronous output is enabled
+    bool isAsync() const;
+
+    //! Get the number of messages dropped in asynchronous mode
+    std::uint64_t getDroppedCount() const;
+
     //! Get the filter name of the current filter level.
     const char* getFilterName() const;
 
@@ -127,7 +162,9 @@ public:
     //@}
 
 private:
-    void output(ELevel priority, char* msg);
+    void writeMessage(ELevel priority, std::time_t time,
+                      const char* file, int line, const char* text);
+    void output(ELevel priority, const char* msg);
 
 private:
     typedef std::list<ILogOutputter*> OutputterList;
@@ -138,7 +175,9 @@ private:
     OutputterList m_outputters;
     OutputterList m_alwaysOutputters;
     int m_maxNewlineLength;
-    int m_maxPriority;
+    std::atomic<int> m_maxPriority;
+    std::unique_ptr<AsyncLogWriter> m_asyncWriter;
+    std::atomic<bool> m_async{false};
 };
 
 /*!
@@ -154,6 +193,10 @@ replaced by one of enumerants in \c Log::ELevel without the leading
 \c k.  For example, \c CLOG_INFO.  The special \c CLOG_PRINT level will
 not be filtered and is never prefixed by the filename and line number.
 
+The priority is checked before the arguments are evaluated, so a message
+that is filtered out costs a single comparison.  Messages with a priority
+above \c INPUTLEAP_LOG_MAX_LEVEL are removed at compile time.
+
 If \c NOLOGGING is defined during the build then this macro expands to
 nothing.  If \c NDEBUG is defined during the build then it expands to a
 call to Log::print.  Otherwise it expands to a call to Log::printt,
@@ -180,36 +223,47 @@ to a call to Log::print that prints the filename and line number,
 otherwise it expands to a call that doesn't.
 */
 
+// messages above this priority are compiled out.  set the CMake variable
+// INPUTLEAP_LOG_MAX_LEVEL to e.g. DEBUG2 to strip the most verbose levels.
+#ifndef INPUTLEAP_LOG_MAX_LEVEL
+#define INPUTLEAP_LOG_MAX_LEVEL    kDEBUG5
+#endif
+
+// extracts the priority from the parenthesized arguments of LOG()
+#define CLOG_PRIORITY(_priority, ...)    (_priority)
+
+#define CLOG_ENABLED(_a1) \
+    (CLOG_PRIORITY _a1 <= INPUTLEAP_LOG_MAX_LEVEL && inputleap::Log::isEnabled(CLOG_PRIORITY _a1))
+
 #if defined(NOLOGGING)
 #define LOG(_a1)
 #define LOGC(_a1, _a2)
 #define CLOG_TRACE
 #elif defined(NDEBUG)
-#define LOG(_a1)        CLOG->print _a1
-#define LOGC(_a1, _a2)    if (_a1) CLOG->print _a2
+#define LOG(_a1)        (CLOG_ENABLED(_a1) ? CLOG->print _a1 : (void) 0)
+#define LOGC(_a1, _a2)    if (_a1) LOG(_a2)
 #define CLOG_TRACE        nullptr, 0,
 #else
-#define LOG(_a1)        CLOG->print _a1
-#define LOGC(_a1, _a2)    if (_a1) CLOG->print _a2
+#define LOG(_a1)        (CLOG_ENABLED(_a1) ? CLOG->print _a1 : (void) 0)
+#define LOGC(_a1, _a2)    if (_a1) LOG(_a2)
 #define CLOG_TRACE        __FILE__, __LINE__,
 #endif
 
-// the CLOG_* defines are line and file plus %z and an octal number (060=0,
-// 071=9), but the limitation is that once we run out of numbers at either
-// end, then we resort to using non-numerical chars. this still works (since
-// to deduce the number we subtract octal \060, so '/' is -1, and ':' is 10
-
-#define CLOG_PRINT        CLOG_TRACE "%z\057" // char is '/'
-#define CLOG_CRIT        CLOG_TRACE "%z\060" // char is '0'
-#define CLOG_ERR        CLOG_TRACE "%z\061"
-#define CLOG_WARN        CLOG_TRACE "%z\062"
-#define CLOG_NOTE        CLOG_TRACE "%z\063"
-#define CLOG_INFO        CLOG_TRACE "%z\064"
-#define CLOG_DEBUG        CLOG_TRACE "%z\065"
-#define CLOG_DEBUG1        CLOG_TRACE "%z\066"
-#define CLOG_DEBUG2        CLOG_TRACE "%z\067"
-#define CLOG_DEBUG3        CLOG_TRACE "%z\070"
-#define CLOG_DEBUG4        CLOG_TRACE "%z\071" // char is '9'
-#define CLOG_DEBUG5        CLOG_TRACE "%z\072" // char is ':'
+// the CLOG_* defines are the priority, file and line.  the priority comes
+// first so that the LOG() macros can check it without evaluating the
+// message arguments.
+
+#define CLOG_PRINT        kPRINT, CLOG_TRACE
+#define CLOG_CRIT        kFATAL, CLOG_TRACE
+#define CLOG_ERR        kERROR, CLOG_TRACE
+#define CLOG_WARN        kWARNING, CLOG_TRACE
+#define CLOG_NOTE        kNOTE, CLOG_TRACE
+#define CLOG_INFO        kINFO, CLOG_TRACE
+#define CLOG_DEBUG        kDEBUG, CLOG_TRACE
+#define CLOG_DEBUG1        kDEBUG1, CLOG_TRACE
+#define CLOG_DEBUG2        kDEBUG2, CLOG_TRACE
+#define CLOG_DEBUG3        kDEBUG3, CLOG_TRACE
+#define CLOG_DEBUG4        kDEBUG4, CLOG_TRACE
+#define CLOG_DEBUG5        kDEBUG5, CLOG_TRACE
 
 } // namespace inputleap
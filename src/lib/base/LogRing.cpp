@@ -0,0 +1,119 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/LogRing.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace inputleap {
+
+namespace {
+
+// marks the remainder of the buffer as unused, the next record starts at the beginning
+const std::uint32_t kWrapMarker = std::numeric_limits<std::uint32_t>::max();
+
+} // namespace
+
+LogRing::LogRing(std::size_t capacity) :
+    buffer_(new char[capacity]),
+    capacity_(capacity)
+{
+    assert(capacity >= 4 * sizeof(Record));
+    assert((capacity & (capacity - 1)) == 0);
+}
+
+std::size_t LogRing::record_size(std::size_t length)
+{
+    // keep every record aligned for the header that follows it
+    std::size_t size = sizeof(Record) + length + 1;
+    return (size + alignof(Record) - 1) & ~(alignof(Record) - 1);
+}
+
+std::size_t LogRing::max_text_length() const
+{
+    // a record may have to skip up to its own size at the end of the buffer, so records larger
+    // than half the ring could never be pushed into a non-empty ring
+    return capacity_ / 2 - sizeof(Record) - alignof(Record);
+}
+
+bool LogRing::push(const Record& header, const char* text)
+{
+    assert(header.length <= max_text_length());
+
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    std::size_t tail = tail_.load(std::memory_order_acquire);
+
+    std::size_t size = record_size(header.length);
+    std::size_t offset = head & (capacity_ - 1);
+    std::size_t contiguous = capacity_ - offset;
+    std::size_t skip = contiguous < size ? contiguous : 0;
+
+    if (capacity_ - (head - tail) < skip + size) {
+        return false;
+    }
+
+    if (skip != 0) {
+        // the consumer skips short gaps on its own, longer ones need a marker
+        if (skip >= sizeof(Record)) {
+            Record marker{};
+            marker.length = kWrapMarker;
+            std::memcpy(buffer_.get() + offset, &marker, sizeof(marker));
+        }
+        head += skip;
+        offset = 0;
+    }
+
+    char* dst = buffer_.get() + offset;
+    std::memcpy(dst, &header, sizeof(header));
+    std::memcpy(dst + sizeof(header), text, header.length);
+    dst[sizeof(header) + header.length] = '\0';
+
+    head_.store(head + size, std::memory_order_release);
+    return true;
+}
+
+const LogRing::Record* LogRing::front()
+{
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    std::size_t head = head_.load(std::memory_order_acquire);
+
+    while (tail != head) {
+        std::size_t offset = tail & (capacity_ - 1);
+        std::size_t contiguous = capacity_ - offset;
+        if (contiguous >= sizeof(Record)) {
+            const Record* record = reinterpret_cast<const Record*>(buffer_.get() + offset);
+            if (record->length != kWrapMarker) {
+                return record;
+            }
+        }
+        tail += contiguous;
+        tail_.store(tail, std::memory_order_release);
+    }
+    return nullptr;
+}
+
+void LogRing::pop()
+{
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const Record* record = reinterpret_cast<const Record*>(buffer_.get() +
+                                                           (tail & (capacity_ - 1)));
+    tail_.store(tail + record_size(record->length), std::memory_order_release);
+}
+
+} // namespace inputleap
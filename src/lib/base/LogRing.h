@@ -0,0 +1,101 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "base/ELevel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+
+namespace inputleap {
+
+//! Single producer, single consumer ring of log records
+/*!
+A fixed size lock-free byte ring that carries formatted log messages from the thread that
+logged them to the asynchronous log writer.  Exactly one thread may call \c push() and exactly
+one other thread may call \c front() and \c pop().  Records are stored contiguously; a record
+that does not fit at the end of the buffer is moved to the beginning.
+*/
+class LogRing {
+public:
+    //! Header of a record.  The text and a terminating nul follow the header.
+    struct Record {
+        std::uint64_t sequence;
+        std::time_t time;
+        const char* file;
+        std::int32_t line;
+        std::int32_t priority;
+        std::uint32_t length;
+
+        const char* text() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    //! Create a ring, \c capacity must be a power of two
+    explicit LogRing(std::size_t capacity);
+
+    //! @name manipulators
+    //@{
+
+    //! Append a record (producer only)
+    /*!
+    Copies \c header and the first \c header.length bytes of \c text into the ring.  Returns
+    false without modifying the ring if there is not enough free space.
+    */
+    bool push(const Record& header, const char* text);
+
+    //! Get the oldest record (consumer only)
+    /*!
+    Returns nullptr if the ring is empty.  The record stays valid until \c pop() is called.
+    */
+    const Record* front();
+
+    //! Remove the record returned by the last call to \c front() (consumer only)
+    void pop();
+
+    //! Mark the ring as no longer used by its producer
+    void abandon() { abandoned_.store(true, std::memory_order_release); }
+
+    //@}
+    //! @name accessors
+    //@{
+
+    //! Returns the largest text length that can ever be pushed
+    std::size_t max_text_length() const;
+
+    //! Returns true if the producer has abandoned the ring
+    bool is_abandoned() const { return abandoned_.load(std::memory_order_acquire); }
+
+    //@}
+
+private:
+    static std::size_t record_size(std::size_t length);
+
+    std::unique_ptr<char[]> buffer_;
+    std::size_t capacity_;
+
+    // head_ and tail_ increase monotonically and are reduced modulo capacity_ on access.  They
+    // are kept on separate cache lines so the producer and consumer do not contend.
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::atomic<bool> abandoned_{false};
+};
+
+} // namespace inputleap
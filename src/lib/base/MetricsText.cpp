@@ -0,0 +1,105 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/MetricsText.h"
+#include "base/LatencyHistogram.h"
+#include "base/String.h"
+
+namespace inputleap {
+
+static void append_escaped(std::string& out, const std::string& value)
+{
+    for (char c : value) {
+        switch (c) {
+        case '\\': out += "\\\\"; break;
+        case '"':  out += "\\\""; break;
+        case '\n': out += "\\n"; break;
+        default:   out += c; break;
+        }
+    }
+}
+
+void MetricsText::family(const char* name, const char* type, const char* help)
+{
+    text_ += string::sprintf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+void MetricsText::sample(const char* name, std::uint64_t value, const Labels& labels)
+{
+    add_sample(name, labels, nullptr, nullptr,
+               string::sprintf("%llu", static_cast<unsigned long long>(value)));
+}
+
+void MetricsText::sample(const char* name, double value, const Labels& labels)
+{
+    add_sample(name, labels, nullptr, nullptr, string::sprintf("%.9g", value));
+}
+
+void MetricsText::summary(const char* name, const LatencyHistogram& histogram,
+                          const Labels& labels)
+{
+    static const struct {
+        const char* label;
+        double percentile;
+    } kQuantiles[] = { { "0.5", 50.0 }, { "0.99", 99.0 }, { "0.999", 99.9 } };
+
+    for (const auto& quantile : kQuantiles) {
+        double seconds = 1.0e-6 * static_cast<double>(
+                histogram.value_at_percentile(quantile.percentile));
+        add_sample(name, labels, "quantile", quantile.label, string::sprintf("%.9g", seconds));
+    }
+    std::string base = name;
+    add_sample((base + "_sum").c_str(), labels, nullptr, nullptr,
+               string::sprintf("%.9g", 1.0e-6 * static_cast<double>(histogram.sum())));
+    add_sample((base + "_count").c_str(), labels, nullptr, nullptr,
+               string::sprintf("%llu", static_cast<unsigned long long>(histogram.count())));
+}
+
+void MetricsText::add_sample(const char* name, const Labels& labels, const char* extra_label,
+                             const char* extra_value, const std::string& value)
+{
+    text_ += name;
+    if (!labels.empty() || extra_label != nullptr) {
+        text_ += '{';
+        bool first = true;
+        for (const auto& label : labels) {
+            if (!first) {
+                text_ += ',';
+            }
+            first = false;
+            text_ += label.first;
+            text_ += "=\"";
+            append_escaped(text_, label.second);
+            text_ += '"';
+        }
+        if (extra_label != nullptr) {
+            if (!first) {
+                text_ += ',';
+            }
+            text_ += extra_label;
+            text_ += "=\"";
+            text_ += extra_value;
+            text_ += '"';
+        }
+        text_ += '}';
+    }
+    text_ += ' ';
+    text_ += value;
+    text_ += '\n';
+}
+
+} // namespace inputleap
@@ -0,0 +1,61 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace inputleap {
+
+class LatencyHistogram;
+
+//! Metrics in the Prometheus text exposition format
+/*!
+Builds the text a Prometheus scraper expects: every metric family starts with its HELP and
+TYPE lines, followed by its samples.  Samples must be added right after the family they belong
+to.  Label values are escaped; names are used as given.
+*/
+class MetricsText {
+public:
+    using Labels = std::vector<std::pair<const char*, std::string>>;
+
+    //! Start a metric family of the given \p type ("counter", "gauge" or "summary")
+    void family(const char* name, const char* type, const char* help);
+
+    //! Add a sample with the given \p name, which must be the family or derived from it
+    void sample(const char* name, std::uint64_t value, const Labels& labels = {});
+
+    //! Add a sample with a fractional value
+    void sample(const char* name, double value, const Labels& labels = {});
+
+    //! Add the quantiles, sum and count of a histogram of microseconds as a summary in seconds
+    void summary(const char* name, const LatencyHistogram& histogram, const Labels& labels = {});
+
+    //! Returns the text built so far
+    const std::string& str() const { return text_; }
+
+private:
+    void add_sample(const char* name, const Labels& labels, const char* extra_label,
+                    const char* extra_value, const std::string& value);
+
+    std::string text_;
+};
+
+} // namespace inputleap
@@ -20,13 +20,18 @@
 #include "arch/Arch.h"
 #include "base/String.h"
 #include "io/filesystem.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
 namespace inputleap {
 
 enum EFileLogOutputter {
-    kFileSizeLimit = 1024 // kb
+    kFileSizeLimit = 1024, // kb
+    kFileGenerations = 1,
+    kFileBufferSize = 64 * 1024,
+    kFileFlushInterval = 1000 // ms
 };
 
 StopLogOutputter::StopLogOutputter()
@@ -238,55 +243,165 @@ BufferedLogOutputter::write(ELevel, const char* message)
 // FileLogOutputter
 //
 
-FileLogOutputter::FileLogOutputter(const char* logFile)
+FileLogOutputter::FileLogOutputter(const char* logFile) :
+    m_maxSize(kFileSizeLimit * 1024),
+    m_generations(kFileGenerations),
+    m_flushInterval(kFileFlushInterval)
 {
     setLogFilename(logFile);
+    m_flushThread = std::thread([this]() { flushThread(); });
 }
 
 FileLogOutputter::~FileLogOutputter()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopFlushThread = true;
+        closeFileLocked();
+    }
+    m_flushCond.notify_all();
+    m_flushThread.join();
 }
 
 void
 FileLogOutputter::setLogFilename(const char* logFile)
 {
     assert(logFile != nullptr);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    closeFileLocked();
     m_fileName = logFile;
 }
 
+void
+FileLogOutputter::setMaxSize(std::uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxSize = bytes;
+}
+
+void
+FileLogOutputter::setGenerations(int generations)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_generations = std::max(generations, 1);
+}
+
+void
+FileLogOutputter::setFlushInterval(std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_flushInterval = interval;
+}
+
 bool
 FileLogOutputter::write(ELevel level, const char *message)
 {
-    (void) level;
+    std::lock_guard<std::mutex> lock(m_mutex);
 
-    bool moveFile = false;
+    // the file is opened on first use and reopened after a failure
+    if (m_file == nullptr && !openFileLocked()) {
+        return true;
+    }
 
-    std::ofstream m_handle;
-    inputleap::open_utf8_path(m_handle, m_fileName, std::fstream::app);
-    if (m_handle.is_open() && m_handle.fail() != true) {
-        m_handle << message << std::endl;
+    size_t length = strlen(message);
+    if (std::fwrite(message, 1, length, m_file) != length || std::fputc('\n', m_file) == EOF) {
+        closeFileLocked();
+        return true;
+    }
+    m_size += length + 1;
 
-        // when file size exceeds limits, move to 'old log' filename.
-        size_t p = m_handle.tellp();
-        if (p > (kFileSizeLimit * 1024)) {
-            moveFile = true;
-        }
+    if (level <= kWARNING) {
+        std::fflush(m_file);
+        m_dirty = false;
     }
-    m_handle.close();
+    else if (!m_dirty) {
+        // start the flush timer
+        m_dirty = true;
+        m_flushCond.notify_all();
+    }
+
+    // when file size exceeds limits, move to 'old log' filename.
+    if (m_size > m_maxSize) {
+        rotateLocked();
+    }
+
+    return true;
+}
 
-    if (moveFile) {
-        std::string oldLogFilename = inputleap::string::sprintf("%s.1", m_fileName.c_str());
-        remove(oldLogFilename.c_str());
-        rename(m_fileName.c_str(), oldLogFilename.c_str());
+bool
+FileLogOutputter::openFileLocked()
+{
+    m_file = inputleap::fopen_utf8_path(inputleap::fs::u8path(m_fileName), "a");
+    if (m_file == nullptr) {
+        return false;
     }
+    std::setvbuf(m_file, nullptr, _IOFBF, kFileBufferSize);
 
+    std::fseek(m_file, 0, SEEK_END);
+    long position = std::ftell(m_file);
+    m_size = position > 0 ? static_cast<std::uint64_t>(position) : 0;
     return true;
 }
 
+void
+FileLogOutputter::closeFileLocked()
+{
+    if (m_file != nullptr) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    m_dirty = false;
+}
+
+void
+FileLogOutputter::rotateLocked()
+{
+    closeFileLocked();
+
+    auto generation = [this](int index) {
+        return inputleap::fs::u8path(inputleap::string::sprintf("%s.%d", m_fileName.c_str(),
+                                                                index));
+    };
+
+    // errors are ignored, there is nowhere to report them to
+    std::error_code ec;
+    inputleap::fs::remove(generation(m_generations), ec);
+    for (int i = m_generations - 1; i >= 1; i--) {
+        inputleap::fs::rename(generation(i), generation(i + 1), ec);
+    }
+    inputleap::fs::rename(inputleap::fs::u8path(m_fileName), generation(1), ec);
+
+    openFileLocked();
+}
+
+void
+FileLogOutputter::flushThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopFlushThread) {
+        if (!m_dirty) {
+            m_flushCond.wait(lock);
+            continue;
+        }
+
+        // give later messages the chance to share the write
+        m_flushCond.wait_for(lock, m_flushInterval, [this]() { return m_stopFlushThread; });
+        if (m_file != nullptr && m_dirty) {
+            std::fflush(m_file);
+        }
+        m_dirty = false;
+    }
+}
+
 void FileLogOutputter::open(const char *title) { (void) title; }
 
 void
-FileLogOutputter::close() {}
+FileLogOutputter::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    closeFileLocked();
+}
 
 void FileLogOutputter::show(bool showIfEmpty) { (void) showIfEmpty; }
 
@@ -21,11 +21,16 @@
 #include "mt/Thread.h"
 #include "base/ILogOutputter.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdio>
 #include <deque>
 #include <list>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace inputleap {
 
@@ -67,8 +72,12 @@ public:
 
 //! Write log to file
 /*!
-This outputter writes output to the file.  The level for each
-message is ignored.
+This outputter writes output to the file.  The file stays open and
+messages are collected in a buffer which is written out once per flush
+interval, when it is full, and immediately for messages at WARNING and
+above.  When the file grows beyond the size limit it is renamed to
+\c <file>.1, older logs move on to \c <file>.2 and so on, up to the
+number of generations.  The oldest generation is deleted.
 */
 
 class FileLogOutputter : public ILogOutputter {
@@ -84,8 +93,33 @@ public:
 
     void setLogFilename(const char* title);
 
+    //! Set the size in bytes at which the file is rotated
+    void setMaxSize(std::uint64_t bytes);
+
+    //! Set the number of rotated files to keep
+    void setGenerations(int generations);
+
+    //! Set the longest time a message may stay in the buffer
+    void setFlushInterval(std::chrono::milliseconds interval);
+
 private:
+    bool openFileLocked();
+    void closeFileLocked();
+    void rotateLocked();
+    void flushThread();
+
     std::string m_fileName;
+    std::FILE* m_file = nullptr;
+    std::uint64_t m_size = 0;
+    std::uint64_t m_maxSize;
+    int m_generations;
+    std::chrono::milliseconds m_flushInterval;
+
+    std::mutex m_mutex;
+    std::condition_variable m_flushCond;
+    bool m_dirty = false;
+    bool m_stopFlushThread = false;
+    std::thread m_flushThread;
 };
 
 //! Write log to system log
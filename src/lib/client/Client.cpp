@@ -323,6 +323,31 @@ void Client::mouseWheel(std::int32_t xDelta, std::int32_t yDelta)
     m_screen->mouseWheel(xDelta, yDelta);
 }
 
+double Client::getMotionInterval() const
+{
+    // refresh rate to assume when the screen doesn't know its own
+    static const double kDefaultRefreshRate = 60.0;
+
+    if (!m_args.coalesce_motion) {
+        return 0.0;
+    }
+    if (m_args.coalesce_motion_interval > 0.0) {
+        return m_args.coalesce_motion_interval;
+    }
+    double rate = m_screen->getRefreshRate();
+    return 1.0 / (rate > 0.0 ? rate : kDefaultRefreshRate);
+}
+
+void Client::fakeBatchBegin()
+{
+    m_screen->fakeBatchBegin();
+}
+
+void Client::fakeBatchEnd()
+{
+    m_screen->fakeBatchEnd();
+}
+
 void
 Client::screensaver(bool activate)
 {
@@ -93,6 +93,15 @@ public:
     //! Send dragging file information back to server
     void sendDragInfo(std::uint32_t fileCount, std::string& info, size_t size);
 
+    //! Begin a batch of synthesized input
+    /*!
+    Input synthesized until the matching \c fakeBatchEnd() may be queued
+    and delivered to the screen at once.  Batches may be nested.
+    */
+    void fakeBatchBegin();
+
+    //! End a batch of synthesized input
+    void fakeBatchEnd();
 
     //@}
     //! @name accessors
@@ -130,6 +139,13 @@ public:
     //! Return drag file list
     DragFileList getDragFileList() { return m_dragFileList; }
 
+    //! Get mouse motion interval
+    /*!
+    Returns the minimum time in seconds between synthesized mouse moves,
+    or 0 if mouse motion is not coalesced.
+    */
+    double getMotionInterval() const;
+
     //@}
 
     // IScreen overrides
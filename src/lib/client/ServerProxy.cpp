@@ -46,6 +46,9 @@ ServerProxy::ServerProxy(Client* client, inputleap::IStream* stream, IEventQueue
     m_yMouse(0),
     m_dxMouse(0),
     m_dyMouse(0),
+    m_motionInterval(client->getMotionInterval()),
+    m_lastMotionTime(0.0),
+    m_motionTimer(nullptr),
     m_ignoreMouse(false),
     m_keepAliveAlarm(0.0),
     m_keepAliveAlarmTimer(nullptr),
@@ -67,11 +70,20 @@ ServerProxy::ServerProxy(Client* client, inputleap::IStream* stream, IEventQueue
 
     // send heartbeat
     setKeepAliveRate(kKeepAliveRate);
+
+    if (m_motionInterval > 0.0) {
+        LOG((CLOG_DEBUG "coalescing mouse motion to one move per %.1fms",
+             1000.0 * m_motionInterval));
+    }
 }
 
 ServerProxy::~ServerProxy()
 {
     setKeepAliveRate(-1.0);
+    if (m_motionTimer != nullptr) {
+        m_events->removeHandler(EventType::TIMER, m_motionTimer);
+        m_events->deleteTimer(m_motionTimer);
+    }
     m_events->removeHandler(EventType::STREAM_INPUT_READY, m_stream->getEventTarget());
     m_events->removeHandler(EventType::CLIPBOARD_SENDING, this);
 }
@@ -101,6 +113,17 @@ ServerProxy::setKeepAliveRate(double rate)
 
 void ServerProxy::handle_data()
 {
+    // input synthesized for the messages of one read reaches the screen at
+    // once.  the batch holds on to the client because a disconnect deletes
+    // this proxy.
+    class FakeBatch {
+    public:
+        explicit FakeBatch(Client* client) : m_client(client) { m_client->fakeBatchBegin(); }
+        ~FakeBatch() { m_client->fakeBatchEnd(); }
+    private:
+        Client* m_client;
+    } batch(m_client);
+
     // handle messages until there are no more.  first read message code.
     std::uint8_t code[4];
     std::uint32_t n = m_stream->read(code, 4);
@@ -143,7 +166,7 @@ void ServerProxy::handle_data()
         n = m_stream->read(code, 4);
     }
 
-    flushCompressedMouse();
+    flushCoalescedMouse();
 }
 
 ServerProxy::EResult ServerProxy::parseHandshakeMessage(const std::uint8_t* code)
@@ -372,13 +395,47 @@ ServerProxy::flushCompressedMouse()
     if (m_compressMouse) {
         m_compressMouse = false;
         m_client->mouseMove(m_xMouse, m_yMouse);
+        m_lastMotionTime = m_motionClock.getTime();
     }
     if (m_compressMouseRelative) {
         m_compressMouseRelative = false;
         m_client->mouseRelativeMove(m_dxMouse, m_dyMouse);
         m_dxMouse = 0;
         m_dyMouse = 0;
+        m_lastMotionTime = m_motionClock.getTime();
+    }
+}
+
+void ServerProxy::flushCoalescedMouse()
+{
+    if (m_motionInterval <= 0.0) {
+        flushCompressedMouse();
+        return;
     }
+    if (!m_compressMouse && !m_compressMouseRelative) {
+        return;
+    }
+
+    double wait = m_lastMotionTime + m_motionInterval - m_motionClock.getTime();
+    if (wait <= 0.0) {
+        flushCompressedMouse();
+    }
+    else if (m_motionTimer == nullptr) {
+        m_motionTimer = m_events->newOneShotTimer(wait, nullptr);
+        m_events->add_handler(EventType::TIMER, m_motionTimer,
+                              [this](const auto& e){ handle_motion_timer(); });
+    }
+}
+
+void ServerProxy::handle_motion_timer()
+{
+    m_events->removeHandler(EventType::TIMER, m_motionTimer);
+    m_events->deleteTimer(m_motionTimer);
+    m_motionTimer = nullptr;
+
+    m_client->fakeBatchBegin();
+    flushCompressedMouse();
+    m_client->fakeBatchEnd();
 }
 
 void
@@ -702,8 +759,8 @@ ServerProxy::mouseMove()
     // note if we should ignore the move
     ignore = m_ignoreMouse;
 
-    // compress mouse motion events if more input follows
-    if (!ignore && !m_compressMouse && m_stream->isReady()) {
+    // compress mouse motion events if more input follows or if coalescing
+    if (!ignore && !m_compressMouse && (m_stream->isReady() || m_motionInterval > 0.0)) {
         m_compressMouse = true;
     }
 
@@ -735,8 +792,9 @@ ServerProxy::mouseRelativeMove()
     // note if we should ignore the move
     ignore = m_ignoreMouse;
 
-    // compress mouse motion events if more input follows
-    if (!ignore && !m_compressMouseRelative && m_stream->isReady()) {
+    // compress mouse motion events if more input follows or if coalescing
+    if (!ignore && !m_compressMouseRelative &&
+            (m_stream->isReady() || m_motionInterval > 0.0)) {
         m_compressMouseRelative = true;
     }
 
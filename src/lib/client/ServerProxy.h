@@ -21,6 +21,7 @@
 #include "inputleap/clipboard_types.h"
 #include "inputleap/key_types.h"
 #include "base/Event.h"
+#include "base/Stopwatch.h"
 
 namespace inputleap {
 
@@ -61,7 +62,7 @@ public:
     void sendDragInfo(std::uint32_t fileCount, const char* info, size_t size);
 
 #ifdef INPUTLEAP_TEST_ENV
-    void handleDataForTest() { handleData(Event(), nullptr); }
+    void handleDataForTest() { handle_data(); }
 #endif
 
 protected:
@@ -73,6 +74,10 @@ private:
     // if compressing mouse motion then send the last motion now
     void flushCompressedMouse();
 
+    // send compressed mouse motion now or, if coalescing, once the
+    // motion interval has passed
+    void flushCoalescedMouse();
+
     void sendInfo(const ClientInfo&);
 
     void resetKeepAliveAlarm();
@@ -85,6 +90,7 @@ private:
     // event handlers
     void handle_data();
     void handle_keep_alive_alarm();
+    void handle_motion_timer();
 
     // message handlers
     void enter();
@@ -121,6 +127,12 @@ private:
     std::int32_t m_xMouse, m_yMouse;
     std::int32_t m_dxMouse, m_dyMouse;
 
+    // minimum time between injected mouse moves, 0 if not coalescing
+    double m_motionInterval;
+    double m_lastMotionTime;
+    Stopwatch m_motionClock;
+    EventQueueTimer* m_motionTimer;
+
     bool m_ignoreMouse;
 
     KeyModifierID m_modifierTranslationTable[kKeyModifierIDLast];
@@ -19,6 +19,7 @@
 #include "inputleap/App.h"
 
 #include "base/Log.h"
+#include "base/MetricsText.h"
 #include "common/Version.h"
 #include "inputleap/protocol_types.h"
 #include "base/XBase.h"
@@ -119,6 +120,9 @@ App::run(int argc, char** argv)
 
     appUtil().beforeAppExit();
 
+    // write out messages still queued for the log writer thread
+    CLOG->setAsync(false);
+
     return result;
 }
 
@@ -138,6 +142,12 @@ App::setupFileLogging()
 {
     if (argsBase().m_logFile != nullptr) {
         m_fileLog = new FileLogOutputter(argsBase().m_logFile);
+        if (argsBase().m_logMaxSize > 0) {
+            m_fileLog->setMaxSize(static_cast<std::uint64_t>(argsBase().m_logMaxSize) * 1024);
+        }
+        if (argsBase().m_logGenerations > 0) {
+            m_fileLog->setGenerations(argsBase().m_logGenerations);
+        }
         CLOG->insert(m_fileLog);
         LOG((CLOG_DEBUG1 "logging to file (%s) enabled", argsBase().m_logFile));
     }
@@ -170,6 +180,10 @@ App::initApp(int argc, const char** argv)
     }
     loggingFilterWarning();
 
+    if (argsBase().m_logAsync) {
+        CLOG->setAsync(true);
+    }
+
     if (argsBase().m_enableDragDrop) {
         LOG((CLOG_INFO "drag and drop enabled"));
         if (!argsBase().m_dropTarget.empty()) {
@@ -222,6 +236,34 @@ void App::handle_ipc_message(const Event& e)
         LOG((CLOG_INFO "got ipc shutdown message"));
         m_events->add_event(EventType::QUIT);
     }
+    else if (m.type() == kIpcDispatchStats) {
+        if (!m_events->is_dispatch_stats_enabled()) {
+            m_events->set_dispatch_stats_enabled(true);
+            LOG((CLOG_NOTE "event dispatch statistics enabled"));
+        }
+        else {
+            LOG((CLOG_NOTE "%s", m_events->get_dispatch_stats_report().c_str()));
+        }
+    }
+    else if (m.type() == kIpcMetrics) {
+        m_ipcClient->send(IpcMetricsMessage(get_metrics()));
+    }
+}
+
+std::string App::get_metrics() const
+{
+    MetricsText metrics;
+    write_metrics(metrics);
+    return metrics.str();
+}
+
+void App::write_metrics(MetricsText& metrics) const
+{
+    m_events->write_metrics(metrics);
+
+    metrics.family("inputleap_log_dropped_messages_total", "counter",
+                   "Log messages dropped because the asynchronous log was full.");
+    metrics.sample("inputleap_log_dropped_messages_total", CLOG->getDroppedCount());
 }
 
 void App::run_events_loop()
@@ -41,6 +41,7 @@ class FileLogOutputter;
 class Screen;
 class IEventQueue;
 class SocketMultiplexer;
+class MetricsText;
 
 typedef IArchTaskBarReceiver* (*CreateTaskBarReceiverFunc)(const BufferedLogOutputter*, IEventQueue* events);
 
@@ -103,6 +104,9 @@ public:
 
     void setEvents(EventQueue& events) { m_events = &events; }
 
+    // Returns the metrics of this process in the Prometheus text format.
+    std::string get_metrics() const;
+
 private:
     void handle_ipc_message(const Event& event);
 
@@ -111,6 +115,10 @@ protected:
     void cleanupIpcClient();
     void run_events_loop();
 
+    // Adds the metrics of this process to \p metrics.  Subclasses add
+    // their own after calling this.
+    virtual void write_metrics(MetricsText& metrics) const;
+
     IArchTaskBarReceiver* m_taskBarReceiver;
     bool m_suspended;
     IEventQueue* m_events;
@@ -164,6 +172,10 @@ private:
     "  -1, --no-restart         do not try to restart on failure.\n" \
     "      --restart            restart the server automatically if it fails. (*)\n" \
     "  -l  --log <file>         write log messages to file.\n" \
+    "      --log-async          write log messages from a background thread.\n" \
+    "      --log-max-size <kb>  rotate the log file at this size (default 1024).\n" \
+    "      --log-generations <n>\n" \
+    "                           keep n rotated log files (default 1).\n" \
     "      --no-tray            disable the system tray icon.\n" \
     "      --enable-drag-drop   enable file drag & drop.\n" \
     "      --enable-crypto      enable the crypto (ssl) plugin (default, deprecated).\n" \
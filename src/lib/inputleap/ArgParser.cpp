@@ -133,6 +133,10 @@ ArgParser::parseServerArgs(ServerArgs& args, int argc, const char* const* argv)
                 // save screen change script path
                 args.m_screenChangeScript = optarg;
             }
+            else if (a.shift("--metrics-socket", nullptr, &optarg)) {
+                // save metrics socket path
+                args.metrics_socket_path = optarg;
+            }
             else if (a.shift("--disable-client-cert-checking")) {
                 args.check_client_certificates = false;
             } else {
@@ -172,6 +176,21 @@ ArgParser::parseClientArgs(ClientArgs& args, int argc, const char* const* argv)
                 // define scroll
                 args.m_yscroll = atoi(optarg);
             }
+            else if (a.shift("--coalesce-motion", nullptr, &optarg)) {
+                // save motion coalescing interval
+                args.coalesce_motion = true;
+                if (strcmp(optarg, "refresh") == 0) {
+                    args.coalesce_motion_interval = 0.0;
+                }
+                else {
+                    char* end;
+                    double interval = strtod(optarg, &end);
+                    if (*end != '\0' || !(interval > 0.0)) {
+                        throw XArgvParserError("invalid motion interval `%s'", optarg);
+                    }
+                    args.coalesce_motion_interval = interval / 1000.0;
+                }
+            }
             else if (a.size() == 1) {
                 args.network_address = a.shift();
                 return true;
@@ -274,6 +293,15 @@ ArgParser::parseGenericArgs(Argv& argv)
     else if (argv.shift("-l", "--log", &optarg)) {
         argsBase().m_logFile = optarg;
     }
+    else if (argv.shift("--log-async")) {
+        argsBase().m_logAsync = true;
+    }
+    else if (argv.shift("--log-max-size", nullptr, &optarg)) {
+        argsBase().m_logMaxSize = atoi(optarg);
+    }
+    else if (argv.shift("--log-generations", nullptr, &optarg)) {
+        argsBase().m_logGenerations = atoi(optarg);
+    }
     else if (argv.shift("-f", "--no-daemon")) {
         // not a daemon
         argsBase().m_daemon = false;
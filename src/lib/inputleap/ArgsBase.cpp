@@ -34,6 +34,9 @@ m_restartable(true),
 m_noHooks(false),
 m_logFilter(nullptr),
 m_logFile(nullptr),
+m_logAsync(false),
+m_logMaxSize(0),
+m_logGenerations(0),
 m_display(nullptr),
 m_disableTray(false),
 m_enableIpc(false),
@@ -35,6 +35,9 @@ public:
     std::string m_exename;
     const char* m_logFilter;
     const char* m_logFile;
+    bool m_logAsync;
+    int m_logMaxSize;
+    int m_logGenerations;
     const char* m_display;
     std::string m_name;
     bool m_disableTray;
@@ -44,6 +44,7 @@
 #endif
 #if WINAPI_XWINDOWS
 #include "platform/XWindowsScreen.h"
+#include "platform/XWindowsXCBImpl.h"
 #endif
 #if WINAPI_CARBON
 #include "platform/OSXScreen.h"
@@ -111,6 +112,7 @@ ClientApp::help()
     buffer << "Start the InputLeap client and connect to a remote server component.\n"
            << "\n"
            << "Usage: " << args().m_exename << " [--yscroll <delta>]"
+           << " [--coalesce-motion <ms>|refresh]"
 #ifdef WINAPI_XWINDOWS
            << " [--display <display>]"
 #endif
@@ -125,6 +127,9 @@ ClientApp::help()
            << HELP_SYS_INFO
            << "      --yscroll <delta>    defines the vertical scrolling delta, which is\n"
            << "                           120 by default.\n"
+           << "      --coalesce-motion <ms>|refresh\n"
+           << "                           move the mouse at most once per <ms>\n"
+           << "                           milliseconds or once per display refresh.\n"
            << HELP_COMMON_INFO_2
            << "\n"
            << "Default options are marked with a *\n"
@@ -166,7 +171,7 @@ ClientApp::createScreen()
 #endif
 #if WINAPI_XWINDOWS
     return new inputleap::Screen(new XWindowsScreen(
-        new XWindowsImpl(),
+        new XWindowsXCBImpl(),
         args().m_display, false,
         args().m_yscroll, m_events), m_events);
 #endif
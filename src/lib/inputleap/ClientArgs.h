@@ -29,6 +29,11 @@ public:
 
 public:
     int m_yscroll;
+
+    // inject at most one mouse move per interval
+    bool coalesce_motion = false;
+    // the interval in seconds, 0 for the refresh interval of the display
+    double coalesce_motion_interval = 0.0;
 };
 
 } // namespace inputleap
@@ -39,6 +39,7 @@ IKeyState::KeyInfo IKeyState::KeyInfo::create(KeyID id, KeyModifierMask mask, Ke
     info.m_button = button;
     info.m_count = count;
     info.screens_ = join(destinations);
+    info.screen_ids_ = ScreenIdSet::from_names(destinations);
     return info;
 }
 
@@ -48,26 +49,6 @@ IKeyState::KeyInfo::isDefault(const char* screens)
     return (screens == nullptr || screens[0] == '\0');
 }
 
-bool
-IKeyState::KeyInfo::contains(const char* screens, const std::string& name)
-{
-    // special cases
-    if (isDefault(screens)) {
-        return false;
-    }
-    if (screens[0] == '*') {
-        return true;
-    }
-
-    // search
-    std::string match;
-    match.reserve(name.size() + 2);
-    match += ":";
-    match += name;
-    match += ":";
-    return (strstr(screens, match.c_str()) != nullptr);
-}
-
 bool
 IKeyState::KeyInfo::equal(const KeyInfo* a, const KeyInfo* b)
 {
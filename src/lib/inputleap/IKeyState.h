@@ -19,6 +19,7 @@
 #pragma once
 
 #include "inputleap/key_types.h"
+#include "inputleap/ScreenId.h"
 #include "base/Event.h"
 #include "base/IEventQueue.h"
 #include "base/EventTypes.h"
@@ -57,7 +58,6 @@ public:
                               const std::set<std::string>& destinations);
 
         static bool isDefault(const char* screens);
-        static bool contains(const char* screens, const std::string& name);
         static bool equal(const KeyInfo*, const KeyInfo*);
         static std::string join(const std::set<std::string>& destinations);
         static void split(const char* screens, std::set<std::string>&);
@@ -67,12 +67,20 @@ public:
             return screens_.empty() ? nullptr : screens_.c_str();
         }
 
+        const ScreenIdSet* screen_ids_or_nullptr() const
+        {
+            return screen_ids_.empty() ? nullptr : &screen_ids_;
+        }
+
     public:
         KeyID m_key = 0;
         KeyModifierMask m_mask = 0;
         KeyButton m_button = 0;
         std::int32_t m_count = 0;
         std::string screens_;
+
+        // the destinations in screens_ as interned ids
+        ScreenIdSet screen_ids_;
     };
 
     typedef std::set<KeyButton> KeyButtonSet;
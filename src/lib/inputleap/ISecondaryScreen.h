@@ -31,6 +31,23 @@ class ISecondaryScreen {
 public:
     virtual ~ISecondaryScreen() { }
 
+    //! @name manipulators
+    //@{
+
+    //! Begin a batch of synthesized input
+    /*!
+    Input synthesized until the matching \c fakeBatchEnd() may be queued
+    instead of being delivered right away.  Batches may be nested.
+    */
+    virtual void fakeBatchBegin() = 0;
+
+    //! End a batch of synthesized input
+    /*!
+    Delivers the input queued since the outermost \c fakeBatchBegin().
+    */
+    virtual void fakeBatchEnd() = 0;
+
+    //@}
     //! @name accessors
     //@{
 
@@ -58,5 +75,12 @@ public:
     */
     virtual void fakeMouseWheel(std::int32_t xDelta, std::int32_t yDelta) const = 0;
 
+    //! Get display refresh rate
+    /*!
+    Returns the highest refresh rate in Hz of the displays that make up
+    the screen, or 0 if it is not known.
+    */
+    virtual double getRefreshRate() const = 0;
+
     //@}
 };
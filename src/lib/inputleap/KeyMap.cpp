@@ -20,9 +20,12 @@
 #include "inputleap/key_types.h"
 #include "base/Log.h"
 
+#include <algorithm>
 #include <assert.h>
 #include <cctype>
 #include <cstdlib>
+#include <limits>
+#include <tuple>
 
 namespace inputleap {
 
@@ -31,6 +34,25 @@ KeyMap::NameToModifierMap* KeyMap::s_nameToModifierMap = nullptr;
 KeyMap::KeyToNameMap* KeyMap::s_keyToNameMap = nullptr;
 KeyMap::ModifierToNameMap* KeyMap::s_modifierToNameMap = nullptr;
 
+namespace {
+
+template <class T>
+void insert_sorted(std::vector<T>& values, T value)
+{
+    auto i = std::lower_bound(values.begin(), values.end(), value);
+    if (i == values.end() || *i != value) {
+        values.insert(i, value);
+    }
+}
+
+template <class T>
+bool contains_sorted(const std::vector<T>& values, T value)
+{
+    return std::binary_search(values.begin(), values.end(), value);
+}
+
+} // namespace
+
 KeyMap::KeyMap() :
     m_numGroups(0),
     m_composeAcrossGroups(false)
@@ -46,16 +68,50 @@ KeyMap::KeyMap() :
     m_modifierKeyItem.m_client    = 0;
 }
 
+KeyMap::KeyMap(const KeyMap& x) :
+    m_items(x.m_items),
+    m_entries(x.m_entries),
+    m_numGroups(x.m_numGroups),
+    m_modifierKeyItems(x.m_modifierKeyItems),
+    m_modifierKeyOffsets(x.m_modifierKeyOffsets),
+    m_composeAcrossGroups(x.m_composeAcrossGroups),
+    m_halfDuplex(x.m_halfDuplex),
+    m_halfDuplexMods(x.m_halfDuplexMods),
+    m_modifierKeyItem(x.m_modifierKeyItem)
+{
+    // the keystroke cache points into x's items so it isn't copied
+}
+
 KeyMap::~KeyMap()
 {
     // do nothing
 }
 
+KeyMap&
+KeyMap::operator=(const KeyMap& x)
+{
+    if (this != &x) {
+        m_items               = x.m_items;
+        m_entries             = x.m_entries;
+        m_numGroups           = x.m_numGroups;
+        m_modifierKeyItems    = x.m_modifierKeyItems;
+        m_modifierKeyOffsets  = x.m_modifierKeyOffsets;
+        m_composeAcrossGroups = x.m_composeAcrossGroups;
+        m_halfDuplex          = x.m_halfDuplex;
+        m_halfDuplexMods      = x.m_halfDuplexMods;
+        m_modifierKeyItem     = x.m_modifierKeyItem;
+        clearKeystrokeCache();
+    }
+    return *this;
+}
+
 void
 KeyMap::swap(KeyMap& x)
 {
-    m_keyIDMap.swap(x.m_keyIDMap);
-    m_modifierKeys.swap(x.m_modifierKeys);
+    m_items.swap(x.m_items);
+    m_entries.swap(x.m_entries);
+    m_modifierKeyItems.swap(x.m_modifierKeyItems);
+    m_modifierKeyOffsets.swap(x.m_modifierKeyOffsets);
     m_halfDuplex.swap(x.m_halfDuplex);
     m_halfDuplexMods.swap(x.m_halfDuplexMods);
     std::int32_t tmp1 = m_numGroups;
@@ -64,6 +120,8 @@ KeyMap::swap(KeyMap& x)
     bool tmp2               = m_composeAcrossGroups;
     m_composeAcrossGroups   = x.m_composeAcrossGroups;
     x.m_composeAcrossGroups = tmp2;
+    clearKeystrokeCache();
+    x.clearKeystrokeCache();
 }
 
 void
@@ -73,30 +131,17 @@ KeyMap::addKeyEntry(const KeyItem& item)
     if (item.m_id == kKeyNone) {
         return;
     }
-
-    // resize number of groups for key
-    std::int32_t numGroups = item.m_group + 1;
-    if (getNumGroups() > numGroups) {
-        numGroups = getNumGroups();
-    }
-    KeyGroupTable& groupTable = m_keyIDMap[item.m_id];
-    if (groupTable.size() < static_cast<size_t>(numGroups)) {
-        groupTable.resize(numGroups);
-    }
-
-    // make a list from the item
-    KeyItemList items;
-    items.push_back(item);
+    clearKeystrokeCache();
 
     // set group and dead key flag on the item
-    KeyItem& newItem = items.back();
-    newItem.m_dead   = isDeadKey(item.m_id);
+    KeyItem newItem = item;
+    newItem.m_dead  = isDeadKey(item.m_id);
 
     // mask the required bits with the sensitive bits
     newItem.m_required &= newItem.m_sensitive;
 
     // see if we already have this item;  just return if so
-    KeyEntryList& entries = groupTable[item.m_group];
+    KeyEntryRange entries = findEntries(item.m_id, item.m_group);
     for (size_t i = 0, n = entries.size(); i < n; ++i) {
         if (entries[i].size() == 1 && newItem == entries[i][0]) {
             return;
@@ -104,7 +149,7 @@ KeyMap::addKeyEntry(const KeyItem& item)
     }
 
     // add item list
-    entries.push_back(items);
+    addEntry(newItem.m_id, newItem.m_group, &newItem, 1);
     LOG((CLOG_DEBUG5 "add key: %04x %d %03x %04x (%04x %04x %04x)%s", newItem.m_id, newItem.m_group, newItem.m_button, newItem.m_client, newItem.m_required, newItem.m_sensitive, newItem.m_generates, newItem.m_dead ? " dead" : ""));
 }
 
@@ -113,19 +158,19 @@ void KeyMap::addKeyAliasEntry(KeyID targetID, std::int32_t group, KeyModifierMas
                               KeyModifierMask sourceRequired, KeyModifierMask sourceSensitive)
 {
     // if we can already generate the target as desired then we're done.
-    if (findCompatibleKey(targetID, group, targetRequired,
-                                targetSensitive) != nullptr) {
+    if (!findCompatibleKey(targetID, group, targetRequired,
+                                targetSensitive).empty()) {
         return;
     }
 
     // find a compatible source, preferably in the same group
     for (std::int32_t gd = 0, n = getNumGroups(); gd < n; ++gd) {
         std::int32_t eg = getEffectiveGroup(group, gd);
-        const KeyItemList* sourceEntry =
+        KeyItemRange sourceEntry =
             findCompatibleKey(sourceID, eg,
                                 sourceRequired, sourceSensitive);
-        if (sourceEntry != nullptr && sourceEntry->size() == 1) {
-            KeyMap::KeyItem targetItem = sourceEntry->back();
+        if (sourceEntry.size() == 1) {
+            KeyMap::KeyItem targetItem = sourceEntry.back();
             targetItem.m_id    = targetID;
             targetItem.m_group = eg;
             addKeyEntry(targetItem);
@@ -141,16 +186,9 @@ bool KeyMap::addKeyCombinationEntry(KeyID id, std::int32_t group, const KeyID* k
     if (id == kKeyNone) {
         return false;
     }
+    clearKeystrokeCache();
 
-    std::int32_t numGroups = group + 1;
-    if (getNumGroups() > numGroups) {
-        numGroups = getNumGroups();
-    }
-    KeyGroupTable& groupTable = m_keyIDMap[id];
-    if (groupTable.size() < static_cast<size_t>(numGroups)) {
-        groupTable.resize(numGroups);
-    }
-    if (!groupTable[group].empty()) {
+    if (!findEntries(id, group).empty()) {
         // key is already in the table
         return false;
     }
@@ -158,23 +196,22 @@ bool KeyMap::addKeyCombinationEntry(KeyID id, std::int32_t group, const KeyID* k
     // convert to buttons
     KeyItemList items;
     for (std::uint32_t i = 0; i < numKeys; ++i) {
-        KeyIDMap::const_iterator gtIndex = m_keyIDMap.find(keys[i]);
-        if (gtIndex == m_keyIDMap.end()) {
+        KeyEntryRange keyEntries = findEntries(keys[i]);
+        if (keyEntries.empty()) {
             return false;
         }
-        const KeyGroupTable& key_group_table = gtIndex->second;
 
         // if we allow group switching during composition then search all
         // groups for keys, otherwise search just the given group.
         std::int32_t n = 1;
         if (m_composeAcrossGroups) {
-            n = static_cast<std::int32_t>(key_group_table.size());
+            n = getNumGroups();
         }
 
         bool found = false;
         for (std::int32_t gd = 0; gd < n && !found; ++gd) {
             std::int32_t eg = (group + gd) % getNumGroups();
-            const KeyEntryList& entries = key_group_table[eg];
+            KeyEntryRange entries = keyEntries.inGroup(eg);
             for (size_t j = 0; j < entries.size(); ++j) {
                 if (entries[j].size() == 1) {
                     found = true;
@@ -190,7 +227,7 @@ bool KeyMap::addKeyCombinationEntry(KeyID id, std::int32_t group, const KeyID* k
     }
 
     // add key
-    groupTable[group].push_back(items);
+    addEntry(id, group, items.data(), static_cast<std::uint32_t>(items.size()));
     return true;
 }
 
@@ -198,24 +235,28 @@ void
 KeyMap::allowGroupSwitchDuringCompose()
 {
     m_composeAcrossGroups = true;
+    clearKeystrokeCache();
 }
 
 void
 KeyMap::addHalfDuplexButton(KeyButton button)
 {
-    m_halfDuplex.insert(button);
+    insert_sorted(m_halfDuplex, button);
+    clearKeystrokeCache();
 }
 
 void
 KeyMap::clearHalfDuplexModifiers()
 {
     m_halfDuplexMods.clear();
+    clearKeystrokeCache();
 }
 
 void
 KeyMap::addHalfDuplexModifier(KeyID key)
 {
-    m_halfDuplexMods.insert(key);
+    insert_sorted(m_halfDuplexMods, key);
+    clearKeystrokeCache();
 }
 
 void
@@ -223,35 +264,38 @@ KeyMap::finish()
 {
     m_numGroups = findNumGroups();
 
-    // make sure every key has the same number of groups
-    for (KeyIDMap::iterator i = m_keyIDMap.begin();
-                                i != m_keyIDMap.end(); ++i) {
-        i->second.resize(m_numGroups);
-    }
-
     // compute keys that generate each modifier
     setModifierKeys();
+
+    clearKeystrokeCache();
 }
 
 void
 KeyMap::foreachKey(ForeachKeyCallback cb, void* userData)
 {
-    for (KeyIDMap::iterator i = m_keyIDMap.begin();
-                                i != m_keyIDMap.end(); ++i) {
-        KeyGroupTable& groupTable = i->second;
-        for (size_t group = 0; group < groupTable.size(); ++group) {
-            KeyEntryList& entryList = groupTable[group];
-            for (size_t j = 0; j < entryList.size(); ++j) {
-                KeyItemList& itemList = entryList[j];
-                for (size_t k = 0; k < itemList.size(); ++k) {
-                    (*cb)(i->first, static_cast<std::int32_t>(group),
-                                itemList[k], userData);
-                }
-            }
+    // the callback may change the items
+    clearKeystrokeCache();
+
+    for (const KeyEntry& entry : m_entries) {
+        for (std::uint32_t k = 0; k < entry.m_count; ++k) {
+            (*cb)(entry.m_id, entry.m_group, m_items[entry.m_first + k], userData);
         }
     }
 }
 
+void
+KeyMap::clearKeystrokeCache()
+{
+    m_keystrokeCache.clear();
+}
+
+bool KeyMap::KeystrokeCacheKey::operator<(const KeystrokeCacheKey& x) const
+{
+    return std::tie(m_id, m_group, m_currentState, m_desiredMask, m_isAutoRepeat, m_modifiers) <
+           std::tie(x.m_id, x.m_group, x.m_currentState, x.m_desiredMask, x.m_isAutoRepeat,
+                    x.m_modifiers);
+}
+
 const KeyMap::KeyItem* KeyMap::mapKey(Keystrokes& keys, KeyID id, std::int32_t group,
                                       ModifierToKeys& activeModifiers,
                                       KeyModifierMask& currentState, KeyModifierMask desiredMask,
@@ -259,6 +303,64 @@ const KeyMap::KeyItem* KeyMap::mapKey(Keystrokes& keys, KeyID id, std::int32_t g
 {
     LOG((CLOG_DEBUG1 "mapKey %04x (%d) with mask %04x, start state: %04x", id, id, desiredMask, currentState));
 
+    // the result is appended to keys so only an empty list can be memoized
+    if (!keys.empty()) {
+        return mapKeyUncached(keys, id, group, activeModifiers,
+                              currentState, desiredMask, isAutoRepeat);
+    }
+
+    KeystrokeCacheKey key;
+    key.m_id           = id;
+    key.m_group        = group;
+    key.m_currentState = currentState;
+    key.m_desiredMask  = desiredMask;
+    key.m_isAutoRepeat = isAutoRepeat;
+    key.m_modifiers.reserve(activeModifiers.size() * 9);
+    for (const auto& modifier : activeModifiers) {
+        const KeyItem& item = modifier.second;
+        key.m_modifiers.push_back(modifier.first);
+        key.m_modifiers.push_back(item.m_id);
+        key.m_modifiers.push_back(static_cast<std::uint32_t>(item.m_group));
+        key.m_modifiers.push_back(item.m_button);
+        key.m_modifiers.push_back(item.m_client);
+        key.m_modifiers.push_back(item.m_required);
+        key.m_modifiers.push_back(item.m_sensitive);
+        key.m_modifiers.push_back(item.m_generates);
+        key.m_modifiers.push_back((item.m_dead ? 1u : 0u) | (item.m_lock ? 2u : 0u));
+    }
+
+    KeystrokeCache::const_iterator cached = m_keystrokeCache.find(key);
+    if (cached != m_keystrokeCache.end()) {
+        const KeystrokeCacheEntry& entry = cached->second;
+        keys            = entry.m_keys;
+        activeModifiers = entry.m_activeModifiers;
+        currentState    = entry.m_currentState;
+        if (entry.m_item != nullptr) {
+            LOG((CLOG_DEBUG1 "mapped to %03x, new state %04x (cached)", entry.m_item->m_button, currentState));
+        }
+        return entry.m_item;
+    }
+
+    const KeyItem* item = mapKeyUncached(keys, id, group, activeModifiers,
+                                         currentState, desiredMask, isAutoRepeat);
+
+    if (m_keystrokeCache.size() >= kMaxKeystrokeCacheSize) {
+        m_keystrokeCache.clear();
+    }
+    KeystrokeCacheEntry& entry = m_keystrokeCache[std::move(key)];
+    entry.m_keys            = keys;
+    entry.m_item            = item;
+    entry.m_activeModifiers = activeModifiers;
+    entry.m_currentState    = currentState;
+    return item;
+}
+
+const KeyMap::KeyItem* KeyMap::mapKeyUncached(Keystrokes& keys, KeyID id, std::int32_t group,
+                                              ModifierToKeys& activeModifiers,
+                                              KeyModifierMask& currentState,
+                                              KeyModifierMask desiredMask,
+                                              bool isAutoRepeat) const
+{
     // handle group change
     if (id == kKeyNextGroup) {
         keys.push_back(Keystroke(1, false, false));
@@ -334,33 +436,28 @@ std::int32_t KeyMap::getEffectiveGroup(std::int32_t group, std::int32_t offset)
     return (group + offset + getNumGroups()) % getNumGroups();
 }
 
-const KeyMap::KeyItemList* KeyMap::findCompatibleKey(KeyID id, std::int32_t group,
-                                                     KeyModifierMask required,
-                                                     KeyModifierMask sensitive) const
+KeyMap::KeyItemRange KeyMap::findCompatibleKey(KeyID id, std::int32_t group,
+                                               KeyModifierMask required,
+                                               KeyModifierMask sensitive) const
 {
     assert(group >= 0 && group < getNumGroups());
 
-    KeyIDMap::const_iterator i = m_keyIDMap.find(id);
-    if (i == m_keyIDMap.end()) {
-        return nullptr;
-    }
-
-    const KeyEntryList& entries = i->second[group];
+    KeyEntryRange entries = findEntries(id, group);
     for (size_t j = 0; j < entries.size(); ++j) {
         if ((entries[j].back().m_sensitive & sensitive) == 0 ||
             (entries[j].back().m_required & sensitive) ==
                 (required & sensitive)) {
-            return &entries[j];
+            return entries[j];
         }
     }
 
-    return nullptr;
+    return KeyItemRange();
 }
 
 bool
 KeyMap::isHalfDuplex(KeyID key, KeyButton button) const
 {
-    return (m_halfDuplex.count(button) + m_halfDuplexMods.count(key) > 0);
+    return contains_sorted(m_halfDuplex, button) || contains_sorted(m_halfDuplexMods, key);
 }
 
 bool
@@ -448,51 +545,117 @@ KeyMap::initModifierKey(KeyItem& item)
     }
 }
 
+KeyMap::KeyEntryRange KeyMap::findEntries(KeyID id, std::int32_t group) const
+{
+    KeyEntry key{};
+    key.m_id    = id;
+    key.m_group = group;
+    auto range = std::equal_range(m_entries.begin(), m_entries.end(), key, KeyEntryLess());
+    const KeyEntry* entries = m_entries.data();
+    return KeyEntryRange(m_items.data(), entries + (range.first - m_entries.begin()),
+                         entries + (range.second - m_entries.begin()));
+}
+
+KeyMap::KeyEntryRange KeyMap::findEntries(KeyID id) const
+{
+    KeyEntry first{};
+    first.m_id    = id;
+    first.m_group = std::numeric_limits<std::int32_t>::min();
+    KeyEntry last = first;
+    last.m_group  = std::numeric_limits<std::int32_t>::max();
+    auto begin = std::lower_bound(m_entries.begin(), m_entries.end(), first, KeyEntryLess());
+    auto end   = std::upper_bound(begin, m_entries.end(), last, KeyEntryLess());
+    const KeyEntry* entries = m_entries.data();
+    return KeyEntryRange(m_items.data(), entries + (begin - m_entries.begin()),
+                         entries + (end - m_entries.begin()));
+}
+
+KeyMap::KeyEntryRange KeyMap::KeyEntryRange::inGroup(std::int32_t group) const
+{
+    // there are only a few groups so a linear search is quickest
+    const KeyEntry* begin = m_begin;
+    while (begin != m_end && begin->m_group < group) {
+        ++begin;
+    }
+    const KeyEntry* end = begin;
+    while (end != m_end && end->m_group == group) {
+        ++end;
+    }
+    return KeyEntryRange(m_items, begin, end);
+}
+
+void KeyMap::addEntry(KeyID id, std::int32_t group, const KeyItem* items, std::uint32_t count)
+{
+    KeyEntry entry{};
+    entry.m_id    = id;
+    entry.m_group = group;
+    entry.m_first = static_cast<std::uint32_t>(m_items.size());
+    entry.m_count = count;
+    m_items.insert(m_items.end(), items, items + count);
+    m_entries.insert(std::upper_bound(m_entries.begin(), m_entries.end(), entry,
+                                      KeyEntryLess()), entry);
+}
+
 std::int32_t KeyMap::findNumGroups() const
 {
-    size_t max = 0;
-    for (KeyIDMap::const_iterator i = m_keyIDMap.begin();
-                                i != m_keyIDMap.end(); ++i) {
-        if (i->second.size() > max) {
-            max = i->second.size();
+    std::int32_t max = 0;
+    for (const KeyEntry& entry : m_entries) {
+        if (entry.m_group + 1 > max) {
+            max = entry.m_group + 1;
         }
     }
-    return static_cast<std::int32_t>(max);
+    return max;
 }
 
 void
 KeyMap::setModifierKeys()
 {
-    m_modifierKeys.clear();
-    m_modifierKeys.resize(kKeyModifierNumBits * getNumGroups());
-    for (KeyIDMap::const_iterator i = m_keyIDMap.begin();
-                                i != m_keyIDMap.end(); ++i) {
-        const KeyGroupTable& groupTable = i->second;
-        for (size_t g = 0; g < groupTable.size(); ++g) {
-            const KeyEntryList& entries = groupTable[g];
-            for (size_t j = 0; j < entries.size(); ++j) {
-                // skip multi-key sequences
-                if (entries[j].size() != 1) {
-                    continue;
-                }
+    // count the keys for each modifier in each group, then place them
+    size_t numModifiers = static_cast<size_t>(kKeyModifierNumBits * getNumGroups());
+    m_modifierKeyItems.clear();
+    m_modifierKeyOffsets.assign(numModifiers + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const KeyEntry& entry : m_entries) {
+            // skip multi-key sequences
+            if (entry.m_count != 1) {
+                continue;
+            }
 
-                // skip keys that don't generate a modifier
-                const KeyItem& item = entries[j].back();
-                if (item.m_generates == 0) {
-                    continue;
-                }
+            // skip keys that don't generate a modifier
+            const KeyItem& item = m_items[entry.m_first];
+            if (item.m_generates == 0) {
+                continue;
+            }
 
-                // add key to each indicated modifier in this group
-                for (std::int32_t b = 0; b < kKeyModifierNumBits; ++b) {
-                    // skip if item doesn't generate bit b
-                    if (((1u << b) & item.m_generates) != 0) {
-                        std::int32_t mIndex = static_cast<std::int32_t>(g) * kKeyModifierNumBits + b;
-                        m_modifierKeys[mIndex].push_back(&item);
+            // add key to each indicated modifier in this group
+            for (std::int32_t b = 0; b < kKeyModifierNumBits; ++b) {
+                // skip if item doesn't generate bit b
+                if (((1u << b) & item.m_generates) != 0) {
+                    size_t mIndex = static_cast<size_t>(entry.m_group * kKeyModifierNumBits + b);
+                    if (pass == 0) {
+                        ++m_modifierKeyOffsets[mIndex + 1];
+                    }
+                    else {
+                        m_modifierKeyItems[m_modifierKeyOffsets[mIndex]++] = entry.m_first;
                     }
                 }
             }
         }
+
+        if (pass == 0) {
+            // start each modifier's keys where the previous one's end
+            for (size_t i = 1; i <= numModifiers; ++i) {
+                m_modifierKeyOffsets[i] += m_modifierKeyOffsets[i - 1];
+            }
+            m_modifierKeyItems.resize(m_modifierKeyOffsets[numModifiers]);
+        }
+    }
+
+    // placing advanced each offset to the next modifier's start
+    for (size_t i = numModifiers; i > 0; --i) {
+        m_modifierKeyOffsets[i] = m_modifierKeyOffsets[i - 1];
     }
+    m_modifierKeyOffsets[0] = 0;
 }
 
 const KeyMap::KeyItem* KeyMap::mapCommandKey(Keystrokes& keys, KeyID id, std::int32_t group,
@@ -503,20 +666,19 @@ const KeyMap::KeyItem* KeyMap::mapCommandKey(Keystrokes& keys, KeyID id, std::in
     static const KeyModifierMask s_overrideModifiers = 0xffffu;
 
     // find KeySym in table
-    KeyIDMap::const_iterator it = m_keyIDMap.find(id);
-    if (it == m_keyIDMap.end()) {
+    KeyEntryRange keyEntries = findEntries(id);
+    if (keyEntries.empty()) {
         // unknown key
         LOG((CLOG_DEBUG1 "key %04x is not on keyboard", id));
         return nullptr;
     }
-    const KeyGroupTable& keyGroupTable = it->second;
 
     // find the first key that generates this KeyID
     const KeyItem* keyItem = nullptr;
     std::int32_t numGroups = getNumGroups();
     for (std::int32_t groupOffset = 0; groupOffset < numGroups; ++groupOffset) {
         std::int32_t effectiveGroup = getEffectiveGroup(group, groupOffset);
-        const KeyEntryList& entryList = keyGroupTable[effectiveGroup];
+        KeyEntryRange entryList = keyEntries.inGroup(effectiveGroup);
         for (size_t i = 0; i < entryList.size(); ++i) {
             if (entryList[i].size() != 1) {
                 // ignore multikey entries
@@ -592,23 +754,22 @@ const KeyMap::KeyItem* KeyMap::mapCharacterKey(Keystrokes& keys, KeyID id, std::
                                                KeyModifierMask desiredMask, bool isAutoRepeat) const
 {
     // find KeySym in table
-    KeyIDMap::const_iterator i = m_keyIDMap.find(id);
-    if (i == m_keyIDMap.end()) {
+    KeyEntryRange keyEntries = findEntries(id);
+    if (keyEntries.empty()) {
         // unknown key
         LOG((CLOG_DEBUG1 "key %04x is not on keyboard", id));
         return nullptr;
     }
-    const KeyGroupTable& keyGroupTable = i->second;
 
     // find best key in any group, starting with the active group
     std::int32_t keyIndex  = -1;
     std::int32_t numGroups = getNumGroups();
-    std::int32_t groupOffset;
+    KeyEntryRange entryList(nullptr, nullptr, nullptr);
     LOG((CLOG_DEBUG1 "find best:  %04x %04x", currentState, desiredMask));
-    for (groupOffset = 0; groupOffset < numGroups; ++groupOffset) {
+    for (std::int32_t groupOffset = 0; groupOffset < numGroups; ++groupOffset) {
         std::int32_t effectiveGroup = getEffectiveGroup(group, groupOffset);
-        keyIndex = findBestKey(keyGroupTable[effectiveGroup],
-                                currentState, desiredMask);
+        entryList = keyEntries.inGroup(effectiveGroup);
+        keyIndex = findBestKey(entryList, currentState, desiredMask);
         if (keyIndex != -1) {
             LOG((CLOG_DEBUG1 "found key in group %d", effectiveGroup));
             break;
@@ -621,8 +782,7 @@ const KeyMap::KeyItem* KeyMap::mapCharacterKey(Keystrokes& keys, KeyID id, std::
     }
 
     // get keys to press for key
-    std::int32_t effectiveGroup = getEffectiveGroup(group, groupOffset);
-    const KeyItemList& itemList = keyGroupTable[effectiveGroup][keyIndex];
+    KeyItemRange itemList = entryList[keyIndex];
     if (itemList.empty()) {
         return nullptr;
     }
@@ -673,7 +833,8 @@ const KeyMap::KeyItem* KeyMap::mapModifierKey(Keystrokes& keys, KeyID id, std::i
                                 currentState, desiredMask, isAutoRepeat);
 }
 
-std::int32_t KeyMap::findBestKey(const KeyEntryList& entryList, KeyModifierMask /*currentState*/,
+template <class EntryList>
+std::int32_t KeyMap::findBestKey(const EntryList& entryList, KeyModifierMask /*currentState*/,
                                  KeyModifierMask desiredState) const
 {
     // check for an item that can accommodate the desiredState exactly
@@ -707,6 +868,9 @@ std::int32_t KeyMap::findBestKey(const KeyEntryList& entryList, KeyModifierMask
     return bestIndex;
 }
 
+template std::int32_t KeyMap::findBestKey(const KeyEntryList&, KeyModifierMask,
+                                          KeyModifierMask) const;
+
 
 const KeyMap::KeyItem* KeyMap::keyForModifier(KeyButton button, std::int32_t group,
                                               std::int32_t modifierBit) const
@@ -719,12 +883,12 @@ const KeyMap::KeyItem* KeyMap::keyForModifier(KeyButton button, std::int32_t gro
     // to generate a KeyID that's only bound the the given button.
     // this is important when a shift button is modified by shift;  we
     // must use the other shift button to do the shifting.
-    const ModifierKeyItemList& items =
-        m_modifierKeys[group * kKeyModifierNumBits + modifierBit];
-    for (ModifierKeyItemList::const_iterator i = items.begin();
-                                i != items.end(); ++i) {
-        if ((*i)->m_button != button) {
-            return (*i);
+    size_t mIndex = static_cast<size_t>(group * kKeyModifierNumBits + modifierBit);
+    for (std::uint32_t i = m_modifierKeyOffsets[mIndex];
+                                i < m_modifierKeyOffsets[mIndex + 1]; ++i) {
+        const KeyItem& item = m_items[m_modifierKeyItems[i]];
+        if (item.m_button != button) {
+            return &item;
         }
     }
     return nullptr;
@@ -1001,7 +1165,7 @@ KeyMap::addKeystrokes(EKeystroke type, const KeyItem& keyItem,
     case kKeystrokeUnmodify:
         if (keyItem.m_lock) {
             // we assume there's just one button for this modifier
-            if (m_halfDuplex.count(button) > 0) {
+            if (contains_sorted(m_halfDuplex, button)) {
                 if (type == kKeystrokeModify) {
                     // turn half-duplex toggle on (press)
                     keystrokes.push_back(Keystroke(button,  true, false, data));
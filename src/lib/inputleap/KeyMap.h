@@ -26,7 +26,6 @@
 #endif
 
 #include <map>
-#include <set>
 #include <vector>
 
 namespace inputleap {
@@ -38,8 +37,11 @@ This class provides a keyboard mapping.
 class KeyMap {
 public:
     KeyMap();
+    KeyMap(const KeyMap&);
     virtual ~KeyMap();
 
+    KeyMap& operator=(const KeyMap&);
+
     //! KeyID synthesis info
     /*!
     This structure contains the information necessary to synthesize a
@@ -77,6 +79,29 @@ public:
     */
     typedef std::vector<KeyItem> KeyItemList;
 
+    //! The KeyItems of one entry in the map
+    /*!
+    A view of the items the map stores for one way to synthesize a KeyID,
+    in the same order as the \c KeyItemList they were added as.  It's
+    valid until the map is next changed.
+    */
+    class KeyItemRange {
+    public:
+        KeyItemRange() : m_begin(nullptr), m_end(nullptr) { }
+        KeyItemRange(const KeyItem* begin, const KeyItem* end) : m_begin(begin), m_end(end) { }
+
+        const KeyItem* begin() const { return m_begin; }
+        const KeyItem* end() const { return m_end; }
+        size_t size() const { return static_cast<size_t>(m_end - m_begin); }
+        bool empty() const { return m_begin == m_end; }
+        const KeyItem& operator[](size_t i) const { return m_begin[i]; }
+        const KeyItem& back() const { return m_end[-1]; }
+
+    private:
+        const KeyItem* m_begin;
+        const KeyItem* m_end;
+    };
+
     //! A keystroke
     class Keystroke {
     public:
@@ -205,6 +230,13 @@ public:
     */
     virtual void foreachKey(ForeachKeyCallback cb, void* userData);
 
+    //! Forget memoized keystrokes
+    /*!
+    Discards the keystrokes remembered by \c mapKey().  Every manipulator
+    calls this so the cache never outlives the map it was computed from.
+    */
+    void clearKeystrokeCache();
+
     //@}
     //! @name accessors
     //@{
@@ -216,6 +248,10 @@ public:
     \p desiredMask into the keystrokes necessary to synthesize that key
     event in \p keys.  It returns the \c KeyItem of the key being
     pressed/repeated, or nullptr if the key cannot be mapped.
+
+    Results are memoized on the inputs, including the active modifier
+    keys, so typing the same key in the same state again just copies the
+    keystrokes computed the first time.
     */
     virtual const KeyItem* mapKey(Keystrokes& keys, KeyID id, std::int32_t group,
                                   ModifierToKeys& activeModifiers, KeyModifierMask& currentState,
@@ -235,15 +271,15 @@ public:
 
     //! Find key entry compatible with modifiers
     /*!
-    Returns the \c KeyItemList for the first entry for \p id in group
-    \p group that is compatible with the given modifiers, or nullptr
-    if there isn't one.  A button list is compatible with a modifiers
+    Returns the items of the first entry for \p id in group \p group
+    that is compatible with the given modifiers, or an empty range if
+    there isn't one.  A button list is compatible with a modifiers
     if it is either insensitive to all modifiers in \p sensitive or
     it requires the modifiers to be in the state indicated by \p required
     for every modifier indicated by \p sensitive.
     */
-    const KeyItemList* findCompatibleKey(KeyID id, std::int32_t group, KeyModifierMask required,
-                                         KeyModifierMask sensitive) const;
+    KeyItemRange findCompatibleKey(KeyID id, std::int32_t group, KeyModifierMask required,
+                                   KeyModifierMask sensitive) const;
 
     //! Test if modifier is half-duplex
     /*!
@@ -353,9 +389,65 @@ private:
     // A list of ways to synthesize a KeyID
     typedef std::vector<KeyItemList> KeyEntryList;
 
+    // One way to synthesize KeyID \c m_id in group \c m_group:  the
+    // \c m_count items starting at \c m_first in the item array
+    struct KeyEntry {
+        KeyID m_id;
+        std::int32_t m_group;
+        std::uint32_t m_first;
+        std::uint32_t m_count;
+    };
+
+    // The ways to synthesize a KeyID in one group, in the order they
+    // were added, or in all groups.  Indexes like a KeyEntryList.
+    class KeyEntryRange {
+    public:
+        KeyEntryRange(const KeyItem* items, const KeyEntry* begin, const KeyEntry* end) :
+            m_items(items), m_begin(begin), m_end(end) { }
+
+        size_t size() const { return static_cast<size_t>(m_end - m_begin); }
+        bool empty() const { return m_begin == m_end; }
+        KeyItemRange operator[](size_t i) const
+        {
+            const KeyItem* first = m_items + m_begin[i].m_first;
+            return KeyItemRange(first, first + m_begin[i].m_count);
+        }
+
+        // returns the entries in group \p group
+        KeyEntryRange inGroup(std::int32_t group) const;
+
+    private:
+        const KeyItem* m_items;
+        const KeyEntry* m_begin;
+        const KeyEntry* m_end;
+    };
+
+    // orders entries by KeyID then group
+    struct KeyEntryLess {
+        bool operator()(const KeyEntry& a, const KeyEntry& b) const
+        {
+            return a.m_id < b.m_id || (a.m_id == b.m_id && a.m_group < b.m_group);
+        }
+    };
+
+    // returns the entries for \p id in group \p group
+    KeyEntryRange findEntries(KeyID id, std::int32_t group) const;
+
+    // returns the entries for \p id in all groups
+    KeyEntryRange findEntries(KeyID id) const;
+
+    // adds the \p count items in \p items as a new entry for \p id in
+    // group \p group after any existing ones
+    void addEntry(KeyID id, std::int32_t group, const KeyItem* items, std::uint32_t count);
+
     // computes the number of groups
     std::int32_t findNumGroups() const;
 
+    // does the work of mapKey() without consulting the keystroke cache
+    const KeyItem* mapKeyUncached(Keystrokes& keys, KeyID id, std::int32_t group,
+                                  ModifierToKeys& activeModifiers, KeyModifierMask& currentState,
+                                  KeyModifierMask desiredMask, bool isAutoRepeat) const;
+
     // computes the map of modifiers to the keys that generate the modifiers
     void setModifierKeys();
 
@@ -384,8 +476,9 @@ private:
 
     // returns the index into \p entryList of the KeyItemList requiring
     // the fewest modifier changes between \p currentState and
-    // \p desiredState.
-    std::int32_t findBestKey(const KeyEntryList& entryList, KeyModifierMask currentState,
+    // \p desiredState.  \p entryList is a KeyEntryList or a KeyEntryRange.
+    template <class EntryList>
+    std::int32_t findBestKey(const EntryList& entryList, KeyModifierMask currentState,
                              KeyModifierMask desiredState) const;
 
     // gets the \c KeyItem used to synthesize the modifier who's bit is
@@ -439,28 +532,29 @@ private:
     // Initialize key name/id maps
     static void initKeyNameMaps();
 
-    // not implemented
-    KeyMap(const KeyMap&);
-    KeyMap&            operator=(const KeyMap&);
-
 private:
-    // Ways to synthesize a KeyID over multiple keyboard groups
-    typedef std::vector<KeyEntryList> KeyGroupTable;
-
-    // Table of KeyID to ways to synthesize that KeyID
-    typedef std::map<KeyID, KeyGroupTable> KeyIDMap;
-
-    // List of KeyItems that generate a particular modifier
-    typedef std::vector<const KeyItem*> ModifierKeyItemList;
-
-    // Map a modifier to the KeyItems that synthesize that modifier
-    typedef std::vector<ModifierKeyItemList> ModifierToKeyTable;
+    // Inputs to mapKey() that determine its result.  The active modifiers
+    // are flattened into \c m_modifiers, a few words per key item.
+    struct KeystrokeCacheKey {
+        KeyID m_id;
+        std::int32_t m_group;
+        KeyModifierMask m_currentState;
+        KeyModifierMask m_desiredMask;
+        bool m_isAutoRepeat;
+        std::vector<std::uint32_t> m_modifiers;
+
+        bool operator<(const KeystrokeCacheKey&) const;
+    };
 
-    // A set of keys
-    typedef std::set<KeyID> KeySet;
+    // Outputs of mapKey() for a KeystrokeCacheKey
+    struct KeystrokeCacheEntry {
+        Keystrokes m_keys;
+        const KeyItem* m_item;
+        ModifierToKeys m_activeModifiers;
+        KeyModifierMask m_currentState;
+    };
 
-    // A set of buttons
-    typedef std::set<KeyButton> KeyButtonSet;
+    typedef std::map<KeystrokeCacheKey, KeystrokeCacheEntry> KeystrokeCache;
 
     // Key maps for parsing/formatting
     typedef std::map<std::string, KeyID,
@@ -470,21 +564,34 @@ private:
     typedef std::map<KeyID, std::string> KeyToNameMap;
     typedef std::map<KeyModifierMask, std::string> ModifierToNameMap;
 
-    // KeyID info
-    KeyIDMap m_keyIDMap;
+    // KeyID info.  every item ever added is in m_items and m_entries,
+    // sorted by KeyID and group, says which items make up each entry.
+    std::vector<KeyItem> m_items;
+    std::vector<KeyEntry> m_entries;
     std::int32_t m_numGroups;
-    ModifierToKeyTable m_modifierKeys;
+
+    // indices into m_items of the keys that generate each modifier.  the
+    // keys for modifier bit b in group g are the elements of
+    // m_modifierKeyItems from m_modifierKeyOffsets[g * kKeyModifierNumBits + b]
+    // up to the next offset.
+    std::vector<std::uint32_t> m_modifierKeyItems;
+    std::vector<std::uint32_t> m_modifierKeyOffsets;
 
     // composition info
     bool m_composeAcrossGroups;
 
-    // half-duplex info
-    KeyButtonSet m_halfDuplex; // half-duplex set by InputLeap
-    KeySet m_halfDuplexMods; // half-duplex set by user
+    // half-duplex info, both sorted
+    std::vector<KeyButton> m_halfDuplex; // half-duplex set by InputLeap
+    std::vector<KeyID> m_halfDuplexMods; // half-duplex set by user
 
     // dummy KeyItem for changing modifiers
     KeyItem m_modifierKeyItem;
 
+    // memoized results of mapKey(), cleared when it grows past
+    // kMaxKeystrokeCacheSize entries
+    static const size_t kMaxKeystrokeCacheSize = 1024;
+    mutable KeystrokeCache m_keystrokeCache;
+
     // parsing/formatting tables
     static NameToKeyMap* s_nameToKeyMap;
     static NameToModifierMap* s_nameToModifierMap;
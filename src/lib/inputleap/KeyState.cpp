@@ -765,13 +765,13 @@ KeyState::isIgnoredKey(KeyID key, KeyModifierMask) const
 
 KeyButton KeyState::getButton(KeyID id, std::int32_t group) const
 {
-    const inputleap::KeyMap::KeyItemList* items =
+    inputleap::KeyMap::KeyItemRange items =
         m_keyMap.findCompatibleKey(id, group, 0, 0);
-    if (items == nullptr) {
+    if (items.empty()) {
         return 0;
     }
     else {
-        return items->back().m_button;
+        return items.back().m_button;
     }
 }
 
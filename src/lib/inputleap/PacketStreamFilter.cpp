@@ -84,20 +84,48 @@ std::uint32_t PacketStreamFilter::read(void* buffer, std::uint32_t n)
     return n;
 }
 
+static void set_packet_length(std::uint8_t* packet, std::uint32_t count)
+{
+    packet[0] = static_cast<std::uint8_t>((count >> 24) & 0xff);
+    packet[1] = static_cast<std::uint8_t>((count >> 16) & 0xff);
+    packet[2] = static_cast<std::uint8_t>((count >> 8) & 0xff);
+    packet[3] = static_cast<std::uint8_t>(count& 0xff);
+}
+
 void PacketStreamFilter::write(const void* buffer, std::uint32_t count)
 {
-    // write the length of the payload
-    std::uint8_t length[4];
-    length[0] = static_cast<std::uint8_t>((count >> 24) & 0xff);
-    length[1] = static_cast<std::uint8_t>((count >> 16) & 0xff);
-    length[2] = static_cast<std::uint8_t>((count >> 8) & 0xff);
-    length[3] = static_cast<std::uint8_t>(count& 0xff);
-    getStream()->write(length, sizeof(length));
-
-    // write the payload
+    // the length of the payload
+    std::uint8_t packet[kSmallPacketSize];
+    set_packet_length(packet, count);
+
+    // small packets, which are nearly all input events, go to the stream
+    // in a single write
+    if (count != 0 && count <= sizeof(packet) - 4) {
+        std::memcpy(packet + 4, buffer, count);
+        getStream()->write(packet, count + 4);
+        return;
+    }
+
+    getStream()->write(packet, 4);
     getStream()->write(buffer, count);
 }
 
+bool PacketStreamFilter::replaceLastWrite(const void* last, const void* buffer,
+                                          std::uint32_t count)
+{
+    // only packets that went to the stream in a single write are replaced
+    std::uint8_t lastPacket[kSmallPacketSize];
+    std::uint8_t packet[kSmallPacketSize];
+    if (count == 0 || count > sizeof(packet) - 4) {
+        return false;
+    }
+    set_packet_length(lastPacket, count);
+    set_packet_length(packet, count);
+    std::memcpy(lastPacket + 4, last, count);
+    std::memcpy(packet + 4, buffer, count);
+    return getStream()->replaceLastWrite(lastPacket, packet, count + 4);
+}
+
 void
 PacketStreamFilter::shutdownInput()
 {
@@ -40,6 +40,7 @@ public:
     virtual void close() override;
     virtual std::uint32_t read(void* buffer, std::uint32_t n) override;
     virtual void write(const void* buffer, std::uint32_t n) override;
+    bool replaceLastWrite(const void* last, const void* buffer, std::uint32_t n) override;
     virtual void shutdownInput() override;
     virtual bool isReady() const override;
     virtual std::uint32_t getSize() const override;
@@ -49,6 +50,9 @@ protected:
     void filterEvent(const Event&) override;
 
 private:
+    // packets up to this size, with the length, are written in one piece
+    static const std::uint32_t kSmallPacketSize = 64;
+
     bool isReadyNoLock() const;
 
     // returns false on erroneous packet size
@@ -57,6 +57,11 @@ public:
     std::string& getDraggingFilename() override { return m_draggingFilename; }
     void clearDraggingFilename() override { }
 
+    // ISecondaryScreen overrides
+    void fakeBatchBegin() override { }
+    void fakeBatchEnd() override { }
+    double getRefreshRate() const override { return 0.0; }
+
     // IPlatformScreen overrides
     
     void fakeDraggingFiles(DragFileList fileList)  override
@@ -44,6 +44,60 @@ ProtocolUtil::writef(inputleap::IStream* stream, const char* fmt, ...)
     va_end(args);
 }
 
+void ProtocolUtil::writef(inputleap::IStream* stream, ProtocolMessageCache& cache,
+                          const char* fmt, ...)
+{
+    assert(stream != nullptr);
+    assert(fmt != nullptr);
+
+    const std::vector<std::uint8_t>* message = nullptr;
+    for (const auto& cached : cache.messages_) {
+        if (cached.fmt == fmt) {
+            message = &cached.data;
+            break;
+        }
+    }
+
+    if (message == nullptr) {
+        LOG((CLOG_DEBUG2 "writef(%s)", fmt));
+
+        va_list args;
+        va_start(args, fmt);
+        std::uint32_t size = getLength(fmt, args);
+        va_end(args);
+
+        std::vector<std::uint8_t> data(size);
+        if (size != 0) {
+            va_start(args, fmt);
+            writef_void(data.data(), fmt, args);
+            va_end(args);
+        }
+        cache.messages_.push_back({fmt, std::move(data)});
+        message = &cache.messages_.back().data;
+    }
+
+    if (!message->empty()) {
+        stream->write(message->data(), static_cast<std::uint32_t>(message->size()));
+        LOG((CLOG_DEBUG2 "wrote %d bytes", static_cast<std::uint32_t>(message->size())));
+    }
+}
+
+void ProtocolUtil::formatf(std::vector<std::uint8_t>& message, const char* fmt, ...)
+{
+    assert(fmt != nullptr);
+
+    va_list args;
+    va_start(args, fmt);
+    message.resize(getLength(fmt, args));
+    va_end(args);
+
+    if (!message.empty()) {
+        va_start(args, fmt);
+        writef_void(message.data(), fmt, args);
+        va_end(args);
+    }
+}
+
 bool
 ProtocolUtil::readf(inputleap::IStream* stream, const char* fmt, ...)
 {
@@ -21,12 +21,40 @@
 #include "io/XIO.h"
 #include "base/EventTypes.h"
 
+#include <cstdint>
 #include <stdarg.h>
+#include <vector>
 
 namespace inputleap {
 
 class IStream;
 
+//! Formatted messages for several streams
+/*!
+Holds messages formatted by ProtocolUtil::writef() so that the same
+message can be written to many streams while being formatted only once.
+Messages are identified by the address of their format string, so a cache
+must only be used for writing one set of arguments, e.g. a single key
+event that is sent to several clients.
+*/
+class ProtocolMessageCache {
+public:
+    //! Get the number of distinct messages formatted so far
+    std::size_t size() const { return messages_.size(); }
+
+private:
+    friend class ProtocolUtil;
+
+    struct Message {
+        const char* fmt;
+        std::vector<std::uint8_t> data;
+    };
+
+    // there are rarely more than a couple of formats for a message so a
+    // linear search is fastest
+    std::vector<Message> messages_;
+};
+
 /**
 This class provides various functions for implementing the inputleap protocol.
 */
@@ -52,6 +80,20 @@ public:
     */
     static void writef(inputleap::IStream*, const char* fmt, ...);
 
+    //! Write formatted data using a message cache
+    /*!
+    Like writef() but the formatted message is taken from \c cache if a
+    message with \c fmt was already written using it and is added to
+    \c cache otherwise.  All streams get the same bytes in a single write.
+    */
+    static void writef(inputleap::IStream*, ProtocolMessageCache& cache, const char* fmt, ...);
+
+    //! Format data
+    /*!
+    Formats the data like writef() into \c message instead of writing it.
+    */
+    static void formatf(std::vector<std::uint8_t>& message, const char* fmt, ...);
+
     //! Read formatted data
     /*!
     Read formatted binary data from a buffer.  This performs the
@@ -240,6 +240,16 @@ void Screen::mouseWheel(std::int32_t xDelta, std::int32_t yDelta)
     m_screen->fakeMouseWheel(xDelta, yDelta);
 }
 
+void Screen::fakeBatchBegin()
+{
+    m_screen->fakeBatchBegin();
+}
+
+void Screen::fakeBatchEnd()
+{
+    m_screen->fakeBatchEnd();
+}
+
 void
 Screen::resetOptions()
 {
@@ -393,6 +403,11 @@ void Screen::getCursorCenter(std::int32_t& x, std::int32_t& y) const
     m_screen->getCursorCenter(x, y);
 }
 
+double Screen::getRefreshRate() const
+{
+    return m_screen->getRefreshRate();
+}
+
 KeyModifierMask
 Screen::getActiveModifiers() const
 {
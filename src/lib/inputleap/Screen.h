@@ -172,6 +172,19 @@ public:
     */
     void mouseWheel(std::int32_t xDelta, std::int32_t yDelta);
 
+    //! Begin a batch of synthesized input
+    /*!
+    Lets the screen queue the input synthesized until the matching
+    \c fakeBatchEnd() and deliver it at once.  Batches may be nested.
+    */
+    void fakeBatchBegin();
+
+    //! End a batch of synthesized input
+    /*!
+    Delivers the input synthesized since the outermost \c fakeBatchBegin().
+    */
+    void fakeBatchEnd();
+
     //! Notify of options changes
     /*!
     Resets all options to their default values.
@@ -260,6 +273,13 @@ public:
     */
     void getCursorCenter(std::int32_t& x, std::int32_t& y) const;
 
+    //! Get display refresh rate
+    /*!
+    Returns the highest refresh rate in Hz of the displays that make up
+    the screen, or 0 if it is not known.
+    */
+    double getRefreshRate() const;
+
     //! Get the active modifiers
     /*!
     Returns the modifiers that are currently active according to our
@@ -0,0 +1,131 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "inputleap/ScreenId.h"
+#include "base/String.h"
+
+#include <cassert>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace inputleap {
+
+namespace {
+
+struct ScreenIdTable {
+    std::mutex mutex;
+
+    // a deque never moves its elements so references to names stay valid
+    std::deque<std::string> names;
+    std::map<std::string, ScreenId, inputleap::string::CaselessCmp> ids;
+};
+
+ScreenIdTable& screen_id_table()
+{
+    static ScreenIdTable table;
+    return table;
+}
+
+} // namespace
+
+ScreenId ScreenIds::intern(const std::string& name)
+{
+    ScreenIdTable& table = screen_id_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto i = table.ids.find(name);
+    if (i != table.ids.end()) {
+        return i->second;
+    }
+    ScreenId id = static_cast<ScreenId>(table.names.size());
+    assert(id != kNoScreenId);
+    table.names.push_back(name);
+    table.ids.insert(std::make_pair(name, id));
+    return id;
+}
+
+ScreenId ScreenIds::find(const std::string& name)
+{
+    ScreenIdTable& table = screen_id_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto i = table.ids.find(name);
+    return i == table.ids.end() ? kNoScreenId : i->second;
+}
+
+const std::string& ScreenIds::name(ScreenId id)
+{
+    ScreenIdTable& table = screen_id_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    assert(id < table.names.size());
+    return table.names[id];
+}
+
+std::size_t ScreenIds::count()
+{
+    ScreenIdTable& table = screen_id_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.names.size();
+}
+
+ScreenIdSet ScreenIdSet::all()
+{
+    ScreenIdSet set;
+    set.all_ = true;
+    return set;
+}
+
+ScreenIdSet ScreenIdSet::from_names(const std::set<std::string>& names)
+{
+    ScreenIdSet set;
+    for (const auto& name : names) {
+        if (name == "*") {
+            return all();
+        }
+        set.insert(ScreenIds::intern(name));
+    }
+    return set;
+}
+
+void ScreenIdSet::insert(ScreenId id)
+{
+    assert(id != kNoScreenId);
+    std::size_t word = id / 64;
+    if (word >= bits_.size()) {
+        bits_.resize(word + 1, 0);
+    }
+    bits_[word] |= std::uint64_t(1) << (id % 64);
+}
+
+std::string ScreenIdSet::to_string() const
+{
+    if (all_) {
+        return "*";
+    }
+    std::string result;
+    for (std::size_t word = 0; word < bits_.size(); ++word) {
+        for (std::size_t bit = 0; bit < 64; ++bit) {
+            if ((bits_[word] & (std::uint64_t(1) << bit)) != 0) {
+                if (!result.empty()) {
+                    result += ", ";
+                }
+                result += ScreenIds::name(static_cast<ScreenId>(word * 64 + bit));
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace inputleap
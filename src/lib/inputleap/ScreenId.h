@@ -0,0 +1,129 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace inputleap {
+
+//! Interned screen name
+/*!
+A small integer that stands for a screen name.  Names that differ only in
+case get the same id.  Ids are assigned the first time a name is seen and
+never change for the life of the process, so they stay valid across
+configuration reloads and can be compared and used as indices instead of
+the names.
+*/
+typedef std::uint32_t ScreenId;
+
+//! Id of no screen
+const ScreenId kNoScreenId = std::numeric_limits<ScreenId>::max();
+
+//! Screen name interning
+/*!
+Maps screen names to ScreenId and back.  All functions are thread safe.
+*/
+class ScreenIds {
+public:
+    //! Get the id of a name, assigning a new one if the name is unknown
+    /*!
+    Ids are never released, so only intern names from the configuration.
+    Names from the network must be looked up with find().
+    */
+    static ScreenId intern(const std::string& name);
+
+    //! Get the id of a name or \c kNoScreenId if the name is unknown
+    static ScreenId find(const std::string& name);
+
+    //! Get the name an id was assigned for
+    /*!
+    Returns the spelling of the name when it was first interned.  Names
+    are only needed for logging and I/O; the returned reference stays valid
+    for the life of the process.
+    */
+    static const std::string& name(ScreenId id);
+
+    //! Get the number of assigned ids
+    /*!
+    All ids are less than the returned value.
+    */
+    static std::size_t count();
+};
+
+//! Set of screens
+/*!
+A bitset of ScreenId.  The set can also stand for all screens, including
+screens that get an id later.
+*/
+class ScreenIdSet {
+public:
+    ScreenIdSet() = default;
+
+    //! Get the set of all screens
+    static ScreenIdSet all();
+
+    //! Create set from names
+    /*!
+    Interns each name.  A name of "*" makes it the set of all screens.
+    */
+    static ScreenIdSet from_names(const std::set<std::string>& names);
+
+    //! Add a screen
+    void insert(ScreenId id);
+
+    //! Test for a screen
+    bool contains(ScreenId id) const
+    {
+        if (all_) {
+            return true;
+        }
+        std::size_t word = id / 64;
+        return word < bits_.size() && (bits_[word] & (std::uint64_t(1) << (id % 64))) != 0;
+    }
+
+    //! Test for the empty set
+    bool empty() const { return !all_ && bits_.empty(); }
+
+    //! Test for the set of all screens
+    bool is_all() const { return all_; }
+
+    //! Format set for logging
+    /*!
+    Returns the names of the screens separated by commas, or "*" for the
+    set of all screens.
+    */
+    std::string to_string() const;
+
+    bool operator==(const ScreenIdSet& other) const
+    {
+        return all_ == other.all_ && bits_ == other.bits_;
+    }
+    bool operator!=(const ScreenIdSet& other) const { return !(*this == other); }
+
+private:
+    bool all_ = false;
+
+    // trailing zero words are never stored so equal sets compare equal
+    std::vector<std::uint64_t> bits_;
+};
+
+} // namespace inputleap
@@ -35,6 +35,7 @@
 #include "base/log_outputters.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/MetricsText.h"
 #include "common/Version.h"
 #include "common/DataDirectories.h"
 
@@ -49,6 +50,10 @@
 #include <unistd.h>
 #include <signal.h>
 #include "platform/XWindowsScreen.h"
+#include "platform/XWindowsXCBImpl.h"
+#endif
+#if SYSAPI_UNIX
+#include "inputleap/unix/MetricsSocketUnix.h"
 #endif
 #if WINAPI_CARBON
 #include "platform/OSXScreen.h"
@@ -139,6 +144,11 @@ ServerApp::help()
            << HELP_COMMON_INFO_1
            << "      --disable-client-cert-checking disable client SSL certificate \n"
               "                                     checking (deprecated)\n"
+#if SYSAPI_UNIX
+           << "      --metrics-socket <path>\n"
+           << "                           serve metrics in the Prometheus text format\n"
+           << "                           on a Unix socket at <path>\n"
+#endif
 #ifdef WINAPI_XWINDOWS
            << "      --display <display>  connect to the X server at <display>\n"
            << "      --screen-change-script <path>\n"
@@ -174,9 +184,16 @@ ServerApp::reloadSignalHandler(Arch::ESignal, void*)
 void ServerApp::reload_config()
 {
     LOG((CLOG_DEBUG "reload configuration"));
-    if (loadConfig(args().m_configFile)) {
-        if (m_server != nullptr) {
-            m_server->setConfig(*args().m_config);
+    Config config(m_events);
+    if (read_config(args().m_configFile, config)) {
+        if (m_server == nullptr) {
+            *args().m_config = config;
+        }
+        // the server updates its configuration, which is ours, in place
+        else if (!m_server->setConfig(config)) {
+            LOG((CLOG_WARN "cannot reload configuration without the primary screen \"%s\"",
+                 args().m_name.c_str()));
+            return;
         }
         LOG((CLOG_NOTE "reloaded configuration"));
     }
@@ -225,6 +242,11 @@ ServerApp::loadConfig()
 }
 
 bool ServerApp::loadConfig(const std::string& pathname)
+{
+    return read_config(pathname, *args().m_config);
+}
+
+bool ServerApp::read_config(const std::string& pathname, Config& config)
 {
     try {
         // load configuration
@@ -238,7 +260,7 @@ bool ServerApp::loadConfig(const std::string& pathname)
                 pathname.c_str()));
             return false;
         }
-        configStream >> *args().m_config;
+        configStream >> config;
         LOG((CLOG_DEBUG "configuration read successfully"));
         return true;
     }
@@ -595,7 +617,7 @@ ServerApp::createScreen()
 #endif
 #if WINAPI_XWINDOWS
     return new inputleap::Screen(new XWindowsScreen(
-        new XWindowsImpl(),
+        new XWindowsXCBImpl(),
         args().m_display, true, 0, m_events), m_events);
 #endif
 #if WINAPI_CARBON
@@ -746,6 +768,14 @@ ServerApp::mainLoop()
         initIpcClient();
     }
 
+#if SYSAPI_UNIX
+    std::unique_ptr<MetricsSocketUnix> metrics_socket;
+    if (!args().metrics_socket_path.empty()) {
+        metrics_socket = std::make_unique<MetricsSocketUnix>(m_events, args().metrics_socket_path,
+                                                             [this]() { return get_metrics(); });
+    }
+#endif
+
     // handle hangup signal by reloading the server's configuration
     ARCH->setSignalHandler(Arch::kHANGUP, &reloadSignalHandler, nullptr);
     m_events->add_handler(EventType::SERVER_APP_RELOAD_CONFIG, m_events->getSystemTarget(),
@@ -784,6 +814,9 @@ ServerApp::mainLoop()
 
     // close down
     LOG((CLOG_DEBUG1 "stopping server"));
+#if SYSAPI_UNIX
+    metrics_socket.reset();
+#endif
     m_events->removeHandler(EventType::SERVER_APP_FORCE_RECONNECT, m_events->getSystemTarget());
     m_events->removeHandler(EventType::SERVER_APP_RELOAD_CONFIG, m_events->getSystemTarget());
     cleanupServer();
@@ -797,6 +830,14 @@ ServerApp::mainLoop()
     return kExitSuccess;
 }
 
+void ServerApp::write_metrics(MetricsText& metrics) const
+{
+    App::write_metrics(metrics);
+    if (m_server != nullptr) {
+        m_server->writeMetrics(metrics);
+    }
+}
+
 void ServerApp::reset_server()
 {
     LOG((CLOG_DEBUG1 "resetting server"));
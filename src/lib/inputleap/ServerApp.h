@@ -114,8 +114,12 @@ public:
     EventQueueTimer* m_timer;
     NetworkAddress* listen_address_;
 
+protected:
+    void write_metrics(MetricsText& metrics) const override;
+
 private:
     void handle_screen_switched(const Event& event);
+    bool read_config(const std::string& pathname, Config& config);
 };
 
 // configuration file name
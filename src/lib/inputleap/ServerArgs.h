@@ -32,6 +32,7 @@ public:
     std::string m_configFile;
     Config* m_config;
     std::string m_screenChangeScript;
+    std::string metrics_socket_path;
     bool check_client_certificates = true;
 };
 
@@ -0,0 +1,235 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "inputleap/unix/MetricsSocketUnix.h"
+
+#include "base/IEventQueue.h"
+#include "base/Log.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <utility>
+
+namespace inputleap {
+
+namespace {
+
+// a reader that stops reading must not stall the other readers for long
+const int kSendTimeoutSeconds = 1;
+
+#ifdef MSG_NOSIGNAL
+const int kSendFlags = MSG_NOSIGNAL;
+#else
+const int kSendFlags = 0;
+#endif
+
+} // namespace
+
+MetricsSocketUnix::MetricsSocketUnix(IEventQueue* events, const std::string& path,
+                                     RenderFunc render) :
+    events_(events),
+    path_(path),
+    render_(std::move(render))
+{
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    if (path_.size() >= sizeof(addr.sun_path)) {
+        LOG((CLOG_WARN "metrics socket path is too long: %s", path_.c_str()));
+        return;
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path_.c_str(), path_.size());
+
+    // only replace a socket, never a file the path was pointed at by mistake
+    struct stat info;
+    if (lstat(path_.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            LOG((CLOG_WARN "not replacing %s with the metrics socket, it is not a socket",
+                 path_.c_str()));
+            return;
+        }
+        unlink(path_.c_str());
+    }
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        LOG((CLOG_WARN "cannot create metrics socket: %s", std::strerror(errno)));
+        return;
+    }
+    fcntl(listen_fd_, F_SETFD, FD_CLOEXEC);
+
+    // make the socket accessible to the user only.  nobody can connect
+    // before listen, so restricting it between bind and listen leaves no
+    // window for others.
+    bool bound = bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    if (!bound || chmod(path_.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+            listen(listen_fd_, 4) != 0 || pipe(wake_fds_) != 0) {
+        LOG((CLOG_WARN "cannot listen on metrics socket %s: %s",
+             path_.c_str(), std::strerror(errno)));
+        close(listen_fd_);
+        listen_fd_ = -1;
+        if (bound) {
+            unlink(path_.c_str());
+        }
+        return;
+    }
+
+    events_->add_handler(EventType::METRICS_SOCKET_CONNECTION, this,
+                         [this](const auto& e){ handle_connection(e); });
+    thread_ = std::thread([this]() { run(); });
+    LOG((CLOG_DEBUG "serving metrics on %s", path_.c_str()));
+}
+
+MetricsSocketUnix::~MetricsSocketUnix()
+{
+    if (listen_fd_ < 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        stopping_ = true;
+    }
+    char wake = 0;
+    ssize_t written = write(wake_fds_[1], &wake, 1);
+    (void) written;
+    thread_.join();
+
+    events_->removeHandler(EventType::METRICS_SOCKET_CONNECTION, this);
+
+    // connections still queued are dropped along with their events
+    for (int fd : pending_fds_) {
+        close(fd);
+    }
+    for (const auto& reply : replies_) {
+        close(reply.first);
+    }
+
+    close(wake_fds_[0]);
+    close(wake_fds_[1]);
+    close(listen_fd_);
+    unlink(path_.c_str());
+}
+
+void MetricsSocketUnix::run()
+{
+    pollfd fds[2];
+    fds[0].fd = listen_fd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = wake_fds_[0];
+    fds[1].events = POLLIN;
+
+    for (;;) {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG((CLOG_WARN "metrics socket stopped: %s", std::strerror(errno)));
+            return;
+        }
+        if (fds[1].revents != 0) {
+            char wake[16];
+            ssize_t n = read(wake_fds_[0], wake, sizeof(wake));
+            (void) n;
+            {
+                std::lock_guard<std::mutex> lock(pending_mutex_);
+                if (stopping_) {
+                    return;
+                }
+            }
+            send_replies();
+        }
+        if ((fds[0].revents & POLLIN) == 0) {
+            continue;
+        }
+
+        int fd = accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+        // the reply is rendered on the main thread, which owns the counters
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_fds_.insert(fd);
+        }
+        events_->add_event(EventType::METRICS_SOCKET_CONNECTION, this,
+                           create_event_data<int>(fd));
+    }
+}
+
+void MetricsSocketUnix::send_replies()
+{
+    std::vector<std::pair<int, std::string>> replies;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        replies.swap(replies_);
+    }
+
+    for (const auto& reply : replies) {
+        int fd = reply.first;
+        timeval timeout = { kSendTimeoutSeconds, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+        const char* data = reply.second.data();
+        std::size_t size = reply.second.size();
+        while (size > 0) {
+            ssize_t n = send(fd, data, size, kSendFlags);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                LOG((CLOG_DEBUG "cannot send metrics: %s", std::strerror(errno)));
+                break;
+            }
+            data += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        close(fd);
+    }
+}
+
+void MetricsSocketUnix::handle_connection(const Event& event)
+{
+    int fd = event.get_data_as<int>();
+
+    // sending may block on a slow reader, so leave it to the background thread
+    std::string text = render_();
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_fds_.erase(fd);
+        replies_.emplace_back(fd, std::move(text));
+    }
+    char wake = 0;
+    ssize_t written = write(wake_fds_[1], &wake, 1);
+    (void) written;
+}
+
+} // namespace inputleap
@@ -0,0 +1,74 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace inputleap {
+
+class Event;
+class IEventQueue;
+
+//! Serves metrics on a local socket
+/*!
+Listens on a Unix domain socket and answers every connection with the text
+returned by the render function, then closes it.  Connections are accepted
+and answered on a background thread but the render function is called from
+the event loop, so it may read state owned by the main thread.
+*/
+class MetricsSocketUnix {
+public:
+    using RenderFunc = std::function<std::string()>;
+
+    //! Start listening on \c path, replacing a stale socket left there
+    /*!
+    Logs a warning and serves nothing if the socket cannot be created or
+    something other than a socket exists at \c path.
+    */
+    MetricsSocketUnix(IEventQueue* events, const std::string& path, RenderFunc render);
+    MetricsSocketUnix(const MetricsSocketUnix&) = delete;
+    MetricsSocketUnix& operator=(const MetricsSocketUnix&) = delete;
+    ~MetricsSocketUnix();
+
+private:
+    void run();
+    void send_replies();
+    void handle_connection(const Event& event);
+
+    IEventQueue* events_;
+    std::string path_;
+    RenderFunc render_;
+    int listen_fd_ = -1;
+    int wake_fds_[2] = { -1, -1 };
+    std::thread thread_;
+
+    // accepted connections whose events haven't been handled yet, and
+    // rendered replies the background thread hasn't sent yet
+    std::mutex pending_mutex_;
+    std::set<int> pending_fds_;
+    std::vector<std::pair<int, std::string>> replies_;
+    bool stopping_ = false;
+};
+
+} // namespace inputleap
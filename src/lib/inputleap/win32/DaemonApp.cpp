@@ -335,6 +335,21 @@ void DaemonApp::handle_ipc_message(const Event& e)
             break;
         }
 
+        case kIpcDispatchStats:
+            // the node logs the statistics, which reach the gui as log lines
+            m_ipcServer->send(m, kIpcClientNode);
+            break;
+
+        case kIpcMetrics:
+            // requests come from the gui and answers from the node
+            if (static_cast<const IpcMetricsMessage&>(m).metrics().empty()) {
+                m_ipcServer->send(m, kIpcClientNode);
+            }
+            else {
+                m_ipcServer->send(m, kIpcClientGui);
+            }
+            break;
+
         case kIpcHello:
             const auto& hm = static_cast<const IpcHelloMessage&>(m);
             std::string type;
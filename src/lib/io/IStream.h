@@ -26,6 +26,21 @@ class IEventQueue;
 
 namespace inputleap {
 
+//! Stream traffic counters
+/*!
+Counts the data that passed through a stream since it was created.
+*/
+struct StreamCounters {
+    //! Bytes read from the stream
+    std::uint64_t m_bytesRead = 0;
+
+    //! Bytes written to the stream
+    std::uint64_t m_bytesWritten = 0;
+
+    //! Bytes written to the stream but not sent yet
+    std::uint32_t m_bytesPending = 0;
+};
+
 //! Bidirectional stream interface
 /*!
 Defines the interface for all streams.
@@ -65,6 +80,22 @@ public:
     */
     virtual void write(const void* buffer, std::uint32_t n) = 0;
 
+    //! Replace the last write
+    /*!
+    If the data most recently passed to \c write() was the \c n bytes at
+    \c last and none of it has been sent yet, replaces it with the \c n
+    bytes at \c buffer and returns true.  Otherwise returns false without
+    changing anything; the caller should then \c write() the data.
+    Streams that can't replace data always return false.
+    */
+    virtual bool replaceLastWrite(const void* last, const void* buffer, std::uint32_t n)
+    {
+        (void) last;
+        (void) buffer;
+        (void) n;
+        return false;
+    }
+
     //! Flush the stream
     /*!
     Waits until all buffered data has been written to the stream.
@@ -114,6 +145,13 @@ public:
     */
     virtual std::uint32_t getSize() const = 0;
 
+    //! Get traffic counters
+    /*!
+    Returns the counters of the stream at the end of a chain of stream
+    filters.  Streams that don't count traffic return zeros.
+    */
+    virtual StreamCounters getCounters() const { return StreamCounters(); }
+
     //@}
 };
 
@@ -22,7 +22,9 @@
 // StreamBuffer
 //
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 const std::uint32_t StreamBuffer::kChunkSize = 4096;
 
@@ -138,6 +140,34 @@ void StreamBuffer::write(const void* vdata, std::uint32_t n)
     }
 }
 
+bool StreamBuffer::replaceTail(const void* expected, const void* replacement, std::uint32_t n)
+{
+    if (n == 0 || n > m_size) {
+        return false;
+    }
+
+    // the tail may span chunks.  we never reach the used part of the head
+    // chunk since the buffer has at least n bytes.
+    const std::uint8_t* old = static_cast<const std::uint8_t*>(expected);
+    std::uint32_t left = n;
+    for (ChunkList::reverse_iterator scan = m_chunks.rbegin(); left > 0; ++scan) {
+        std::uint32_t count = std::min(left, static_cast<std::uint32_t>(scan->size()));
+        left -= count;
+        if (std::memcmp(scan->data() + scan->size() - count, old + left, count) != 0) {
+            return false;
+        }
+    }
+
+    const std::uint8_t* data = static_cast<const std::uint8_t*>(replacement);
+    left = n;
+    for (ChunkList::reverse_iterator scan = m_chunks.rbegin(); left > 0; ++scan) {
+        std::uint32_t count = std::min(left, static_cast<std::uint32_t>(scan->size()));
+        left -= count;
+        std::memcpy(scan->data() + scan->size() - count, data + left, count);
+    }
+    return true;
+}
+
 std::uint32_t StreamBuffer::getSize() const
 {
     return m_size;
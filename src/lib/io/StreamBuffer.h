@@ -55,6 +55,15 @@ public:
     */
     void write(const void* data, std::uint32_t n);
 
+    //! Replace data at the end of the buffer
+    /*!
+    If the last \c n bytes in the buffer are the \c n bytes at
+    \c expected then overwrites them with the \c n bytes at
+    \c replacement and returns true.  Otherwise returns false and leaves
+    the buffer unchanged.
+    */
+    bool replaceTail(const void* expected, const void* replacement, std::uint32_t n);
+
     //@}
     //! @name accessors
     //@{
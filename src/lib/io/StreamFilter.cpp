@@ -56,6 +56,11 @@ void StreamFilter::write(const void* buffer, std::uint32_t n)
     getStream()->write(buffer, n);
 }
 
+bool StreamFilter::replaceLastWrite(const void* last, const void* buffer, std::uint32_t n)
+{
+    return getStream()->replaceLastWrite(last, buffer, n);
+}
+
 void
 StreamFilter::flush()
 {
@@ -91,6 +96,11 @@ std::uint32_t StreamFilter::getSize() const
     return getStream()->getSize();
 }
 
+StreamCounters StreamFilter::getCounters() const
+{
+    return getStream()->getCounters();
+}
+
 inputleap::IStream*
 StreamFilter::getStream() const
 {
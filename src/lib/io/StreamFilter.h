@@ -44,12 +44,14 @@ public:
     void close() override;
     std::uint32_t read(void* buffer, std::uint32_t n) override;
     void write(const void* buffer, std::uint32_t n) override;
+    bool replaceLastWrite(const void* last, const void* buffer, std::uint32_t n) override;
     void flush() override;
     void shutdownInput() override;
     void shutdownOutput() override;
     void* getEventTarget() const override;
     bool isReady() const override;
     std::uint32_t getSize() const override;
+    StreamCounters getCounters() const override;
 
     //! Get the stream
     /*!
@@ -26,6 +26,8 @@ enum EIpcMessage {
     kIpcLogLine,
     kIpcCommand,
     kIpcShutdown,
+    kIpcDispatchStats,
+    kIpcMetrics,
 };
 
 enum EIpcClientType {
@@ -50,3 +52,14 @@ extern const char*        kIpcMsgCommand;
 // shutdown: daemon -> node
 // the daemon tells input-leaps/c to shut down gracefully.
 extern const char*        kIpcMsgShutdown;
+
+// dispatch stats: gui -> daemon -> node
+// asks input-leaps/c to log its event dispatch latency statistics. the
+// first request enables collecting them.
+extern const char*        kIpcMsgDispatchStats;
+
+// metrics: gui -> daemon -> node, node -> daemon -> gui
+// $1 = metrics of input-leaps/c in the Prometheus text format. an empty
+// $1 asks input-leaps/c for its metrics, which it answers with the same
+// message.
+extern const char*        kIpcMsgMetrics;
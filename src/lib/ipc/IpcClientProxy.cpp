@@ -90,6 +90,12 @@ void IpcClientProxy::handle_data()
         else if (memcmp(code, kIpcMsgCommand, 4) == 0) {
             event_data = create_event_data<IpcCommandMessage>(parseCommand());
         }
+        else if (memcmp(code, kIpcMsgDispatchStats, 4) == 0) {
+            event_data = create_event_data<IpcDispatchStatsMessage>(IpcDispatchStatsMessage{});
+        }
+        else if (memcmp(code, kIpcMsgMetrics, 4) == 0) {
+            event_data = create_event_data<IpcMetricsMessage>(parseMetrics());
+        }
         else {
             LOG((CLOG_ERR "invalid ipc message"));
             disconnect();
@@ -125,6 +131,17 @@ IpcClientProxy::send(const IpcMessage& message)
         ProtocolUtil::writef(stream_.get(), kIpcMsgShutdown);
         break;
 
+    case kIpcDispatchStats:
+        ProtocolUtil::writef(stream_.get(), kIpcMsgDispatchStats);
+        break;
+
+    case kIpcMetrics: {
+        const IpcMetricsMessage& mm = static_cast<const IpcMetricsMessage&>(message);
+        const std::string metrics = mm.metrics();
+        ProtocolUtil::writef(stream_.get(), kIpcMsgMetrics, &metrics);
+        break;
+    }
+
     default:
         LOG((CLOG_ERR "ipc message not supported: %d", message.type()));
         break;
@@ -152,6 +169,13 @@ IpcCommandMessage IpcClientProxy::parseCommand()
     return IpcCommandMessage(command, elevate != 0);
 }
 
+IpcMetricsMessage IpcClientProxy::parseMetrics()
+{
+    std::string metrics;
+    ProtocolUtil::readf(stream_.get(), kIpcMsgMetrics + 4, &metrics);
+    return IpcMetricsMessage(metrics);
+}
+
 void
 IpcClientProxy::disconnect()
 {
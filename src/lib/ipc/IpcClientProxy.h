@@ -30,6 +30,7 @@ namespace inputleap {
 class IpcMessage;
 class IpcCommandMessage;
 class IpcHelloMessage;
+class IpcMetricsMessage;
 class IEventQueue;
 class IStream;
 
@@ -47,6 +48,7 @@ private:
     void handle_write_error();
     IpcHelloMessage parseHello();
     IpcCommandMessage parseCommand();
+    IpcMetricsMessage parseMetrics();
     void disconnect();
 
 private:
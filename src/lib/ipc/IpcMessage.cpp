@@ -49,6 +49,25 @@ IpcShutdownMessage::~IpcShutdownMessage()
 {
 }
 
+IpcDispatchStatsMessage::IpcDispatchStatsMessage() :
+    IpcMessage(kIpcDispatchStats)
+{
+}
+
+IpcDispatchStatsMessage::~IpcDispatchStatsMessage()
+{
+}
+
+IpcMetricsMessage::IpcMetricsMessage(const std::string& metrics) :
+    IpcMessage(kIpcMetrics),
+    m_metrics(metrics)
+{
+}
+
+IpcMetricsMessage::~IpcMetricsMessage()
+{
+}
+
 IpcLogLineMessage::IpcLogLineMessage(const std::string& logLine) :
     IpcMessage(kIpcLogLine),
     m_logLine(logLine)
@@ -57,6 +57,24 @@ public:
     virtual ~IpcShutdownMessage();
 };
 
+class IpcDispatchStatsMessage : public IpcMessage {
+public:
+    IpcDispatchStatsMessage();
+    virtual ~IpcDispatchStatsMessage();
+};
+
+class IpcMetricsMessage : public IpcMessage {
+public:
+    IpcMetricsMessage(const std::string& metrics);
+    virtual ~IpcMetricsMessage();
+
+    //! Gets the metrics; empty when asking for them.
+    std::string metrics() const { return m_metrics; }
+
+private:
+    std::string m_metrics;
+};
+
 
 class IpcLogLineMessage : public IpcMessage {
 public:
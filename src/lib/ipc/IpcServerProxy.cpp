@@ -57,6 +57,12 @@ void IpcServerProxy::handle_data()
         else if (memcmp(code, kIpcMsgShutdown, 4) == 0) {
             event_data = create_event_data<IpcShutdownMessage>(IpcShutdownMessage{});
         }
+        else if (memcmp(code, kIpcMsgDispatchStats, 4) == 0) {
+            event_data = create_event_data<IpcDispatchStatsMessage>(IpcDispatchStatsMessage{});
+        }
+        else if (memcmp(code, kIpcMsgMetrics, 4) == 0) {
+            event_data = create_event_data<IpcMetricsMessage>(parseMetrics());
+        }
         else {
             LOG((CLOG_ERR "invalid ipc message"));
             disconnect();
@@ -89,6 +95,13 @@ IpcServerProxy::send(const IpcMessage& message)
         break;
     }
 
+    case kIpcMetrics: {
+        const IpcMetricsMessage& mm = static_cast<const IpcMetricsMessage&>(message);
+        const std::string metrics = mm.metrics();
+        ProtocolUtil::writef(&m_stream, kIpcMsgMetrics, &metrics);
+        break;
+    }
+
     default:
         LOG((CLOG_ERR "ipc message not supported: %d", message.type()));
         break;
@@ -104,6 +117,13 @@ IpcLogLineMessage IpcServerProxy::parseLogLine()
     return IpcLogLineMessage(logLine);
 }
 
+IpcMetricsMessage IpcServerProxy::parseMetrics()
+{
+    std::string metrics;
+    ProtocolUtil::readf(&m_stream, kIpcMsgMetrics + 4, &metrics);
+    return IpcMetricsMessage(metrics);
+}
+
 void
 IpcServerProxy::disconnect()
 {
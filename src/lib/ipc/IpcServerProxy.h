@@ -26,6 +26,7 @@ namespace inputleap {
 class IStream;
 class IpcMessage;
 class IpcLogLineMessage;
+class IpcMetricsMessage;
 class IEventQueue;
 
 class IpcServerProxy {
@@ -40,6 +41,7 @@ private:
 
     void handle_data();
     IpcLogLineMessage parseLogLine();
+    IpcMetricsMessage parseMetrics();
     void disconnect();
 
 private:
@@ -167,6 +167,10 @@ NetworkAddress::resolve()
 bool
 NetworkAddress::operator==(const NetworkAddress& addr) const
 {
+    // the invalid address has no native address to compare
+    if (m_address == nullptr || addr.m_address == nullptr) {
+        return m_address == addr.m_address;
+    }
     return ARCH->isEqualAddr(m_address, addr.m_address);
 }
 
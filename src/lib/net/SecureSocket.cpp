@@ -255,6 +255,12 @@ SecureSocket::doWrite()
     return kRetry;
 }
 
+std::uint32_t SecureSocket::getPinnedOutputSize() const
+{
+    // a retried write must pass the same data again
+    return do_write_retry_ ? do_write_retry_size_ : 0;
+}
+
 int
 SecureSocket::secureRead(void* buffer, int size, int& read)
 {
@@ -59,6 +59,7 @@ public:
     int secureWrite(const void* buffer, int size, int& wrote);
     EJobResult doRead() override;
     EJobResult doWrite() override;
+    std::uint32_t getPinnedOutputSize() const override;
     void initSsl(bool server);
     bool load_certificates(const inputleap::fs::path& path);
 
@@ -140,6 +140,7 @@ std::uint32_t TCPSocket::read(void* buffer, std::uint32_t n)
         memcpy(buffer, m_inputBuffer.peek(n), n);
     }
     m_inputBuffer.pop(n);
+    bytes_read_ += n;
 
     // if no more data and we cannot read or write then send disconnected
     if (n > 0 && m_inputBuffer.getSize() == 0 && !m_readable && !m_writable) {
@@ -170,6 +171,8 @@ void TCPSocket::write(const void* buffer, std::uint32_t n)
         // copy data to the output buffer
         wasEmpty = (m_outputBuffer.getSize() == 0);
         m_outputBuffer.write(buffer, n);
+        last_write_size_ = n;
+        bytes_written_ += n;
 
         // there's data to write
         is_flushed_ = false;
@@ -181,6 +184,18 @@ void TCPSocket::write(const void* buffer, std::uint32_t n)
     }
 }
 
+bool TCPSocket::replaceLastWrite(const void* last, const void* buffer, std::uint32_t n)
+{
+    std::lock_guard<std::mutex> lock(tcp_mutex_);
+
+    // the last write must still be completely in the output buffer
+    if (!m_writable || n != last_write_size_ ||
+            m_outputBuffer.getSize() < n + getPinnedOutputSize()) {
+        return false;
+    }
+    return m_outputBuffer.replaceTail(last, buffer, n);
+}
+
 void
 TCPSocket::flush()
 {
@@ -263,6 +278,16 @@ std::uint32_t TCPSocket::getSize() const
     return m_inputBuffer.getSize();
 }
 
+StreamCounters TCPSocket::getCounters() const
+{
+    std::lock_guard<std::mutex> lock(tcp_mutex_);
+    StreamCounters counters;
+    counters.m_bytesRead    = bytes_read_;
+    counters.m_bytesWritten = bytes_written_;
+    counters.m_bytesPending = m_outputBuffer.getSize();
+    return counters;
+}
+
 void
 TCPSocket::connect(const NetworkAddress& addr)
 {
@@ -50,12 +50,14 @@ public:
     // IStream overrides
     std::uint32_t read(void* buffer, std::uint32_t n) override;
     void write(const void* buffer, std::uint32_t n) override;
+    bool replaceLastWrite(const void* last, const void* buffer, std::uint32_t n) override;
     void flush() override;
     void shutdownInput() override;
     void shutdownOutput() override;
     bool isReady() const override;
     bool isFatal() const override;
     std::uint32_t getSize() const override;
+    StreamCounters getCounters() const override;
 
     // IDataSocket overrides
     void connect(const NetworkAddress&) override;
@@ -85,6 +87,10 @@ protected:
     void sendEvent(EventType type);
     void discardWrittenData(int bytesWrote);
 
+    // the number of bytes at the start of the output buffer that were
+    // passed on for sending and must not change anymore
+    virtual std::uint32_t getPinnedOutputSize() const { return 0; }
+
 private:
     void init();
 
@@ -110,6 +116,9 @@ private:
     ArchSocket m_socket;
     std::condition_variable flushed_cv_;
     bool is_flushed_ = true;
+    std::uint32_t last_write_size_ = 0;
+    std::uint64_t bytes_read_ = 0;
+    std::uint64_t bytes_written_ = 0;
     SocketMultiplexer* m_socketMultiplexer;
 };
 
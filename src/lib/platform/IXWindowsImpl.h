@@ -12,9 +12,12 @@
 #include <X11/extensions/XTest.h>
 #include <X11/extensions/Xinerama.h>
 #include <X11/extensions/Xrandr.h>
+#include <X11/extensions/Xfixes.h>
 #include <X11/XKBlib.h>
 #include <X11/extensions/XInput2.h>
 
+#include <vector>
+
 namespace inputleap {
 
 class IXWindowsImpl {
@@ -91,6 +94,17 @@ public:
     virtual Bool XRRQueryExtension(Display* display, int* event_base_return,
                                    int* error_base_return) = 0;
     virtual void XRRSelectInput(Display *display, Window window, int mask) = 0;
+    virtual Bool XFixesQueryExtension(Display* display, int* event_base_return,
+                                      int* error_base_return) = 0;
+    virtual void XFixesSelectSelectionInput(Display* display, Window window,
+                                            Atom selection,
+                                            unsigned long event_mask) = 0;
+    virtual XRRScreenResources* XRRGetScreenResourcesCurrent(Display* display,
+                                                             Window window) = 0;
+    virtual void XRRFreeScreenResources(XRRScreenResources* resources) = 0;
+    virtual XRRCrtcInfo* XRRGetCrtcInfo(Display* display, XRRScreenResources* resources,
+                                        RRCrtc crtc) = 0;
+    virtual void XRRFreeCrtcInfo(XRRCrtcInfo* crtcInfo) = 0;
     virtual Bool XineramaQueryExtension(Display* display, int* event_base,
                                         int* error_base) = 0;
     virtual Bool XineramaIsActive(Display* display) = 0;
@@ -115,6 +129,8 @@ public:
     virtual Bool XCheckIfEvent(Display* display, XEvent* event,
                                Bool (*predicate)(Display *, XEvent *, XPointer),
                                XPointer arg) = 0;
+    virtual Bool XCheckTypedEvent(Display* display, int event_type,
+                                  XEvent* event_return) = 0;
     virtual Bool XFilterEvent(XEvent* event, Window window) = 0;
     virtual Bool XGetEventData(Display* display,
                                XGenericEventCookie* cookie) = 0;
@@ -162,11 +178,16 @@ public:
                              Window confine_to, Cursor cursor, Time time) = 0;
     virtual int XUngrabKeyboard(Display* display, Time time) = 0;
     virtual int XPending(Display* display) = 0;
+    virtual int XEventsQueued(Display* display, int mode) = 0;
+    virtual int do_ConnectionNumber(Display* display) = 0;
     virtual int XPeekEvent(Display* display, XEvent* event_return) = 0;
     virtual Status XkbRefreshKeyboardMapping(XkbMapNotifyEvent* event) = 0;
     virtual int XRefreshKeyboardMapping(XMappingEvent* event_map) = 0;
     virtual int XISelectEvents(Display* display, Window w, XIEventMask* masks,
                                int num_masks) = 0;
+    virtual XIDeviceInfo* XIQueryDevice(Display* display, int deviceid,
+                                        int* ndevices_return) = 0;
+    virtual void XIFreeDeviceInfo(XIDeviceInfo* info) = 0;
     virtual Atom XInternAtom(Display* display, _Xconst char* atom_name,
                              Bool only_if_exists) = 0;
     virtual int XGetScreenSaver(Display* display, int* timeout_return,
@@ -193,6 +214,8 @@ public:
     virtual int XQueryKeymap(Display* display, char keys_return[32]) = 0;
     virtual Status	XkbGetUpdatedMap(Display* display, unsigned int which,
                                      XkbDescPtr desc) = 0;
+    virtual Status XkbGetMapChanges(Display* display, XkbDescPtr xkb,
+                                    XkbMapChangesPtr changes) = 0;
     virtual Bool XkbLockGroup(Display* display, unsigned int deviceSpec,
                               unsigned int group) = 0;
     virtual int XDisplayKeycodes(Display* display, int* min_keycodes_return,
@@ -212,6 +235,19 @@ public:
     virtual unsigned char do_XkbKeyGroupInfo(XkbDescPtr m_xkb,
                                              KeyCode keycode) = 0;
     virtual int XNextEvent(Display* display, XEvent* event_return) = 0;
+
+    // Batched requests.  These do XGetWindowAttributes and XQueryTree on
+    // each of count windows.  Implementations may send every request
+    // before waiting for the first reply.  A request that fails, e.g.
+    // because the window was destroyed, leaves a zero status.
+    virtual void do_XGetWindowAttributesBatch(Display* display,
+                                              const Window* windows, int count,
+                                              XWindowAttributes* attrs_return,
+                                              Status* status_return) = 0;
+    virtual void do_XQueryTreeBatch(Display* display, const Window* windows,
+                                    int count,
+                                    std::vector<Window>* children_return,
+                                    Status* status_return) = 0;
 };
 
 } // namespace inputleap
@@ -47,7 +47,10 @@ XWindowsClipboard::XWindowsClipboard(IXWindowsImpl* impl, Display* display,
     m_time(0),
     m_owner(false),
     m_timeOwned(0),
-    m_timeLost(0)
+    m_timeLost(0),
+    m_ownerTracked(false),
+    m_ownerWindow(None),
+    m_ownerTime(0)
 {
     m_impl = impl;
     // get some atoms
@@ -123,6 +126,21 @@ XWindowsClipboard::lost(Time time)
     }
 }
 
+void
+XWindowsClipboard::changed(Window owner, Time time)
+{
+    LOG((CLOG_DEBUG "clipboard %d owner is 0x%08x since %d", m_id, owner, time));
+    m_ownerTracked = true;
+    m_ownerWindow  = owner;
+    m_ownerTime    = time;
+
+    // our own data stays valid when we take the selection.  anyone
+    // else's new data must be read again when it's next wanted.
+    if (owner != m_window) {
+        clearCache();
+    }
+}
+
 void
 XWindowsClipboard::addRequest(Window owner, Window requestor,
                 Atom target, ::Time time, Atom property)
@@ -448,6 +466,14 @@ XWindowsClipboard::checkCache() const
     if (m_motif) {
         m_timeOwned = motifGetTime();
     }
+    else if (m_ownerTracked && m_ownerWindow != m_window) {
+        // changed() already flushed the cache if the owner changed
+        m_timeOwned = m_ownerTime;
+        if (m_cached) {
+            LOG((CLOG_DEBUG1 "clipboard %d owner unchanged, using cache", m_id));
+            return;
+        }
+    }
     else {
         m_timeOwned = icccmGetTime();
     }
@@ -530,6 +556,10 @@ XWindowsClipboard::icccmFillCache()
 
     // try each converter in order (because they're in order of
     // preference).
+    // FIXME -- each target is a separate round trip to the owner.
+    // converting them together (e.g. with MULTIPLE) needs
+    // CICCCMGetClipboard to wait for several replies at once, which is
+    // left for a follow-up to the XCB batching of window queries.
     for (ConverterList::const_iterator index = m_converters.begin();
                                 index != m_converters.end(); ++index) {
         IXWindowsClipboardConverter* converter = *index;
@@ -49,6 +49,15 @@ public:
     */
     void lost(Time);
 
+    //! Notify selection owner changed
+    /*!
+    Tells clipboard that \c owner took the selection at the given time,
+    as reported by XFixes.  Once told, the clipboard uses these reports
+    to decide whether its cache is stale instead of asking the owner
+    for its TIMESTAMP.
+    */
+    void changed(Window owner, Time);
+
     //! Add clipboard request
     /*!
     Adds a selection request to the request list.  If the given
@@ -121,6 +130,8 @@ private:
 
     // if not already checked then see if the cache is stale and, if so,
     // clear it.  this has the side effect of updating m_timeOwned.
+    // if the owner is tracked and it hasn't changed since the cache was
+    // filled then the cache is kept without asking the owner anything.
     void checkCache() const;
 
     // clear the cache, resetting the cached flag and the added flag for
@@ -295,6 +306,12 @@ private:
     mutable Time m_timeOwned;
     Time m_timeLost;
 
+    // selection owner and the time it took the selection, as reported
+    // by XFixes.  m_ownerTracked is false until the first report.
+    bool m_ownerTracked;
+    Window m_ownerWindow;
+    Time m_ownerTime;
+
     // true iff open and clipboard owned by a motif app
     mutable bool m_motif;
 
@@ -21,7 +21,10 @@
 #include "mt/Thread.h"
 #include "base/Event.h"
 #include "base/IEventQueue.h"
+#include "base/Stopwatch.h"
 
+#include <cerrno>
+#include <cmath>
 #include <fcntl.h>
 #include <unistd.h>
 #include <poll.h>
@@ -65,17 +68,32 @@ XWindowsEventQueueBuffer::~XWindowsEventQueueBuffer()
     close(m_pipefd[1]);
 }
 
-int XWindowsEventQueueBuffer::getPendingCountLocked()
+int XWindowsEventQueueBuffer::get_queued_count()
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    // work around a bug in old libx11 which causes the first XPending not to read events under
+    // QueuedAfterFlush flushes the output buffer, reads whatever is readable on the connection
+    // without blocking and returns the length of Xlib's event queue.
+    //
+    // work around a bug in old libx11 which causes the first call not to process events under
     // certain conditions. The issue happens when libx11 has not yet received replies for all
-    // flushed events. In that case, internally XPending will not try to process received events
-    // as the reply for the last event was not found. As a result, XPending will return the number
-    // of pending events without regard to the events it has just read.
+    // flushed events. In that case, internally XEventsQueued will not try to process received
+    // events as the reply for the last event was not found. As a result, it will return the
+    // number of pending events without regard to the events it has just read. Since the data
+    // has already been consumed from the socket, poll() would not wake up for it, so ask again.
     // https://gitlab.freedesktop.org/xorg/lib/libx11/-/merge_requests/1 fixes this on libx11 side.
-    m_impl->XPending(m_display);
-    return m_impl->XPending(m_display);
+    int count = m_impl->XEventsQueued(m_display, QueuedAfterFlush);
+    if (count == 0) {
+        count = m_impl->XEventsQueued(m_display, QueuedAfterFlush);
+    }
+    return count;
+}
+
+void XWindowsEventQueueBuffer::drain_wakeup_pipe()
+{
+    char buf[16];
+    while (read(m_pipefd[0], buf, sizeof(buf)) > 0) {
+        // discard
+    }
 }
 
 void
@@ -84,13 +102,7 @@ XWindowsEventQueueBuffer::waitForEvent(double dtimeout)
     Thread::testCancel();
 
     // clear out the pipe in preparation for waiting.
-
-    char buf[16];
-    ssize_t read_response = read(m_pipefd[0], buf, 15);
-    if (read_response < 0)
-    {
-        // todo: handle read response
-    }
+    drain_wakeup_pipe();
 
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -100,46 +112,47 @@ XWindowsEventQueueBuffer::waitForEvent(double dtimeout)
         // push out pending events
         flush();
     }
-    // calling flush may have queued up a new event.
-    if (!XWindowsEventQueueBuffer::isEmpty()) {
-        Thread::testCancel();
-        return;
-    }
 
-    // use poll() to wait for a message from the X server or for timeout.
-    // this is a good deal more efficient than polling and sleeping.
+    // Xlib may read events into its internal queue while doing unrelated work (flushing,
+    // waiting for replies), so an event can be pending without the connection fd being
+    // readable.  Drain that queue before every sleep and then block in poll() until the X
+    // connection or the wakeup pipe becomes readable or the deadline passes.  The timeout
+    // passed by EventQueue already accounts for the next timer, so there is no need to wake
+    // up periodically.
     struct pollfd pfds[2];
-    pfds[0].fd     = ConnectionNumber(m_display);
+    pfds[0].fd     = m_impl->do_ConnectionNumber(m_display);
     pfds[0].events = POLLIN;
     pfds[1].fd     = m_pipefd[0];
     pfds[1].events = POLLIN;
-    int timeout    = (dtimeout < 0.0) ? -1 :
-                        static_cast<int>(1000.0 * dtimeout);
-    int remaining  =  timeout;
-    int retval     =  0;
-    // It's possible that the X server has queued events locally
-    // in xlib's event buffer and not pushed on to the fd. Hence we
-    // can't simply monitor the fd as we may never be woken up.
-    // ie addEvent calls flush, XFlush may not send via the fd hence
-    // there is an event waiting to be sent but we must exit the poll
-    // before it can.
-    // Instead we poll for a brief period of time (so if events
-    // queued locally in the xlib buffer can be processed)
-    // and continue doing this until timeout is reached.
-    // The human eye can notice 60hz (ansi) which is 16ms, however
-    // we want to give the cpu a chance s owe up this to 25ms
-#define TIMEOUT_DELAY 25
-
-    while (((dtimeout < 0.0) || (remaining > 0)) && getPendingCountLocked() == 0 && retval == 0) {
-        retval = poll(pfds, 2, TIMEOUT_DELAY); //16ms = 60hz, but we make it > to play nicely with the cpu
-        if (pfds[1].revents & POLLIN) {
-            read_response = read(m_pipefd[0], buf, 15);
-            if (read_response < 0)
-            {
-                // todo: handle read response
+
+    Stopwatch timer(false);
+    while (get_queued_count() == 0) {
+        int timeout = -1;
+        if (dtimeout >= 0.0) {
+            double remaining = dtimeout - timer.getTime();
+            if (remaining <= 0.0) {
+                break;
             }
+            // round up so that we never wake up just before the deadline
+            timeout = static_cast<int>(std::ceil(1000.0 * remaining));
+        }
+
+        int retval = poll(pfds, 2, timeout);
+        if (retval == 0) {
+            break;
+        }
+        if (retval < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        // addEvent() has sent a user event.  The flush it did may have pulled incoming events
+        // into Xlib's queue behind our back; the next get_queued_count() call will see them.
+        if ((pfds[1].revents & POLLIN) != 0) {
+            drain_wakeup_pipe();
         }
-        remaining-=TIMEOUT_DELAY;
     }
 
     {
@@ -50,7 +50,11 @@ public:
 private:
     void flush();
 
-    int getPendingCountLocked();
+    // returns the number of events in Xlib's queue after reading anything available on the
+    // connection.  Locks mutex_.
+    int get_queued_count();
+
+    void drain_wakeup_pipe();
 
 private:
     typedef std::vector<XEvent> EventList;
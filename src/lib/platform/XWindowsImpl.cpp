@@ -252,6 +252,40 @@ void XWindowsImpl::XRRSelectInput(Display *display, Window window, int mask)
     ::XRRSelectInput(display, window, mask);
 }
 
+Bool XWindowsImpl::XFixesQueryExtension(Display* display, int* event_base_return,
+                                        int* error_base_return)
+{
+    return ::XFixesQueryExtension(display, event_base_return, error_base_return);
+}
+
+void XWindowsImpl::XFixesSelectSelectionInput(Display* display, Window window,
+                                              Atom selection,
+                                              unsigned long event_mask)
+{
+    ::XFixesSelectSelectionInput(display, window, selection, event_mask);
+}
+
+XRRScreenResources* XWindowsImpl::XRRGetScreenResourcesCurrent(Display* display, Window window)
+{
+    return ::XRRGetScreenResourcesCurrent(display, window);
+}
+
+void XWindowsImpl::XRRFreeScreenResources(XRRScreenResources* resources)
+{
+    ::XRRFreeScreenResources(resources);
+}
+
+XRRCrtcInfo* XWindowsImpl::XRRGetCrtcInfo(Display* display, XRRScreenResources* resources,
+                                          RRCrtc crtc)
+{
+    return ::XRRGetCrtcInfo(display, resources, crtc);
+}
+
+void XWindowsImpl::XRRFreeCrtcInfo(XRRCrtcInfo* crtcInfo)
+{
+    ::XRRFreeCrtcInfo(crtcInfo);
+}
+
 Bool XWindowsImpl::XineramaQueryExtension(Display* display, int* event_base,
                                           int* error_base)
 {
@@ -321,6 +355,12 @@ Bool XWindowsImpl::XCheckIfEvent(Display* display, XEvent* event,
     return ::XCheckIfEvent(display, event, predicate, arg);
 }
 
+Bool XWindowsImpl::XCheckTypedEvent(Display* display, int event_type,
+                                    XEvent* event_return)
+{
+    return ::XCheckTypedEvent(display, event_type, event_return);
+}
+
 Bool XWindowsImpl::XFilterEvent(XEvent* event, Window window)
 {
     return ::XFilterEvent(event, window);
@@ -455,6 +495,16 @@ int XWindowsImpl::XPending(Display* display)
     return ::XPending(display);
 }
 
+int XWindowsImpl::XEventsQueued(Display* display, int mode)
+{
+    return ::XEventsQueued(display, mode);
+}
+
+int XWindowsImpl::do_ConnectionNumber(Display* display)
+{
+    return ConnectionNumber(display);
+}
+
 int XWindowsImpl::XPeekEvent(Display* display, XEvent* event_return)
 {
     return ::XPeekEvent(display, event_return);
@@ -476,6 +526,17 @@ int XWindowsImpl::XISelectEvents(Display* display, Window w, XIEventMask* masks,
     return ::XISelectEvents(display, w, masks, num_masks);
 }
 
+XIDeviceInfo* XWindowsImpl::XIQueryDevice(Display* display, int deviceid,
+                                          int* ndevices_return)
+{
+    return ::XIQueryDevice(display, deviceid, ndevices_return);
+}
+
+void XWindowsImpl::XIFreeDeviceInfo(XIDeviceInfo* info)
+{
+    ::XIFreeDeviceInfo(info);
+}
+
 Atom XWindowsImpl::XInternAtom(Display* display, _Xconst char* atom_name,
                                Bool only_if_exists)
 {
@@ -569,6 +630,12 @@ Status XWindowsImpl::XkbGetUpdatedMap(Display* display, unsigned int which,
     return ::XkbGetUpdatedMap(display, which, desc);
 }
 
+Status XWindowsImpl::XkbGetMapChanges(Display* display, XkbDescPtr xkb,
+                                      XkbMapChangesPtr changes)
+{
+    return ::XkbGetMapChanges(display, xkb, changes);
+}
+
 Bool XWindowsImpl::XkbLockGroup(Display* display, unsigned int deviceSpec,
                                 unsigned int group)
 {
@@ -631,4 +698,34 @@ int XWindowsImpl::XNextEvent(Display* display, XEvent* event_return)
     return ::XNextEvent(display, event_return);
 }
 
+void XWindowsImpl::do_XGetWindowAttributesBatch(Display* display,
+                                                const Window* windows, int count,
+                                                XWindowAttributes* attrs_return,
+                                                Status* status_return)
+{
+    // Xlib waits for each reply in turn
+    for (int i = 0; i < count; ++i) {
+        status_return[i] = XGetWindowAttributes(display, windows[i],
+                                                &attrs_return[i]);
+    }
+}
+
+void XWindowsImpl::do_XQueryTreeBatch(Display* display, const Window* windows,
+                                      int count,
+                                      std::vector<Window>* children_return,
+                                      Status* status_return)
+{
+    for (int i = 0; i < count; ++i) {
+        Window root, parent, *children;
+        unsigned int nchildren;
+        children_return[i].clear();
+        status_return[i] = XQueryTree(display, windows[i], &root, &parent,
+                                      &children, &nchildren);
+        if (status_return[i] != 0) {
+            children_return[i].assign(children, children + nchildren);
+            XFree(children);
+        }
+    }
+}
+
 } // namespace inputleap
@@ -64,6 +64,15 @@ public:
     Bool XRRQueryExtension(Display* display, int* event_base_return,
                            int* error_base_return) override;
     void XRRSelectInput(Display *display, Window window, int mask) override;
+    Bool XFixesQueryExtension(Display* display, int* event_base_return,
+                              int* error_base_return) override;
+    void XFixesSelectSelectionInput(Display* display, Window window, Atom selection,
+                                    unsigned long event_mask) override;
+    XRRScreenResources* XRRGetScreenResourcesCurrent(Display* display, Window window) override;
+    void XRRFreeScreenResources(XRRScreenResources* resources) override;
+    XRRCrtcInfo* XRRGetCrtcInfo(Display* display, XRRScreenResources* resources,
+                                RRCrtc crtc) override;
+    void XRRFreeCrtcInfo(XRRCrtcInfo* crtcInfo) override;
     Bool XineramaQueryExtension(Display* display, int* event_base, int* error_base) override;
     Bool XineramaIsActive(Display* display) override;
     void* XineramaQueryScreens(Display* display, int* number) override;
@@ -80,6 +89,8 @@ public:
     int XSelectInput(Display* display, Window w, long event_mask) override;
     Bool XCheckIfEvent(Display* display, XEvent* event,
                        Bool (*predicate)(Display *, XEvent *, XPointer), XPointer arg) override;
+    Bool XCheckTypedEvent(Display* display, int event_type,
+                          XEvent* event_return) override;
     Bool XFilterEvent(XEvent* event, Window window) override;
     Bool XGetEventData(Display* display, XGenericEventCookie* cookie) override;
     void XFreeEventData(Display* display, XGenericEventCookie* cookie) override;
@@ -111,10 +122,14 @@ public:
                      Window confine_to, Cursor cursor, Time time) override;
     int XUngrabKeyboard(Display* display, Time time) override;
     int XPending(Display* display) override;
+    int XEventsQueued(Display* display, int mode) override;
+    int do_ConnectionNumber(Display* display) override;
     int XPeekEvent(Display* display, XEvent* event_return) override;
     Status XkbRefreshKeyboardMapping(XkbMapNotifyEvent* event) override;
     int XRefreshKeyboardMapping(XMappingEvent* event_map) override;
     int XISelectEvents(Display* display, Window w, XIEventMask* masks, int num_masks) override;
+    XIDeviceInfo* XIQueryDevice(Display* display, int deviceid, int* ndevices_return) override;
+    void XIFreeDeviceInfo(XIDeviceInfo* info) override;
     Atom XInternAtom(Display* display, _Xconst char* atom_name, Bool only_if_exists) override;
     int XGetScreenSaver(Display* display, int* timeout_return, int*  interval_return,
                         int* prefer_blanking_return, int* allow_exposures_return) override;
@@ -133,6 +148,7 @@ public:
     Status XkbGetState(Display* display, unsigned int deviceSet, XkbStatePtr rtrnState) override;
     int XQueryKeymap(Display* display, char keys_return[32]) override;
     Status XkbGetUpdatedMap(Display* display, unsigned int which, XkbDescPtr desc) override;
+    Status XkbGetMapChanges(Display* display, XkbDescPtr xkb, XkbMapChangesPtr changes) override;
     Bool XkbLockGroup(Display* display, unsigned int deviceSpec, unsigned int group) override;
     int XDisplayKeycodes(Display* display, int* min_keycodes_return,
                          int* max_keycodes_return) override;
@@ -146,6 +162,12 @@ public:
                                     int eGroup) override;
     unsigned char do_XkbKeyGroupInfo(XkbDescPtr m_xkb, KeyCode keycode) override;
     int XNextEvent(Display* display, XEvent* event_return) override;
+    void do_XGetWindowAttributesBatch(Display* display, const Window* windows,
+                                      int count, XWindowAttributes* attrs_return,
+                                      Status* status_return) override;
+    void do_XQueryTreeBatch(Display* display, const Window* windows, int count,
+                            std::vector<Window>* children_return,
+                            Status* status_return) override;
 };
 
 } // namespace inputleap
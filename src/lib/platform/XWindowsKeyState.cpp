@@ -30,12 +30,30 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <map>
+#include <utility>
 
 namespace inputleap {
 
 static const size_t ModifiersFromXDefaultSize = 32;
 
+// the parts of the XKB keyboard map we use
+static const unsigned int XKBMapMask = XkbKeyActionsMask | XkbKeyBehaviorsMask |
+                                       XkbAllClientInfoMask;
+
+// the number of recently used layouts to remember
+static const size_t MaxXKBLayouts = 4;
+
+static const std::uint64_t XKBHashSeed = 0xcbf29ce484222325ull;
+
+static void hashXKBValue(std::uint64_t& hash, std::uint64_t value)
+{
+    hash ^= value;
+    hash *= 0x100000001b3ull;
+    hash ^= hash >> 32;
+}
+
 XWindowsKeyState::XWindowsKeyState(IXWindowsImpl* impl,
         Display* display, bool useXKB,
         IEventQueue* events) :
@@ -72,11 +90,9 @@ XWindowsKeyState::init(Display* display, bool useXKB)
     (void) display;
     (void) useXKB;
 
-    XGetKeyboardControl(m_display, &m_keyboardState);
+    m_impl->XGetKeyboardControl(m_display, &m_keyboardState);
     if (useXKB) {
-        m_xkb = m_impl->XkbGetMap(m_display,
-                                  XkbKeyActionsMask | XkbKeyBehaviorsMask |
-                                  XkbAllClientInfoMask, XkbUseCoreKbd);
+        m_xkb = m_impl->XkbGetMap(m_display, XKBMapMask, XkbUseCoreKbd);
     }
     else {
         m_xkb = nullptr;
@@ -107,6 +123,31 @@ XWindowsKeyState::setAutoRepeat(const XKeyboardState& state)
     m_keyboardState = state;
 }
 
+void XWindowsKeyState::setFlushDeferred(bool deferred)
+{
+    m_flushDeferred = deferred;
+}
+
+void XWindowsKeyState::noteKeyMapChanges(const XkbMapNotifyEvent& event)
+{
+    if (m_xkb == nullptr) {
+        return;
+    }
+
+    // a new keycode range invalidates everything we know about keycodes
+    if (event.min_key_code != m_xkb->min_key_code ||
+        event.max_key_code != m_xkb->max_key_code) {
+        m_xkbKeycodes.clear();
+    }
+
+    if (!m_xkbChangesPending) {
+        std::memset(&m_xkbChanges, 0, sizeof(m_xkbChanges));
+        m_xkbChangesPending = true;
+    }
+    XkbNoteMapChanges(&m_xkbChanges, const_cast<XkbMapNotifyEvent*>(&event),
+                      XKBMapMask);
+}
+
 KeyModifierMask
 XWindowsKeyState::mapModifiersFromX(unsigned int state) const
 {
@@ -219,16 +260,27 @@ XWindowsKeyState::getKeyMap(inputleap::KeyMap& keyMap)
     // get autorepeat info.  we must use the global_auto_repeat told to
     // us because it may have modified by InputLeap.
     int oldGlobalAutoRepeat = m_keyboardState.global_auto_repeat;
-    XGetKeyboardControl(m_display, &m_keyboardState);
+    m_impl->XGetKeyboardControl(m_display, &m_keyboardState);
     m_keyboardState.global_auto_repeat = oldGlobalAutoRepeat;
 
     if (m_xkb != nullptr) {
-        unsigned mask = XkbKeyActionsMask | XkbKeyBehaviorsMask |
-                        XkbAllClientInfoMask;
-        if (m_impl->XkbGetUpdatedMap(m_display, mask, m_xkb) == Success) {
-            updateKeysymMapXKB(keyMap);
+        int firstKeycode = m_xkb->min_key_code;
+        int lastKeycode  = m_xkb->max_key_code;
+        Status status;
+        if (canGetMapChangesXKB()) {
+            // fetch only what changed
+            getChangedKeycodesXKB(firstKeycode, lastKeycode);
+            status = m_impl->XkbGetMapChanges(m_display, m_xkb, &m_xkbChanges);
+        }
+        else {
+            status = m_impl->XkbGetUpdatedMap(m_display, XKBMapMask, m_xkb);
+        }
+        m_xkbChangesPending = false;
+        if (status == Success) {
+            updateKeysymMapXKB(keyMap, firstKeycode, lastKeycode);
             return;
         }
+        m_xkbKeycodes.clear();
     }
     updateKeysymMap(keyMap);
 }
@@ -288,7 +340,9 @@ XWindowsKeyState::fakeKey(const Keystroke& keystroke)
         default:
             break;
     }
-    XFlush(m_display);
+    if (!m_flushDeferred) {
+        m_impl->XFlush(m_display);
+    }
 }
 
 void
@@ -537,20 +591,9 @@ XWindowsKeyState::updateKeysymMap(inputleap::KeyMap& keyMap)
 }
 
 void
-XWindowsKeyState::updateKeysymMapXKB(inputleap::KeyMap& keyMap)
+XWindowsKeyState::updateKeysymMapXKB(inputleap::KeyMap& keyMap,
+                                     int firstKeycode, int lastKeycode)
 {
-    static const XkbKTMapEntryRec defMapEntry = {
-        True,        // active
-        0,            // level
-        {
-            0,        // mods.mask
-            0,        // mods.real_mods
-            0        // mods.vmods
-        }
-    };
-
-    LOG((CLOG_DEBUG1 "XKB mapping"));
-
     // find the number of groups
     int maxNumGroups = 0;
     for (int i = m_xkb->min_key_code; i <= m_xkb->max_key_code; ++i) {
@@ -560,15 +603,6 @@ XWindowsKeyState::updateKeysymMapXKB(inputleap::KeyMap& keyMap)
         }
     }
 
-    // prepare map from X modifier to KeyModifierMask
-    std::vector<int> modifierLevel(maxNumGroups * 8, 4);
-    m_modifierFromX.clear();
-    m_modifierFromX.resize(maxNumGroups * 8);
-    m_modifierToX.clear();
-
-    // prepare map from KeyID to KeyCode
-    m_keyCodeFromKey.clear();
-
     // Hack to deal with VMware.  When a VMware client grabs input the
     // player clears out the X modifier map for whatever reason.  We're
     // notified of the change and arrive here to discover that there
@@ -577,204 +611,434 @@ XWindowsKeyState::updateKeysymMapXKB(inputleap::KeyMap& keyMap)
     // of modifiers when there are no modifiers.  If there are modifiers
     // we update the last known good set.
     bool useLastGoodModifiers = !hasModifiersXKB();
-    if (!useLastGoodModifiers) {
-        m_lastGoodXKBModifiers.clear();
+
+    // what we know about each keycode depends on the number of groups
+    // and on the modifier hack so rebuild everything if either changed
+    if (m_xkbKeycodes.size() != 256 ||
+        maxNumGroups != m_xkbNumGroups ||
+        useLastGoodModifiers != m_xkbUsedLastGoodModifiers) {
+        m_xkbKeycodes.assign(256, nullptr);
+        m_xkbKeycodeHashes.assign(256, 0);
+        m_xkbNumGroups             = maxNumGroups;
+        m_xkbUsedLastGoodModifiers = useLastGoodModifiers;
+        firstKeycode = m_xkb->min_key_code;
+        lastKeycode  = m_xkb->max_key_code;
+        if (!useLastGoodModifiers) {
+            m_lastGoodXKBModifiers.clear();
+        }
+    }
+
+    bool wholeMap = (firstKeycode == m_xkb->min_key_code &&
+                     lastKeycode  == m_xkb->max_key_code);
+
+    // find the keycodes whose XKB data changed
+    std::vector<KeyCode> changed;
+    for (int i = firstKeycode; i <= lastKeycode; ++i) {
+        KeyCode keycode = static_cast<KeyCode>(i);
+        std::uint64_t hash = hashKeycodeXKB(keycode, maxNumGroups);
+        if (!m_xkbKeycodes[keycode] || m_xkbKeycodeHashes[keycode] != hash) {
+            m_xkbKeycodes[keycode].reset();
+            m_xkbKeycodeHashes[keycode] = hash;
+            changed.push_back(keycode);
+        }
     }
 
-    // check every button.  on this pass we save all modifiers as native
+    // use the key map we built the last time we saw this layout.  the
+    // last known good modifiers come from whatever layout was used
+    // before so we don't remember layouts built with them.
+    std::uint64_t fingerprint = XKBHashSeed;
+    hashXKBValue(fingerprint, static_cast<std::uint64_t>(maxNumGroups));
+    for (int i = m_xkb->min_key_code; i <= m_xkb->max_key_code; ++i) {
+        hashXKBValue(fingerprint, m_xkbKeycodeHashes[i]);
+    }
+    if (!useLastGoodModifiers && findLayoutXKB(fingerprint, keyMap)) {
+        LOG((CLOG_DEBUG1 "XKB mapping: using recent layout"));
+        return;
+    }
+    LOG((CLOG_DEBUG1 "XKB mapping: %d keycodes changed",
+         static_cast<int>(changed.size())));
+
+    // rebuild the changed keycodes
+    for (KeyCode keycode : changed) {
+        if (!useLastGoodModifiers) {
+            for (int group = 0; group < XkbNumKbdGroups; ++group) {
+                m_lastGoodXKBModifiers.erase(group * 256 + keycode);
+            }
+        }
+        auto info = std::make_shared<XKBKeycode>();
+        buildKeycodeXKB(keycode, maxNumGroups, useLastGoodModifiers, *info);
+        m_xkbKeycodes[keycode] = std::move(info);
+    }
+
+    // prepare map from X modifier to KeyModifierMask
+    std::vector<int> modifierLevel(maxNumGroups * 8, 4);
+    m_modifierFromX.clear();
+    m_modifierFromX.resize(maxNumGroups * 8);
+    m_modifierToX.clear();
+
+    // prepare map from KeyID to KeyCode
+    m_keyCodeFromKey.clear();
+
+    // add every button.  on this pass we save all modifiers as native
     // X modifier masks.
-    inputleap::KeyMap::KeyItem item;
     for (int i = m_xkb->min_key_code; i <= m_xkb->max_key_code; ++i) {
         KeyCode keycode = static_cast<KeyCode>(i);
-        item.m_button   = static_cast<KeyButton>(keycode);
-        item.m_client   = 0;
+        addKeycodeXKB(keyMap, keycode, *m_xkbKeycodes[keycode], modifierLevel);
+    }
 
-        // skip keys with no groups (they generate no symbols)
-        if (m_impl->do_XkbKeyNumGroups(m_xkb, keycode) == 0) {
-            continue;
-        }
+    // change all modifier masks to InputLeap masks from X masks
+    keyMap.foreachKey(&XWindowsKeyState::remapKeyModifiers, this);
+
+    // allow composition across groups
+    keyMap.allowGroupSwitchDuringCompose();
+
+    // remember the layout.  switching layouts updates the whole map so
+    // there's no point remembering maps with just a few keys changed.
+    if (!useLastGoodModifiers && wholeMap) {
+        saveLayoutXKB(fingerprint, keyMap);
+    }
+}
 
-        // note half-duplex keys
-        const XkbBehavior& b = m_xkb->server->behaviors[keycode];
-        if ((b.type & XkbKB_OpMask) == XkbKB_Lock) {
-            keyMap.addHalfDuplexButton(item.m_button);
+void XWindowsKeyState::buildKeycodeXKB(KeyCode keycode, int maxNumGroups,
+                                       bool useLastGoodModifiers,
+                                       XKBKeycode& info)
+{
+    static const XkbKTMapEntryRec defMapEntry = {
+        True,        // active
+        0,            // level
+        {
+            0,        // mods.mask
+            0,        // mods.real_mods
+            0        // mods.vmods
         }
+    };
 
-        // iterate over all groups
-        for (int group = 0; group < maxNumGroups; ++group) {
-            item.m_group = group;
-            int eGroup   = getEffectiveGroup(keycode, group);
+    XKBKeycodeStep step{};
+    inputleap::KeyMap::KeyItem& item = step.m_item;
+    item.m_button = static_cast<KeyButton>(keycode);
+    item.m_client = 0;
 
-            // get key info
-            XkbKeyTypePtr type = m_impl->do_XkbKeyKeyType(m_xkb, keycode,
-                                                          eGroup);
+    // skip keys with no groups (they generate no symbols)
+    if (m_impl->do_XkbKeyNumGroups(m_xkb, keycode) == 0) {
+        return;
+    }
 
-            // set modifiers the item is sensitive to
-            item.m_sensitive = type->mods.mask;
+    // note half-duplex keys
+    const XkbBehavior& b = m_xkb->server->behaviors[keycode];
+    if ((b.type & XkbKB_OpMask) == XkbKB_Lock) {
+        info.m_halfDuplex = true;
+    }
 
-            // iterate over all shift levels for the button (including none)
-            for (int j = -1; j < type->map_count; ++j) {
-                const XkbKTMapEntryRec* mapEntry =
-                    ((j == -1) ? &defMapEntry : type->map + j);
-                if (!mapEntry->active) {
-                    continue;
-                }
-                int level = mapEntry->level;
-
-                // set required modifiers for this item
-                item.m_required = mapEntry->mods.mask;
-                if ((item.m_required & LockMask) != 0 &&
-                    j != -1 && type->preserve != nullptr &&
-                    (type->preserve[j].mask & LockMask) != 0) {
-                    // sensitive caps lock and we preserve caps-lock.
-                    // preserving caps-lock means we Xlib functions would
-                    // yield the capitialized KeySym so we'll adjust the
-                    // level accordingly.
-                    if ((level ^ 1) < type->num_levels) {
-                        level ^= 1;
-                    }
-                }
+    // iterate over all groups
+    for (int group = 0; group < maxNumGroups; ++group) {
+        item.m_group = group;
+        int eGroup   = getEffectiveGroup(keycode, group);
 
-                // get the keysym for this item
-                KeySym keysym = m_impl->do_XkbKeySymEntry(m_xkb, keycode, level,
-                                                          eGroup);
+        // get key info
+        XkbKeyTypePtr type = m_impl->do_XkbKeyKeyType(m_xkb, keycode, eGroup);
 
-                // check for group change actions, locking modifiers, and
-                // modifier masks.
-                item.m_lock         = false;
-                bool isModifier     = false;
-                std::uint32_t modifierMask = m_xkb->map->modmap[keycode];
-                if (m_impl->do_XkbKeyHasActions(m_xkb, keycode) == True) {
-                    XkbAction* action =
-                        m_impl->do_XkbKeyActionEntry(m_xkb, keycode, level,
-                                                     eGroup);
-                    if (action->type == XkbSA_SetMods ||
-                        action->type == XkbSA_LockMods) {
-                        isModifier  = true;
+        // set modifiers the item is sensitive to
+        item.m_sensitive = type->mods.mask;
 
-                        // note toggles
-                        item.m_lock = (action->type == XkbSA_LockMods);
+        // iterate over all shift levels for the button (including none)
+        for (int j = -1; j < type->map_count; ++j) {
+            const XkbKTMapEntryRec* mapEntry =
+                ((j == -1) ? &defMapEntry : type->map + j);
+            if (!mapEntry->active) {
+                continue;
+            }
+            int level = mapEntry->level;
+
+            // set required modifiers for this item
+            item.m_required = mapEntry->mods.mask;
+            if ((item.m_required & LockMask) != 0 &&
+                j != -1 && type->preserve != nullptr &&
+                (type->preserve[j].mask & LockMask) != 0) {
+                // sensitive caps lock and we preserve caps-lock.
+                // preserving caps-lock means we Xlib functions would
+                // yield the capitialized KeySym so we'll adjust the
+                // level accordingly.
+                if ((level ^ 1) < type->num_levels) {
+                    level ^= 1;
+                }
+            }
 
-                        // maybe use action's mask
-                        if ((action->mods.flags & XkbSA_UseModMapMods) == 0) {
-                            modifierMask = action->mods.mask;
-                        }
-                    }
-                    else if (action->type == XkbSA_SetGroup ||
-                            action->type == XkbSA_LatchGroup ||
-                            action->type == XkbSA_LockGroup) {
-                        // ignore group change key
-                        continue;
+            // get the keysym for this item
+            KeySym keysym = m_impl->do_XkbKeySymEntry(m_xkb, keycode, level,
+                                                      eGroup);
+
+            // check for group change actions, locking modifiers, and
+            // modifier masks.
+            item.m_lock         = false;
+            bool isModifier     = false;
+            std::uint32_t modifierMask = m_xkb->map->modmap[keycode];
+            if (m_impl->do_XkbKeyHasActions(m_xkb, keycode) == True) {
+                XkbAction* action =
+                    m_impl->do_XkbKeyActionEntry(m_xkb, keycode, level,
+                                                 eGroup);
+                if (action->type == XkbSA_SetMods ||
+                    action->type == XkbSA_LockMods) {
+                    isModifier  = true;
+
+                    // note toggles
+                    item.m_lock = (action->type == XkbSA_LockMods);
+
+                    // maybe use action's mask
+                    if ((action->mods.flags & XkbSA_UseModMapMods) == 0) {
+                        modifierMask = action->mods.mask;
                     }
                 }
-                level = mapEntry->level;
-
-                // VMware modifier hack
-                if (useLastGoodModifiers) {
-                    XKBModifierMap::const_iterator k =
-                        m_lastGoodXKBModifiers.find(eGroup * 256 + keycode);
-                    if (k != m_lastGoodXKBModifiers.end()) {
-                        // Use last known good modifier
-                        isModifier   = true;
-                        level        = k->second.m_level;
-                        modifierMask = k->second.m_mask;
-                        item.m_lock  = k->second.m_lock;
-                    }
+                else if (action->type == XkbSA_SetGroup ||
+                        action->type == XkbSA_LatchGroup ||
+                        action->type == XkbSA_LockGroup) {
+                    // ignore group change key
+                    continue;
                 }
-                else if (isModifier) {
-                    // Save known good modifier
-                    XKBModifierInfo& info =
-                        m_lastGoodXKBModifiers[eGroup * 256 + keycode];
-                    info.m_level = level;
-                    info.m_mask  = modifierMask;
-                    info.m_lock  = item.m_lock;
+            }
+            level = mapEntry->level;
+
+            // VMware modifier hack
+            if (useLastGoodModifiers) {
+                XKBModifierMap::const_iterator k =
+                    m_lastGoodXKBModifiers.find(eGroup * 256 + keycode);
+                if (k != m_lastGoodXKBModifiers.end()) {
+                    // Use last known good modifier
+                    isModifier   = true;
+                    level        = k->second.m_level;
+                    modifierMask = k->second.m_mask;
+                    item.m_lock  = k->second.m_lock;
                 }
+            }
+            else if (isModifier) {
+                // Save known good modifier
+                XKBModifierInfo& modifierInfo =
+                    m_lastGoodXKBModifiers[eGroup * 256 + keycode];
+                modifierInfo.m_level = level;
+                modifierInfo.m_mask  = modifierMask;
+                modifierInfo.m_lock  = item.m_lock;
+            }
+
+            // note the modifier mask for this key.  don't bother
+            // for keys that change the group.
+            item.m_generates = 0;
+            std::uint32_t modifierBit =
+                XWindowsUtil::getModifierBitForKeySym(keysym);
+            if (isModifier && modifierBit != kKeyModifierBitNone) {
+                item.m_generates    = (1u << modifierBit);
+                step.m_addEntry     = false;
+                step.m_mapKeyCode   = false;
+                step.m_modifierBit  = modifierBit;
+                step.m_modifierMask = modifierMask;
+                step.m_level        = level;
+                info.m_steps.push_back(step);
+            }
+            step.m_addEntry    = true;
+            step.m_modifierBit = kKeyModifierBitNone;
 
-                // record the modifier mask for this key.  don't bother
-                // for keys that change the group.
-                item.m_generates = 0;
-                std::uint32_t modifierBit =
-                    XWindowsUtil::getModifierBitForKeySym(keysym);
-                if (isModifier && modifierBit != kKeyModifierBitNone) {
-                    item.m_generates = (1u << modifierBit);
-                    for (std::int32_t k = 0; k < 8; ++k) {
-                        // skip modifiers this key doesn't generate
-                        if ((modifierMask & (1u << k)) == 0) {
-                            continue;
-                        }
-
-                        // skip keys that map to a modifier that we've
-                        // already seen using fewer modifiers.  that is
-                        // if this key must combine with other modifiers
-                        // and we know of a key that combines with fewer
-                        // modifiers (or no modifiers) then prefer the
-                        // other key.
-                        if (level >= modifierLevel[8 * group + k]) {
-                            continue;
-                        }
-                        modifierLevel[8 * group + k] = level;
-
-                        // save modifier
-                        m_modifierFromX[8 * group + k] |= (1u << modifierBit);
-                        m_modifierToX.insert(std::make_pair(
-                                1u << modifierBit, 1u << k));
+            // handle special cases of just one keysym for the keycode
+            if (type->num_levels == 1) {
+                // if there are upper- and lowercase versions of the
+                // keysym then add both.
+                KeySym lKeysym, uKeysym;
+                XConvertCase(keysym, &lKeysym, &uKeysym);
+                if (lKeysym != uKeysym) {
+                    if (j != -1) {
+                        continue;
                     }
-                }
 
-                // handle special cases of just one keysym for the keycode
-                if (type->num_levels == 1) {
-                    // if there are upper- and lowercase versions of the
-                    // keysym then add both.
-                    KeySym lKeysym, uKeysym;
-                    XConvertCase(keysym, &lKeysym, &uKeysym);
-                    if (lKeysym != uKeysym) {
-                        if (j != -1) {
-                            continue;
-                        }
-
-                        item.m_sensitive |= ShiftMask | LockMask;
-
-                        KeyID lKeyID = XWindowsUtil::mapKeySymToKeyID(lKeysym);
-                        KeyID uKeyID = XWindowsUtil::mapKeySymToKeyID(uKeysym);
-                        if (lKeyID == kKeyNone || uKeyID == kKeyNone) {
-                            continue;
-                        }
-
-                        item.m_id       = lKeyID;
-                        item.m_required = 0;
-                        keyMap.addKeyEntry(item);
-
-                        item.m_id       = uKeyID;
-                        item.m_required = ShiftMask;
-                        keyMap.addKeyEntry(item);
-                        item.m_required = LockMask;
-                        keyMap.addKeyEntry(item);
-
-                        if (group == 0) {
-                            m_keyCodeFromKey.insert(
-                                    std::make_pair(lKeyID, keycode));
-                            m_keyCodeFromKey.insert(
-                                    std::make_pair(uKeyID, keycode));
-                        }
+                    item.m_sensitive |= ShiftMask | LockMask;
+
+                    KeyID lKeyID = XWindowsUtil::mapKeySymToKeyID(lKeysym);
+                    KeyID uKeyID = XWindowsUtil::mapKeySymToKeyID(uKeysym);
+                    if (lKeyID == kKeyNone || uKeyID == kKeyNone) {
                         continue;
                     }
-                }
 
-                // add entry
-                item.m_id = XWindowsUtil::mapKeySymToKeyID(keysym);
-                keyMap.addKeyEntry(item);
-                if (group == 0) {
-                    m_keyCodeFromKey.insert(std::make_pair(item.m_id, keycode));
+                    item.m_id         = lKeyID;
+                    item.m_required   = 0;
+                    step.m_mapKeyCode = (group == 0);
+                    info.m_steps.push_back(step);
+
+                    item.m_id       = uKeyID;
+                    item.m_required = ShiftMask;
+                    info.m_steps.push_back(step);
+                    item.m_required   = LockMask;
+                    step.m_mapKeyCode = false;
+                    info.m_steps.push_back(step);
+                    continue;
                 }
             }
+
+            // add entry
+            item.m_id         = XWindowsUtil::mapKeySymToKeyID(keysym);
+            step.m_mapKeyCode = (group == 0);
+            info.m_steps.push_back(step);
         }
     }
+}
 
-    // change all modifier masks to InputLeap masks from X masks
-    keyMap.foreachKey(&XWindowsKeyState::remapKeyModifiers, this);
+void XWindowsKeyState::addKeycodeXKB(inputleap::KeyMap& keyMap, KeyCode keycode,
+                                     const XKBKeycode& info,
+                                     std::vector<int>& modifierLevel)
+{
+    if (info.m_halfDuplex) {
+        keyMap.addHalfDuplexButton(static_cast<KeyButton>(keycode));
+    }
 
-    // allow composition across groups
-    keyMap.allowGroupSwitchDuringCompose();
+    for (const XKBKeycodeStep& step : info.m_steps) {
+        const inputleap::KeyMap::KeyItem& item = step.m_item;
+        if (step.m_addEntry) {
+            keyMap.addKeyEntry(item);
+            if (step.m_mapKeyCode) {
+                m_keyCodeFromKey.insert(std::make_pair(item.m_id, keycode));
+            }
+            continue;
+        }
+
+        // record the modifier mask for this key
+        std::int32_t group = item.m_group;
+        for (std::int32_t k = 0; k < 8; ++k) {
+            // skip modifiers this key doesn't generate
+            if ((step.m_modifierMask & (1u << k)) == 0) {
+                continue;
+            }
+
+            // skip keys that map to a modifier that we've already seen
+            // using fewer modifiers.  that is if this key must combine
+            // with other modifiers and we know of a key that combines
+            // with fewer modifiers (or no modifiers) then prefer the
+            // other key.
+            if (step.m_level >= modifierLevel[8 * group + k]) {
+                continue;
+            }
+            modifierLevel[8 * group + k] = step.m_level;
+
+            // save modifier
+            m_modifierFromX[8 * group + k] |= (1u << step.m_modifierBit);
+            m_modifierToX.insert(std::make_pair(
+                    1u << step.m_modifierBit, 1u << k));
+        }
+    }
+}
+
+bool XWindowsKeyState::canGetMapChangesXKB() const
+{
+    // key type changes can affect any keycode so they need a full update
+    return m_xkbChangesPending && !m_xkbKeycodes.empty() &&
+           (m_xkbChanges.changed & XkbKeyTypesMask) == 0;
+}
+
+void XWindowsKeyState::getChangedKeycodesXKB(int& firstKeycode,
+                                             int& lastKeycode) const
+{
+    const XkbMapChangesRec& c = m_xkbChanges;
+    const struct {
+        unsigned int m_mask;
+        int m_first;
+        int m_count;
+    } ranges[] = {
+        { XkbKeySymsMask,      c.first_key_sym,      c.num_key_syms },
+        { XkbKeyActionsMask,   c.first_key_act,      c.num_key_acts },
+        { XkbKeyBehaviorsMask, c.first_key_behavior, c.num_key_behaviors },
+        { XkbModifierMapMask,  c.first_modmap_key,   c.num_modmap_keys }
+    };
+
+    int first = m_xkb->max_key_code + 1;
+    int last  = m_xkb->min_key_code - 1;
+    for (const auto& range : ranges) {
+        if ((c.changed & range.m_mask) != 0 && range.m_count > 0) {
+            first = std::min(first, range.m_first);
+            last  = std::max(last, range.m_first + range.m_count - 1);
+        }
+    }
+    firstKeycode = std::max(first, static_cast<int>(m_xkb->min_key_code));
+    lastKeycode  = std::min(last, static_cast<int>(m_xkb->max_key_code));
+}
+
+std::uint64_t XWindowsKeyState::hashKeycodeXKB(KeyCode keycode,
+                                               int maxNumGroups) const
+{
+    // hash everything buildKeycodeXKB() looks at
+    std::uint64_t hash = XKBHashSeed;
+    int numGroups = m_impl->do_XkbKeyNumGroups(m_xkb, keycode);
+    hashXKBValue(hash, static_cast<std::uint64_t>(numGroups));
+    if (numGroups == 0) {
+        return hash;
+    }
+
+    bool hasActions = (m_impl->do_XkbKeyHasActions(m_xkb, keycode) == True);
+    hashXKBValue(hash, m_xkb->server->behaviors[keycode].type);
+    hashXKBValue(hash, m_xkb->map->modmap[keycode]);
+    hashXKBValue(hash, hasActions ? 1 : 0);
+
+    for (int group = 0; group < maxNumGroups; ++group) {
+        int eGroup = getEffectiveGroup(keycode, group);
+        XkbKeyTypePtr type = m_impl->do_XkbKeyKeyType(m_xkb, keycode, eGroup);
+        hashXKBValue(hash, static_cast<std::uint64_t>(eGroup));
+        hashXKBValue(hash, type->mods.mask);
+        hashXKBValue(hash, type->num_levels);
+        hashXKBValue(hash, type->map_count);
+        for (int j = 0; j < type->map_count; ++j) {
+            const XkbKTMapEntryRec& entry = type->map[j];
+            hashXKBValue(hash, entry.active);
+            hashXKBValue(hash, entry.level);
+            hashXKBValue(hash, entry.mods.mask);
+            if (type->preserve != nullptr) {
+                hashXKBValue(hash, type->preserve[j].mask);
+            }
+        }
+
+        for (int level = 0; level < type->num_levels; ++level) {
+            hashXKBValue(hash, m_impl->do_XkbKeySymEntry(m_xkb, keycode,
+                                                         level, eGroup));
+            if (hasActions) {
+                XkbAction* action =
+                    m_impl->do_XkbKeyActionEntry(m_xkb, keycode, level, eGroup);
+                std::uint64_t value = 0;
+                std::memcpy(&value, action,
+                            std::min(sizeof(value), sizeof(*action)));
+                hashXKBValue(hash, value);
+            }
+        }
+    }
+    return hash;
+}
+
+bool XWindowsKeyState::findLayoutXKB(std::uint64_t fingerprint,
+                                     inputleap::KeyMap& keyMap)
+{
+    for (auto i = m_xkbLayouts.begin(); i != m_xkbLayouts.end(); ++i) {
+        if (i->m_fingerprint == fingerprint) {
+            m_xkbLayouts.splice(m_xkbLayouts.begin(), m_xkbLayouts, i);
+            keyMap                 = i->m_keyMap;
+            m_xkbKeycodes          = i->m_keycodes;
+            m_xkbKeycodeHashes     = i->m_keycodeHashes;
+            m_lastGoodXKBModifiers = i->m_lastGoodModifiers;
+            m_modifierFromX        = i->m_modifierFromX;
+            m_modifierToX          = i->m_modifierToX;
+            m_keyCodeFromKey       = i->m_keyCodeFromKey;
+            return true;
+        }
+    }
+    return false;
+}
+
+void XWindowsKeyState::saveLayoutXKB(std::uint64_t fingerprint,
+                                     const inputleap::KeyMap& keyMap)
+{
+    m_xkbLayouts.emplace_front();
+    XKBLayout& layout = m_xkbLayouts.front();
+    layout.m_fingerprint       = fingerprint;
+    layout.m_keyMap            = keyMap;
+    layout.m_keycodes          = m_xkbKeycodes;
+    layout.m_keycodeHashes     = m_xkbKeycodeHashes;
+    layout.m_lastGoodModifiers = m_lastGoodXKBModifiers;
+    layout.m_modifierFromX     = m_modifierFromX;
+    layout.m_modifierToX       = m_modifierToX;
+    layout.m_keyCodeFromKey    = m_keyCodeFromKey;
+    if (m_xkbLayouts.size() > MaxXKBLayouts) {
+        m_xkbLayouts.pop_back();
+    }
 }
 
 void XWindowsKeyState::remapKeyModifiers(KeyID id, std::int32_t group,
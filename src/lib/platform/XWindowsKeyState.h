@@ -27,7 +27,10 @@
 #include <X11/extensions/XTest.h>
 #    include <X11/extensions/XKBstr.h>
 
+#include <cstdint>
+#include <list>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace inputleap {
@@ -71,6 +74,21 @@ public:
     */
     void setAutoRepeat(const XKeyboardState&);
 
+    //! Defer flushing synthesized keys
+    /*!
+    While \p deferred is true synthesized keys are only queued and the
+    caller is responsible for flushing them to the X server.
+    */
+    void setFlushDeferred(bool deferred);
+
+    //! Note XKB keyboard map changes
+    /*!
+    Records the map components and keycodes changed according to
+    \p event.  The next \c updateKeyMap() only fetches and rebuilds
+    those keycodes instead of the whole keyboard map.
+    */
+    void noteKeyMapChanges(const XkbMapNotifyEvent& event);
+
     //@}
     //! @name accessors
     //@{
@@ -114,7 +132,13 @@ protected:
 private:
     void init(Display* display, bool useXKB);
     void updateKeysymMap(inputleap::KeyMap&);
-    void updateKeysymMapXKB(inputleap::KeyMap&);
+    void updateKeysymMapXKB(inputleap::KeyMap&, int firstKeycode,
+                            int lastKeycode);
+    bool canGetMapChangesXKB() const;
+    void getChangedKeycodesXKB(int& firstKeycode, int& lastKeycode) const;
+    std::uint64_t hashKeycodeXKB(KeyCode, int maxNumGroups) const;
+    bool findLayoutXKB(std::uint64_t fingerprint, inputleap::KeyMap&);
+    void saveLayoutXKB(std::uint64_t fingerprint, const inputleap::KeyMap&);
     bool hasModifiersXKB() const;
     int getEffectiveGroup(KeyCode, int group) const;
     std::uint32_t getGroupFromState(unsigned int state) const;
@@ -129,6 +153,29 @@ private:
         bool m_lock;
     };
 
+    // one step of adding a keycode to the key map:  either noting a
+    // modifier the key generates or adding a key entry.  modifier
+    // masks are X modifier masks.
+    struct XKBKeycodeStep {
+    public:
+        inputleap::KeyMap::KeyItem m_item;
+        bool m_addEntry;
+        bool m_mapKeyCode;
+        std::uint32_t m_modifierBit;
+        std::uint32_t m_modifierMask;
+        int m_level;
+    };
+
+    // everything a keycode adds to the key map.  these are shared by
+    // the layouts that have the keycode in common.
+    struct XKBKeycode {
+    public:
+        bool m_halfDuplex = false;
+        std::vector<XKBKeycodeStep> m_steps;
+    };
+    typedef std::vector<std::shared_ptr<const XKBKeycode>> XKBKeycodeList;
+    typedef std::vector<std::uint64_t> XKBKeycodeHashList;
+
 #ifdef INPUTLEAP_TEST_ENV
 public: // yuck
 #endif
@@ -140,6 +187,25 @@ private:
     typedef std::map<KeyCode, unsigned int> NonXKBModifierMap;
     typedef std::map<std::uint32_t, XKBModifierInfo> XKBModifierMap;
 
+    // a recently used keyboard layout and the key map built for it
+    struct XKBLayout {
+    public:
+        std::uint64_t m_fingerprint;
+        inputleap::KeyMap m_keyMap;
+        XKBKeycodeList m_keycodes;
+        XKBKeycodeHashList m_keycodeHashes;
+        XKBModifierMap m_lastGoodModifiers;
+        KeyModifierMaskList m_modifierFromX;
+        KeyModifierToXMask m_modifierToX;
+        KeyToKeyCodeMap m_keyCodeFromKey;
+    };
+    typedef std::list<XKBLayout> XKBLayoutList;
+
+    void buildKeycodeXKB(KeyCode, int maxNumGroups, bool useLastGoodModifiers,
+                         XKBKeycode&);
+    void addKeycodeXKB(inputleap::KeyMap&, KeyCode, const XKBKeycode&,
+                       std::vector<int>& modifierLevel);
+
     IXWindowsImpl* m_impl;
 
     Display* m_display;
@@ -157,9 +223,27 @@ private:
     // map KeyID to all keycodes that can synthesize that KeyID
     KeyToKeyCodeMap m_keyCodeFromKey;
 
+    // XKB map changes noted but not yet fetched from the server
+    XkbMapChangesRec m_xkbChanges;
+    bool m_xkbChangesPending = false;
+
+    // what each keycode added to the key map and a hash of the XKB data
+    // it was built from, indexed by keycode, and the number of groups
+    // and modifier hack they were built with
+    XKBKeycodeList m_xkbKeycodes;
+    XKBKeycodeHashList m_xkbKeycodeHashes;
+    int m_xkbNumGroups = 0;
+    bool m_xkbUsedLastGoodModifiers = false;
+
+    // recently used layouts, most recently used first
+    XKBLayoutList m_xkbLayouts;
+
     // autorepeat state
     XKeyboardState m_keyboardState;
 
+    // true while synthesized keys are flushed by the caller
+    bool m_flushDeferred = false;
+
 #ifdef INPUTLEAP_TEST_ENV
 public:
     std::int32_t group() const { return m_group; }
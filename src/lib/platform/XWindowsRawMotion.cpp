@@ -0,0 +1,157 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "platform/XWindowsRawMotion.h"
+
+#include "base/Log.h"
+
+namespace inputleap {
+
+XWindowsRawMotion::XWindowsRawMotion(IXWindowsImpl* impl) :
+    m_impl(impl)
+{
+}
+
+void XWindowsRawMotion::setShape(std::int32_t x, std::int32_t y,
+                                 std::int32_t w, std::int32_t h,
+                                 const std::vector<XRectangle>& crtcs)
+{
+    m_x = x;
+    m_y = y;
+    m_w = w;
+    m_h = h;
+    m_crtcs = crtcs;
+}
+
+void XWindowsRawMotion::forgetDevices()
+{
+    m_devices.clear();
+}
+
+void XWindowsRawMotion::clearRemainder()
+{
+    m_remainderX = 0.0;
+    m_remainderY = 0.0;
+}
+
+bool XWindowsRawMotion::getMotion(const XIRawEvent& event,
+                                  std::int32_t& dx, std::int32_t& dy)
+{
+    Device& device = getDevice(event.display, event.sourceid);
+
+    // pick the x and y values out of the valuators that changed
+    double delta[2] = { 0.0, 0.0 };
+    const double* value = event.valuators.values;
+    for (int i = 0; i < event.valuators.mask_len * 8; ++i) {
+        if (XIMaskIsSet(event.valuators.mask, i)) {
+            if (i < 2) {
+                if (!device.m_absolute) {
+                    delta[i] = *value;
+                }
+                else {
+                    // absolute devices (tablets, most virtual machine
+                    // pointers) report positions.  scale the change in
+                    // position from the device's range to the screen.
+                    double range = device.m_max[i] - device.m_min[i];
+                    if (device.m_hasLast[i] && range > 0.0) {
+                        delta[i] = (*value - device.m_last[i]) *
+                                    (i == 0 ? m_w : m_h) / range;
+                    }
+                    device.m_last[i] = *value;
+                    device.m_hasLast[i] = true;
+                }
+            }
+            ++value;
+        }
+    }
+
+    // report whole pixels and keep the fractions for the next motion
+    double x = delta[0] + m_remainderX;
+    double y = delta[1] + m_remainderY;
+    dx = static_cast<std::int32_t>(x);
+    dy = static_cast<std::int32_t>(y);
+    m_remainderX = x - dx;
+    m_remainderY = y - dy;
+    return !device.m_absolute;
+}
+
+bool XWindowsRawMotion::canTrack(std::int32_t x, std::int32_t y,
+                                 std::int32_t dx, std::int32_t dy) const
+{
+    std::int32_t xNew = x + dx;
+    std::int32_t yNew = y + dy;
+    if (xNew <= m_x || xNew >= m_x + m_w - 1 || yNew <= m_y || yNew >= m_y + m_h - 1) {
+        return false;
+    }
+
+    // a move between crtcs may have been stopped at the edge of the first
+    if (m_crtcs.empty()) {
+        return true;
+    }
+    int crtc = findCrtc(x, y);
+    return crtc != -1 && crtc == findCrtc(xNew, yNew);
+}
+
+XWindowsRawMotion::Device&
+XWindowsRawMotion::getDevice(Display* display, int deviceid)
+{
+    std::map<int, Device>::iterator i = m_devices.find(deviceid);
+    if (i != m_devices.end()) {
+        return i->second;
+    }
+
+    // a device we can't query is treated as absolute with no range so
+    // we don't misuse its valuators as deltas
+    Device& device = m_devices[deviceid];
+    int count;
+    XIDeviceInfo* info = m_impl->XIQueryDevice(display, deviceid, &count);
+    if (info != nullptr) {
+        device.m_absolute = false;
+        for (int j = 0; j < info->num_classes; ++j) {
+            if (info->classes[j]->type != XIValuatorClass) {
+                continue;
+            }
+            XIValuatorClassInfo* valuator =
+                reinterpret_cast<XIValuatorClassInfo*>(info->classes[j]);
+            if (valuator->number < 2) {
+                device.m_min[valuator->number] = valuator->min;
+                device.m_max[valuator->number] = valuator->max;
+                if (valuator->mode == XIModeAbsolute) {
+                    device.m_absolute = true;
+                }
+            }
+        }
+        m_impl->XIFreeDeviceInfo(info);
+    }
+    LOG((CLOG_DEBUG "XI2 device %d is %s", deviceid,
+        device.m_absolute ? "absolute" : "relative"));
+    return device;
+}
+
+int XWindowsRawMotion::findCrtc(std::int32_t x, std::int32_t y) const
+{
+    for (std::size_t i = 0; i < m_crtcs.size(); ++i) {
+        const XRectangle& crtc = m_crtcs[i];
+        if (x >= crtc.x && x < crtc.x + crtc.width &&
+            y >= crtc.y && y < crtc.y + crtc.height) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+} // namespace inputleap
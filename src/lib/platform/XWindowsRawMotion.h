@@ -0,0 +1,105 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "config.h"
+
+#include "XWindowsImpl.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace inputleap {
+
+//! Pointer motion from XInput2 raw events
+/*!
+Turns the raw motion of XI2 source devices into whole pixels of motion
+on the screen and tells when a pointer position tracked from that motion
+can't be trusted, so the server has to be asked where the pointer is.
+*/
+class XWindowsRawMotion {
+public:
+    explicit XWindowsRawMotion(IXWindowsImpl* impl);
+
+    //! @name manipulators
+    //@{
+
+    //! Set the screen shape
+    /*!
+    \c crtcs are the rectangles of the active crtcs, which the server
+    keeps the pointer on.  If there are none the whole screen is used.
+    */
+    void setShape(std::int32_t x, std::int32_t y, std::int32_t w, std::int32_t h,
+                  const std::vector<XRectangle>& crtcs);
+
+    //! Forget the source devices, whose ids may have been reused
+    void forgetDevices();
+
+    //! Drop the fractions of a pixel that weren't reported yet
+    void clearRemainder();
+
+    //! Get the motion of a raw event
+    /*!
+    Sets \c dx and \c dy to the whole pixels moved and keeps the fractions
+    for the next event.  Returns false if the source device reports
+    absolute positions, which makes the motion an estimate.
+    */
+    bool getMotion(const XIRawEvent& event, std::int32_t& dx, std::int32_t& dy);
+
+    //@}
+    //! @name accessors
+    //@{
+
+    //! Check if a move of the pointer can be tracked
+    /*!
+    Returns false if moving the pointer from \c x,y by \c dx,dy takes it
+    off the crtc it's on, or if \c x,y isn't on a crtc, since the server
+    may have clamped the move.  Also returns false at the edges of the
+    screen, where leaving the screen depends on the real position.
+    */
+    bool canTrack(std::int32_t x, std::int32_t y,
+                  std::int32_t dx, std::int32_t dy) const;
+
+    //@}
+
+private:
+    // the x and y valuators of a source device.  devices reporting
+    // absolute positions keep their last position so it can be turned
+    // into a delta.
+    class Device {
+    public:
+        bool m_absolute = true;
+        double m_min[2] = { 0.0, 0.0 };
+        double m_max[2] = { 0.0, 0.0 };
+        double m_last[2] = { 0.0, 0.0 };
+        bool m_hasLast[2] = { false, false };
+    };
+
+    Device& getDevice(Display* display, int deviceid);
+    int findCrtc(std::int32_t x, std::int32_t y) const;
+
+    IXWindowsImpl* m_impl;
+    std::map<int, Device> m_devices;
+    std::int32_t m_x = 0, m_y = 0, m_w = 0, m_h = 0;
+    std::vector<XRectangle> m_crtcs;
+    double m_remainderX = 0.0;
+    double m_remainderY = 0.0;
+};
+
+} // namespace inputleap
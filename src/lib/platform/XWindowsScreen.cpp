@@ -41,6 +41,11 @@ namespace inputleap {
 
 static int xi_opcode;
 
+// pointer events selected by the grab, including EnterNotify and LeaveNotify
+static const unsigned int s_grabPointerMask = ButtonPressMask | ButtonReleaseMask |
+                                              EnterWindowMask | LeaveWindowMask |
+                                              PointerMotionMask;
+
 //
 // XWindowsScreen
 //
@@ -90,6 +95,7 @@ XWindowsScreen::XWindowsScreen(
     m_preserveFocus(false),
     m_xkb(false),
     m_xi2detected(false),
+    m_rawMotion(impl),
     m_xrandr(false),
     m_events(events)
 {
@@ -130,6 +136,7 @@ XWindowsScreen::XWindowsScreen(
 		m_xi2detected = detectXI2();
 		if (m_xi2detected) {
 			selectXIRawMotion();
+			m_captureWindow = openCaptureWindow();
 		} else
 		{
 			// start watching for events on other windows
@@ -149,6 +156,18 @@ XWindowsScreen::XWindowsScreen(
         m_clipboard[id] = new XWindowsClipboard(m_impl, m_display, m_window, id);
 	}
 
+	// get told whenever a selection changes owner so clipboards only
+	// read data that actually changed
+	if (m_xfixes) {
+		for (ClipboardID id = 0; id < kClipboardEnd; ++id) {
+            m_impl->XFixesSelectSelectionInput(m_display, m_window,
+                                    m_clipboard[id]->getSelection(),
+                                    XFixesSetSelectionOwnerNotifyMask |
+                                    XFixesSelectionWindowDestroyNotifyMask |
+                                    XFixesSelectionClientCloseNotifyMask);
+		}
+	}
+
 	// install event handlers
 	m_events->add_handler(EventType::SYSTEM, m_events->getSystemTarget(),
                           [this](const auto& e){ handle_system_event(e); });
@@ -180,6 +199,9 @@ XWindowsScreen::~XWindowsScreen()
         if (m_im != nullptr) {
             m_impl->XCloseIM(m_im);
 		}
+        if (m_captureWindow != None) {
+            m_impl->XDestroyWindow(m_display, m_captureWindow);
+        }
         m_impl->XDestroyWindow(m_display, m_window);
         m_impl->XCloseDisplay(m_display);
 	}
@@ -323,8 +345,16 @@ XWindowsScreen::leave()
 	// now warp the mouse.  we warp after showing the window so we're
 	// guaranteed to get the mouse leave event and to prevent the
 	// keyboard focus from changing under point-to-focus policies.
+	// the grab already moved the pointer into the capture window if
+	// there is one.
 	if (m_isPrimary) {
-		warpCursor(m_xCenter, m_yCenter);
+		if (m_captureWindow != None) {
+			m_xi2CursorKnown = false;
+			m_rawMotion.clearRemainder();
+		}
+		else {
+			warpCursor(m_xCenter, m_yCenter);
+		}
 	}
 	else {
 		fakeMouseMove(m_xCenter, m_yCenter);
@@ -373,7 +403,10 @@ XWindowsScreen::setClipboard(ClipboardID id, const IClipboard* clipboard)
 void
 XWindowsScreen::checkClipboards()
 {
-	// do nothing, we're always up to date
+	// we're always up to date except for owner changes still queued
+	if (m_xfixes) {
+		checkSelectionOwners();
+	}
 }
 
 void
@@ -457,6 +490,12 @@ XWindowsScreen::getClipboard(ClipboardID id, IClipboard* clipboard) const
 	Time timestamp = XWindowsUtil::getCurrentTime(
 								m_display, m_clipboard[id]->getWindow());
 
+	// getting the time was a round-trip so every owner change up to now
+	// is in the event queue.  handle them so we don't copy stale data.
+	if (m_xfixes) {
+		checkSelectionOwners();
+	}
+
 	// copy the clipboard
 	return Clipboard::copy(clipboard, m_clipboard[id], timestamp);
 }
@@ -492,6 +531,15 @@ void XWindowsScreen::reconfigure(std::uint32_t)
 
 void XWindowsScreen::warpCursor(std::int32_t x, std::int32_t y)
 {
+	// a warp can't take the pointer out of the capture window it's
+	// confined to, so confine it to the whole grab window instead.  the
+	// grab is released when we enter the screen.
+	if (m_isPrimary && !m_isOnScreen && m_captureWindow != None) {
+        m_impl->XGrabPointer(m_display, m_window, False, s_grabPointerMask,
+								GrabModeAsync, GrabModeAsync,
+								m_window, None, CurrentTime);
+	}
+
 	// warp mouse
 	warpCursorNoFlush(x, y);
 
@@ -508,6 +556,10 @@ void XWindowsScreen::warpCursor(std::int32_t x, std::int32_t y)
 	// save position as last position
 	m_xCursor = x;
 	m_yCursor = y;
+
+	// raw motion from before the warp may still be queued so have the
+	// next one ask the server where the pointer is
+	m_xi2CursorKnown = false;
 }
 
 std::uint32_t XWindowsScreen::registerHotKey(KeyID key, KeyModifierMask mask)
@@ -775,6 +827,29 @@ void XWindowsScreen::getCursorCenter(std::int32_t& x, std::int32_t& y) const
 	y = m_yCenter;
 }
 
+void XWindowsScreen::fakeBatchBegin()
+{
+    if (m_fakeBatchDepth++ == 0) {
+        m_keyState->setFlushDeferred(true);
+    }
+}
+
+void XWindowsScreen::fakeBatchEnd()
+{
+    assert(m_fakeBatchDepth > 0);
+    if (--m_fakeBatchDepth == 0) {
+        m_keyState->setFlushDeferred(false);
+        m_impl->XFlush(m_display);
+    }
+}
+
+void XWindowsScreen::flushFakeInput() const
+{
+    if (m_fakeBatchDepth == 0) {
+        m_impl->XFlush(m_display);
+    }
+}
+
 void
 XWindowsScreen::fakeMouseButton(ButtonID button, bool press)
 {
@@ -782,7 +857,7 @@ XWindowsScreen::fakeMouseButton(ButtonID button, bool press)
 	if (xButton > 0 && xButton < 11) {
         m_impl->XTestFakeButtonEvent(m_display, xButton,
 							press ? True : False, CurrentTime);
-        m_impl->XFlush(m_display);
+        flushFakeInput();
 	}
 }
 
@@ -795,7 +870,7 @@ void XWindowsScreen::fakeMouseMove(std::int32_t x, std::int32_t y)
 		XTestFakeMotionEvent(m_display, DefaultScreen(m_display),
 							x, y, CurrentTime);
 	}
-    m_impl->XFlush(m_display);
+    flushFakeInput();
 }
 
 void XWindowsScreen::fakeMouseRelativeMove(std::int32_t dx, std::int32_t dy) const
@@ -807,7 +882,7 @@ void XWindowsScreen::fakeMouseRelativeMove(std::int32_t dx, std::int32_t dy) con
 	else {
         m_impl->XTestFakeRelativeMotionEvent(m_display, dx, dy, CurrentTime);
 	}
-    m_impl->XFlush(m_display);
+    flushFakeInput();
 }
 
 void XWindowsScreen::fakeMouseWheel(std::int32_t xDelta, std::int32_t yDelta) const
@@ -850,7 +925,45 @@ void XWindowsScreen::fakeMouseWheel(std::int32_t xDelta, std::int32_t yDelta) co
         m_impl->XTestFakeButtonEvent(m_display, xButton, False, CurrentTime);
 	}
 
-    m_impl->XFlush(m_display);
+    flushFakeInput();
+}
+
+double XWindowsScreen::getRefreshRate() const
+{
+    if (!m_xrandr) {
+        return 0.0;
+    }
+
+    XRRScreenResources* resources = m_impl->XRRGetScreenResourcesCurrent(m_display, m_root);
+    if (resources == nullptr) {
+        return 0.0;
+    }
+
+    // the refresh rate of a crtc is the rate of its mode
+    double rate = 0.0;
+    for (int i = 0; i < resources->ncrtc; ++i) {
+        XRRCrtcInfo* crtc = m_impl->XRRGetCrtcInfo(m_display, resources, resources->crtcs[i]);
+        if (crtc == nullptr) {
+            continue;
+        }
+        for (int j = 0; crtc->mode != None && j < resources->nmode; ++j) {
+            const XRRModeInfo& mode = resources->modes[j];
+            if (mode.id != crtc->mode || mode.hTotal == 0 || mode.vTotal == 0) {
+                continue;
+            }
+            double vTotal = mode.vTotal;
+            if ((mode.modeFlags & RR_DoubleScan) != 0) {
+                vTotal *= 2.0;
+            }
+            if ((mode.modeFlags & RR_Interlace) != 0) {
+                vTotal /= 2.0;
+            }
+            rate = std::max(rate, static_cast<double>(mode.dotClock) / (mode.hTotal * vTotal));
+        }
+        m_impl->XRRFreeCrtcInfo(crtc);
+    }
+    m_impl->XRRFreeScreenResources(resources);
+    return rate;
 }
 
 Display*
@@ -907,6 +1020,10 @@ XWindowsScreen::openDisplay(const char* displayName)
         m_impl->XRRSelectInput(display, DefaultRootWindow(display), RRScreenChangeNotifyMask | RRCrtcChangeNotifyMask);
 	}
 
+	// query for XFixes extension
+    m_xfixes = m_impl->XFixesQueryExtension(display, &m_xfixesEventBase,
+                                            &dummyError);
+
 	return display;
 }
 
@@ -955,6 +1072,31 @@ XWindowsScreen::saveShape()
 			XFree(screens);
 		}
 	}
+
+	// the server keeps the pointer on the crtcs, which raw motion needs
+	// to know to track the pointer
+	std::vector<XRectangle> crtcs;
+	XRRScreenResources* resources = m_xrandr ?
+		m_impl->XRRGetScreenResourcesCurrent(m_display, m_root) : nullptr;
+	if (resources != nullptr) {
+		for (int i = 0; i < resources->ncrtc; ++i) {
+			XRRCrtcInfo* crtc = m_impl->XRRGetCrtcInfo(m_display, resources, resources->crtcs[i]);
+			if (crtc == nullptr) {
+				continue;
+			}
+			if (crtc->mode != None && crtc->width > 0 && crtc->height > 0) {
+				XRectangle rect;
+				rect.x      = static_cast<short>(crtc->x);
+				rect.y      = static_cast<short>(crtc->y);
+				rect.width  = static_cast<unsigned short>(crtc->width);
+				rect.height = static_cast<unsigned short>(crtc->height);
+				crtcs.push_back(rect);
+			}
+			m_impl->XRRFreeCrtcInfo(crtc);
+		}
+		m_impl->XRRFreeScreenResources(resources);
+	}
+	m_rawMotion.setShape(m_x, m_y, m_w, m_h, crtcs);
 }
 
 Window
@@ -1009,6 +1151,32 @@ XWindowsScreen::openWindow() const
 	return window;
 }
 
+Window
+XWindowsScreen::openCaptureWindow() const
+{
+	// the capture window holds the pointer at the cursor center while
+	// it's grabbed, away from the screen edges and hot corners.  it's a
+	// child of the grab window so it's only viewable, and only takes
+	// input at that spot, while the grab window is mapped.  it has to
+	// follow the center when the screen shape changes.
+	XSetWindowAttributes attr;
+	attr.do_not_propagate_mask = 0;
+	attr.override_redirect     = True;
+	attr.event_mask            = 0;
+    Window window = m_impl->XCreateWindow(m_display, m_window,
+                            m_xCenter - m_x, m_yCenter - m_y, 1, 1, 0, 0,
+                            InputOnly, reinterpret_cast<Visual*>(CopyFromParent),
+							CWDontPropagate | CWEventMask | CWOverrideRedirect,
+							&attr);
+	if (window == None) {
+		LOG((CLOG_WARN "cannot create capture window, warping pointer to center instead"));
+		return None;
+	}
+    m_impl->XMapRaised(m_display, window);
+	LOG((CLOG_DEBUG "capture window is 0x%08x", window));
+	return window;
+}
+
 void
 XWindowsScreen::openIM()
 {
@@ -1196,24 +1364,15 @@ XWindowsScreen::handle_system_event(const Event& event)
 				cookie->type == GenericEvent &&
 				cookie->extension == xi_opcode) {
 			if (cookie->evtype == XI_RawMotion) {
-				// Get current pointer's position
-				XMotionEvent xmotion;
-				xmotion.type = MotionNotify;
-				xmotion.send_event = False; // Raw motion
-				xmotion.display = m_display;
-				xmotion.window = m_window;
-				/* xmotion's time, state and is_hint are not used */
-				unsigned int msk;
-                    xmotion.same_screen = m_impl->XQueryPointer(
-						m_display, m_root, &xmotion.root, &xmotion.subwindow,
-						&xmotion.x_root,
-						&xmotion.y_root,
-						&xmotion.x,
-						&xmotion.y,
-						&msk);
-					onMouseMove(xmotion);
-                    m_impl->XFreeEventData(m_display, cookie);
-					return;
+				onRawMotion(*static_cast<XIRawEvent*>(cookie->data));
+                m_impl->XFreeEventData(m_display, cookie);
+				return;
+			}
+			if (cookie->evtype == XI_HierarchyChanged) {
+				// device ids may have been reused
+				m_rawMotion.forgetDevices();
+                m_impl->XFreeEventData(m_display, cookie);
+				return;
 			}
                 m_impl->XFreeEventData(m_display, cookie);
 		}
@@ -1322,12 +1481,20 @@ XWindowsScreen::handle_system_event(const Event& event)
 		return;
 
 	case MotionNotify:
-		if (m_isPrimary) {
+		// with XI2 the raw motion events report all pointer motion
+		if (m_isPrimary && !m_xi2detected) {
 			onMouseMove(xevent->xmotion);
 		}
 		return;
 
 	default:
+		if (m_xfixes &&
+			xevent->type == m_xfixesEventBase + XFixesSelectionNotify) {
+			onSelectionOwnerChange(
+				*reinterpret_cast<XFixesSelectionNotifyEvent*>(xevent));
+			return;
+		}
+
 		if (m_xkb && xevent->type == m_xkbEventBase) {
 			XkbEvent* xkbEvent = reinterpret_cast<XkbEvent*>(xevent);
 			switch (xkbEvent->any.xkb_type) {
@@ -1364,6 +1531,13 @@ XWindowsScreen::handle_system_event(const Event& event)
                     m_impl->XResizeWindow(m_display, m_window, m_w, m_h);
 				}
 
+				// keep the capture window inside m_window or grabbing the
+				// pointer fails with GrabNotViewable
+				if (m_captureWindow != None) {
+                    m_impl->XMoveWindow(m_display, m_captureWindow,
+                                        m_xCenter - m_x, m_yCenter - m_y);
+				}
+
                 sendEvent(EventType::SCREEN_SHAPE_CHANGED);
 			}
 		}
@@ -1596,6 +1770,74 @@ XWindowsScreen::onMouseMove(const XMotionEvent& xmotion)
 	}
 }
 
+void
+XWindowsScreen::onRawMotion(const XIRawEvent& event)
+{
+	std::int32_t x, y;
+	bool relative = m_rawMotion.getMotion(event, x, y);
+
+	if (!m_isOnScreen) {
+		// motion on secondary screen.  the pointer is grabbed so it
+		// doesn't matter where it actually is.
+		if (x != 0 || y != 0) {
+			LOG((CLOG_DEBUG2 "event: RawMotion %+d,%+d", x, y));
+			m_xi2CursorKnown = false;
+            sendEvent(EventType::PRIMARY_SCREEN_MOTION_ON_SECONDARY,
+                      create_event_data<MotionInfo>(MotionInfo{x, y}));
+
+			// without a capture window the pointer really moves, so put
+			// it back before it reaches an edge or a hot corner.  warps
+			// don't produce raw events.
+			if (m_captureWindow == None) {
+                m_impl->XWarpPointer(m_display, None, m_root, 0, 0, 0, 0,
+                                     m_xCenter, m_yCenter);
+			}
+		}
+		return;
+	}
+
+	// motion on primary screen.  track the pointer while it moves within
+	// a crtc.  the server knows exactly where an absolute device put the
+	// pointer, where it clamped a move between crtcs and where the
+	// pointer is at the edges, so ask it in those cases and when we've
+	// lost track of the pointer.
+	if (relative && m_xi2CursorKnown) {
+		if (x == 0 && y == 0) {
+			return;
+		}
+		if (m_rawMotion.canTrack(m_xCursor, m_yCursor, x, y)) {
+			LOG((CLOG_DEBUG2 "event: RawMotion %+d,%+d", x, y));
+			m_xCursor += x;
+			m_yCursor += y;
+            sendEvent(EventType::PRIMARY_SCREEN_MOTION_ON_PRIMARY,
+                      create_event_data<MotionInfo>(MotionInfo{m_xCursor, m_yCursor}));
+			return;
+		}
+	}
+	onMouseMove(queryPointerMotion());
+	m_xi2CursorKnown = true;
+}
+
+XMotionEvent
+XWindowsScreen::queryPointerMotion() const
+{
+	XMotionEvent xmotion;
+	xmotion.type = MotionNotify;
+	xmotion.send_event = False;
+	xmotion.display = m_display;
+	xmotion.window = m_window;
+	/* xmotion's time, state and is_hint are not used */
+	unsigned int msk;
+    xmotion.same_screen = m_impl->XQueryPointer(
+		m_display, m_root, &xmotion.root, &xmotion.subwindow,
+		&xmotion.x_root,
+		&xmotion.y_root,
+		&xmotion.x,
+		&xmotion.y,
+		&msk);
+	return xmotion;
+}
+
 int XWindowsScreen::x_accumulateMouseScroll(std::int32_t xDelta) const
 {
     m_x_accumulatedScroll += xDelta;
@@ -1662,6 +1904,28 @@ XWindowsScreen::getClipboardID(Atom selection) const
 	return kClipboardEnd;
 }
 
+void
+XWindowsScreen::onSelectionOwnerChange(
+				const XFixesSelectionNotifyEvent& event) const
+{
+	ClipboardID id = getClipboardID(event.selection);
+	if (id != kClipboardEnd) {
+		m_clipboard[id]->changed(event.owner, event.selection_timestamp);
+	}
+}
+
+void
+XWindowsScreen::checkSelectionOwners() const
+{
+	XEvent xevent;
+    while (m_impl->XCheckTypedEvent(m_display,
+                                    m_xfixesEventBase + XFixesSelectionNotify,
+                                    &xevent)) {
+		onSelectionOwnerChange(
+			*reinterpret_cast<XFixesSelectionNotifyEvent*>(&xevent));
+	}
+}
+
 void
 XWindowsScreen::processClipboardRequest(Window requestor,
 				Time time, Atom property)
@@ -1739,12 +2003,14 @@ XWindowsScreen::doSelectEvents(Window w) const
 	// we want to track the mouse everywhere on the display.  to achieve
 	// that we select PointerMotionMask on every window.  we also select
 	// SubstructureNotifyMask in order to get CreateNotify events so we
-	// select events on new windows too.
-
-	// we don't want to adjust our grab window
-	if (w == m_window) {
-		return;
-	}
+	// select events on new windows too.  the tree is walked a level at a
+	// time so the requests for a whole level go out together.
+	std::vector<Window> windows(1, w);
+	while (!windows.empty()) {
+		// we don't want to adjust our grab window
+		windows.erase(std::remove(windows.begin(), windows.end(), m_window),
+						windows.end());
+		int count = static_cast<int>(windows.size());
 
        // X11 has a design flaw. If *no* client selected PointerMotionMask for
        // a window, motion events will be delivered to that window's parent.
@@ -1755,26 +2021,31 @@ XWindowsScreen::doSelectEvents(Window w) const
        //
        // Avoid selecting PointerMotionMask unless some other client selected
        // it already.
-       long mask = SubstructureNotifyMask;
-       XWindowAttributes attr;
-       m_impl->XGetWindowAttributes(m_display, w, &attr);
-       if ((attr.all_event_masks & PointerMotionMask) == PointerMotionMask) {
-               mask |= PointerMotionMask;
-       }
-
-	// select events of interest.  do this before querying the tree so
-	// we'll get notifications of children created after the XQueryTree()
-	// so we won't miss them.
-       m_impl->XSelectInput(m_display, w, mask);
-
-	// recurse on child windows
-	Window rw, pw, *cw;
-	unsigned int nc;
-    if (m_impl->XQueryTree(m_display, w, &rw, &pw, &cw, &nc)) {
-		for (unsigned int i = 0; i < nc; ++i) {
-			doSelectEvents(cw[i]);
+		std::vector<XWindowAttributes> attrs(count);
+		std::vector<Status> status(count);
+        m_impl->do_XGetWindowAttributesBatch(m_display, windows.data(), count,
+                                             attrs.data(), status.data());
+
+		// select events of interest.  do this before querying the tree so
+		// we'll get notifications of children created after the XQueryTree()
+		// so we won't miss them.
+		for (int i = 0; i < count; ++i) {
+			long mask = SubstructureNotifyMask;
+			if (status[i] != 0 &&
+				(attrs[i].all_event_masks & PointerMotionMask) == PointerMotionMask) {
+				mask |= PointerMotionMask;
+			}
+            m_impl->XSelectInput(m_display, windows[i], mask);
+		}
+
+		// continue with the child windows
+		std::vector<std::vector<Window>> children(count);
+        m_impl->do_XQueryTreeBatch(m_display, windows.data(), count,
+                                   children.data(), status.data());
+		windows.clear();
+		for (int i = 0; i < count; ++i) {
+			windows.insert(windows.end(), children[i].begin(), children[i].end());
 		}
-		XFree(cw);
 	}
 }
 
@@ -1930,8 +2201,6 @@ XWindowsScreen::updateButtons()
 bool
 XWindowsScreen::grabMouseAndKeyboard()
 {
-	unsigned int event_mask = ButtonPressMask | ButtonReleaseMask | EnterWindowMask | LeaveWindowMask | PointerMotionMask;
-
 	// grab the mouse and keyboard.  keep trying until we get them.
 	// if we can't grab one after grabbing the other then ungrab
 	// and wait before retrying.  give up after s_timeout seconds.
@@ -1955,10 +2224,14 @@ XWindowsScreen::grabMouseAndKeyboard()
 		} while (result != GrabSuccess);
 		LOG((CLOG_DEBUG2 "grabbed keyboard"));
 
-		// now the mouse --- use event_mask to get EnterNotify, LeaveNotify events
-        result = m_impl->XGrabPointer(m_display, m_window, False, event_mask,
+		// now the mouse --- use s_grabPointerMask to get EnterNotify, LeaveNotify events
+        // confining to the capture window parks the pointer at the
+        // center so secondary screen motion needs no warps
+        result = m_impl->XGrabPointer(m_display, m_window, False, s_grabPointerMask,
 								GrabModeAsync, GrabModeAsync,
-								m_window, None, CurrentTime);
+								m_captureWindow != None ?
+									m_captureWindow : m_window,
+								None, CurrentTime);
 		assert(result != GrabNotViewable);
 		if (result != GrabSuccess) {
 			// back off to avoid grab deadlock
@@ -1979,10 +2252,19 @@ XWindowsScreen::grabMouseAndKeyboard()
 void
 XWindowsScreen::refreshKeyboard(XEvent* event)
 {
+	// note what changed so the key map update can be limited to it
+	if (m_xkb && event->type == m_xkbEventBase) {
+		XkbMapNotifyEvent* mapEvent = reinterpret_cast<XkbMapNotifyEvent*>(event);
+        m_impl->XkbRefreshKeyboardMapping(mapEvent);
+		m_keyState->noteKeyMapChanges(*mapEvent);
+	}
+
     if (m_impl->XPending(m_display) > 0) {
 		XEvent tmpEvent;
         m_impl->XPeekEvent(m_display, &tmpEvent);
-		if (tmpEvent.type == MappingNotify) {
+		if (tmpEvent.type == MappingNotify ||
+			(m_xkb && tmpEvent.type == m_xkbEventBase &&
+			 reinterpret_cast<XkbEvent*>(&tmpEvent)->any.xkb_type == XkbMapNotify)) {
 			// discard this event since another follows.
 			// we tend to get a bunch of these in a row.
 			return;
@@ -1990,10 +2272,6 @@ XWindowsScreen::refreshKeyboard(XEvent* event)
 	}
 
 	// keyboard mapping changed
-	if (m_xkb && event->type == m_xkbEventBase) {
-        m_impl->XkbRefreshKeyboardMapping(reinterpret_cast<XkbMapNotifyEvent*>(event));
-	}
-	else
 	m_keyState->updateKeyMap();
 	m_keyState->updateKeyState();
 }
@@ -2028,17 +2306,26 @@ XWindowsScreen::detectXI2()
 void
 XWindowsScreen::selectXIRawMotion()
 {
-	XIEventMask mask;
-
-	mask.deviceid = XIAllDevices;
-	mask.mask_len = XIMaskLen(XI_RawMotion);
-    mask.mask = static_cast<unsigned char*>(calloc(mask.mask_len, sizeof(char)));
-	mask.deviceid = XIAllMasterDevices;
-	memset(mask.mask, 0, 2);
-    XISetMask(mask.mask, XI_RawKeyRelease);
-	XISetMask(mask.mask, XI_RawMotion);
-    m_impl->XISelectEvents(m_display, DefaultRootWindow(m_display), &mask, 1);
-	free(mask.mask);
+	XIEventMask mask[2];
+
+	mask[0].deviceid = XIAllDevices;
+	mask[0].mask_len = XIMaskLen(XI_RawMotion);
+    mask[0].mask = static_cast<unsigned char*>(calloc(mask[0].mask_len, sizeof(char)));
+	mask[0].deviceid = XIAllMasterDevices;
+	memset(mask[0].mask, 0, 2);
+    XISetMask(mask[0].mask, XI_RawKeyRelease);
+	XISetMask(mask[0].mask, XI_RawMotion);
+
+	// hierarchy changes can only be selected for all devices.  we use
+	// them to notice when device ids get reused.
+	mask[1].deviceid = XIAllDevices;
+	mask[1].mask_len = XIMaskLen(XI_HierarchyChanged);
+    mask[1].mask = static_cast<unsigned char*>(calloc(mask[1].mask_len, sizeof(char)));
+	XISetMask(mask[1].mask, XI_HierarchyChanged);
+
+    m_impl->XISelectEvents(m_display, DefaultRootWindow(m_display), mask, 2);
+	free(mask[0].mask);
+	free(mask[1].mask);
 }
 
 } // namespace inputleap
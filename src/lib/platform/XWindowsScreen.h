@@ -23,9 +23,11 @@
 #include "inputleap/PlatformScreen.h"
 #include "inputleap/KeyMap.h"
 #include "XWindowsImpl.h"
+#include "XWindowsRawMotion.h"
 
 #include <X11/Xlib.h>
 
+#include <map>
 #include <set>
 #include <vector>
 
@@ -66,10 +68,13 @@ public:
     void getCursorCenter(std::int32_t& x, std::int32_t& y) const override;
 
     // ISecondaryScreen overrides
+    void fakeBatchBegin() override;
+    void fakeBatchEnd() override;
     void fakeMouseButton(ButtonID id, bool press) override;
     void fakeMouseMove(std::int32_t x, std::int32_t y) override;
     void fakeMouseRelativeMove(std::int32_t dx, std::int32_t dy) const override;
     void fakeMouseWheel(std::int32_t xDelta, std::int32_t yDelta) const override;
+    double getRefreshRate() const override;
 
     // IPlatformScreen overrides
     void enable() override;
@@ -97,6 +102,9 @@ private:
     void sendEvent(EventType, EventDataBase* = nullptr);
     void sendClipboardEvent(EventType, ClipboardID);
 
+    // flush synthesized input unless it is batched
+    void flushFakeInput() const;
+
     // create the transparent cursor
     Cursor createBlankCursor() const;
 
@@ -104,6 +112,11 @@ private:
     // kClipboardEnd if no such clipboard.
     ClipboardID getClipboardID(Atom selection) const;
 
+    // tell the clipboards about selection owner changes reported by
+    // XFixes.  the second form handles those already in the event queue.
+    void onSelectionOwnerChange(const XFixesSelectionNotifyEvent&) const;
+    void checkSelectionOwners() const;
+
     // continue processing a selection request
     void processClipboardRequest(Window window,
                             Time time, Atom property);
@@ -127,6 +140,7 @@ private:
     Display* openDisplay(const char* displayName);
     void saveShape();
     Window openWindow() const;
+    Window openCaptureWindow() const;
     void openIM();
 
     bool grabMouseAndKeyboard();
@@ -136,6 +150,8 @@ private:
     void onMousePress(const XButtonEvent&);
     void onMouseRelease(const XButtonEvent&);
     void onMouseMove(const XMotionEvent&);
+    void onRawMotion(const XIRawEvent&);
+    XMotionEvent queryPointerMotion() const;
 
     // Returns the number of scroll events needed after the current delta has
     // been taken into account
@@ -192,6 +208,12 @@ private:
     Window m_root;
     Window m_window;
 
+    // with XI2 the pointer is confined to this 1x1 child of m_window
+    // while it's on a secondary screen.  motion comes from raw events so
+    // the pointer never has to be warped back to the center, unless the
+    // window couldn't be created.
+    Window m_captureWindow = None;
+
     // true if mouse has entered the screen
     bool m_isOnScreen;
 
@@ -243,6 +265,9 @@ private:
     bool m_xtestIsXineramaUnaware;
     bool m_xinerama;
 
+    // nesting depth of batches of input synthesized with xtest
+    int m_fakeBatchDepth = 0;
+
     // stuff to work around lost focus issues on certain systems
     // (ie: a MythTV front-end).
     bool m_preserveFocus;
@@ -253,10 +278,19 @@ private:
 
     bool m_xi2detected;
 
+    // XI2 raw motion stuff.  m_xi2CursorKnown is false when m_xCursor,
+    // m_yCursor may not be where the pointer really is.
+    XWindowsRawMotion m_rawMotion;
+    bool m_xi2CursorKnown = false;
+
     // XRandR extension stuff
     bool m_xrandr;
     int m_xrandrEventBase;
 
+    // XFixes extension stuff
+    bool m_xfixes = false;
+    int m_xfixesEventBase = 0;
+
     IEventQueue* m_events;
     inputleap::KeyMap m_keyMap;
 
@@ -412,15 +412,25 @@ XWindowsScreenSaver::watchForXScreenSaver()
     // clear old watch list
     clearWatchForXScreenSaver();
 
-    // add every child of the root to the list of windows to watch
+    // add every child of the root to the list of windows to watch.  get
+    // the attributes of all of them at once.
     Window root = DefaultRootWindow(m_display);
-    Window rw, pw, *cw;
-    unsigned int nc;
-    if (m_impl->XQueryTree(m_display, root, &rw, &pw, &cw, &nc)) {
-        for (unsigned int i = 0; i < nc; ++i) {
-            addWatchXScreenSaver(cw[i]);
+    std::vector<Window> children;
+    Status status;
+    m_impl->do_XQueryTreeBatch(m_display, &root, 1, &children, &status);
+    int count = static_cast<int>(children.size());
+    std::vector<XWindowAttributes> attrs(count);
+    std::vector<Status> attrStatus(count);
+    m_impl->do_XGetWindowAttributesBatch(m_display, children.data(), count,
+                                         attrs.data(), attrStatus.data());
+    {
+        // windows may be destroyed before we select input on them
+        XWindowsUtil::ErrorLock lock(m_display);
+        for (int i = 0; i < count; ++i) {
+            if (attrStatus[i] != 0) {
+                addWatchXScreenSaver(children[i], attrs[i]);
+            }
         }
-        m_impl->XFree(cw);
     }
 
     // now check for xscreensaver window in case it set the property
@@ -470,6 +480,20 @@ XWindowsScreenSaver::addWatchXScreenSaver(Window window)
     }
 }
 
+void
+XWindowsScreenSaver::addWatchXScreenSaver(Window window,
+                const XWindowAttributes& attr)
+{
+    // like addWatchXScreenSaver(Window) but the caller got the attributes
+    // and ignores errors.  a window destroyed in the meantime stays on the
+    // watch list until it's cleared, which is harmless.
+    if (attr.override_redirect == True) {
+        m_impl->XSelectInput(m_display, window,
+                             attr.your_event_mask | PropertyChangeMask);
+        m_watchWindows.insert(std::make_pair(window, attr.your_event_mask));
+    }
+}
+
 void
 XWindowsScreenSaver::updateDisableTimer()
 {
@@ -93,6 +93,7 @@ private:
 
     // add window to the watch list
     void addWatchXScreenSaver(Window window);
+    void addWatchXScreenSaver(Window window, const XWindowAttributes&);
 
     // install/uninstall the job used to suppress the screensaver
     void updateDisableTimer();
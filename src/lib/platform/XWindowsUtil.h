@@ -22,7 +22,6 @@
 
 #include <X11/Xlib.h>
 
-#include <map>
 #include <string>
 #include <vector>
 
@@ -171,13 +170,6 @@ private:
 
     static Bool propertyNotifyPredicate(Display*,
                             XEvent* xevent, XPointer arg);
-
-    static void initKeyMaps();
-
-private:
-    typedef std::map<KeySym, std::uint32_t> KeySymMap;
-
-    static KeySymMap    s_keySymToUCS4;
 };
 
 } // namespace inputleap
@@ -0,0 +1,129 @@
+
+#include "XWindowsXCBImpl.h"
+
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+#include <cstdlib>
+
+namespace inputleap {
+
+namespace {
+
+// Xlib doesn't export its visual id lookup
+Visual* findVisual(Screen* screen, xcb_visualid_t id)
+{
+    if (screen != nullptr) {
+        for (int i = 0; i < screen->ndepths; ++i) {
+            const Depth& depth = screen->depths[i];
+            for (int j = 0; j < depth.nvisuals; ++j) {
+                if (depth.visuals[j].visualid == id) {
+                    return &depth.visuals[j];
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
+Screen* findScreen(Display* display, xcb_window_t root)
+{
+    for (int i = 0; i < ScreenCount(display); ++i) {
+        if (RootWindow(display, i) == root) {
+            return ScreenOfDisplay(display, i);
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void XWindowsXCBImpl::do_XGetWindowAttributesBatch(Display* display,
+                                                   const Window* windows,
+                                                   int count,
+                                                   XWindowAttributes* attrs_return,
+                                                   Status* status_return)
+{
+    // XGetWindowAttributes is two requests.  send them all before
+    // waiting for any reply.
+    xcb_connection_t* connection = XGetXCBConnection(display);
+    std::vector<xcb_get_window_attributes_cookie_t> attrCookies(count);
+    std::vector<xcb_get_geometry_cookie_t> geometryCookies(count);
+    for (int i = 0; i < count; ++i) {
+        attrCookies[i] = xcb_get_window_attributes(connection, windows[i]);
+        geometryCookies[i] = xcb_get_geometry(connection, windows[i]);
+    }
+
+    // errors must be collected here.  otherwise XCB queues them as
+    // events which Xlib would pass to its error handler.
+    for (int i = 0; i < count; ++i) {
+        xcb_generic_error_t* attrError = nullptr;
+        xcb_generic_error_t* geometryError = nullptr;
+        xcb_get_window_attributes_reply_t* attrs =
+            xcb_get_window_attributes_reply(connection, attrCookies[i],
+                                            &attrError);
+        xcb_get_geometry_reply_t* geometry =
+            xcb_get_geometry_reply(connection, geometryCookies[i],
+                                   &geometryError);
+
+        status_return[i] = (attrs != nullptr && geometry != nullptr);
+        if (status_return[i] != 0) {
+            XWindowAttributes& attr = attrs_return[i];
+            attr.x                     = geometry->x;
+            attr.y                     = geometry->y;
+            attr.width                 = geometry->width;
+            attr.height                = geometry->height;
+            attr.border_width          = geometry->border_width;
+            attr.depth                 = geometry->depth;
+            attr.root                  = geometry->root;
+            attr.screen                = findScreen(display, geometry->root);
+            attr.visual                = findVisual(attr.screen, attrs->visual);
+            attr.c_class               = attrs->_class;
+            attr.bit_gravity           = attrs->bit_gravity;
+            attr.win_gravity           = attrs->win_gravity;
+            attr.backing_store         = attrs->backing_store;
+            attr.backing_planes        = attrs->backing_planes;
+            attr.backing_pixel         = attrs->backing_pixel;
+            attr.save_under            = attrs->save_under;
+            attr.colormap              = attrs->colormap;
+            attr.map_installed         = attrs->map_is_installed;
+            attr.map_state             = attrs->map_state;
+            attr.all_event_masks       = attrs->all_event_masks;
+            attr.your_event_mask       = attrs->your_event_mask;
+            attr.do_not_propagate_mask = attrs->do_not_propagate_mask;
+            attr.override_redirect     = attrs->override_redirect;
+        }
+        free(attrs);
+        free(geometry);
+        free(attrError);
+        free(geometryError);
+    }
+}
+
+void XWindowsXCBImpl::do_XQueryTreeBatch(Display* display,
+                                         const Window* windows, int count,
+                                         std::vector<Window>* children_return,
+                                         Status* status_return)
+{
+    xcb_connection_t* connection = XGetXCBConnection(display);
+    std::vector<xcb_query_tree_cookie_t> cookies(count);
+    for (int i = 0; i < count; ++i) {
+        cookies[i] = xcb_query_tree(connection, windows[i]);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        xcb_generic_error_t* error = nullptr;
+        xcb_query_tree_reply_t* tree =
+            xcb_query_tree_reply(connection, cookies[i], &error);
+        children_return[i].clear();
+        status_return[i] = (tree != nullptr);
+        if (tree != nullptr) {
+            const xcb_window_t* children = xcb_query_tree_children(tree);
+            children_return[i].assign(children,
+                            children + xcb_query_tree_children_length(tree));
+        }
+        free(tree);
+        free(error);
+    }
+}
+
+} // namespace inputleap
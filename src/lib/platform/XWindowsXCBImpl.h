@@ -0,0 +1,24 @@
+#pragma once
+
+#include "config.h"
+
+#include "XWindowsImpl.h"
+
+namespace inputleap {
+
+// Xlib has been built on XCB for a long time.  This sends requests that
+// can be pipelined through the XCB connection underneath the display
+// so a batch costs one round-trip instead of one per request.
+// Everything else goes through Xlib as before.
+class XWindowsXCBImpl : public XWindowsImpl {
+public:
+
+    void do_XGetWindowAttributesBatch(Display* display, const Window* windows,
+                                      int count, XWindowAttributes* attrs_return,
+                                      Status* status_return) override;
+    void do_XQueryTreeBatch(Display* display, const Window* windows, int count,
+                            std::vector<Window>* children_return,
+                            Status* status_return) override;
+};
+
+} // namespace inputleap
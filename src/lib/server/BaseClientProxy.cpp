@@ -45,6 +45,18 @@ void BaseClientProxy::getJumpCursorPos(std::int32_t& x, std::int32_t& y) const
     y = m_y;
 }
 
+void BaseClientProxy::broadcastKeyDown(KeyID key, KeyModifierMask mask, KeyButton button,
+                                       ProtocolMessageCache&)
+{
+    keyDown(key, mask, button);
+}
+
+void BaseClientProxy::broadcastKeyUp(KeyID key, KeyModifierMask mask, KeyButton button,
+                                     ProtocolMessageCache&)
+{
+    keyUp(key, mask, button);
+}
+
 std::string BaseClientProxy::getName() const
 {
     return m_name;
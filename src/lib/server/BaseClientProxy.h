@@ -19,10 +19,31 @@
 #pragma once
 
 #include "inputleap/IClient.h"
+#include "inputleap/ScreenId.h"
+#include "io/IStream.h"
+
+#include <map>
 
 namespace inputleap {
 
-class IStream;
+class LinkQuality;
+class ProtocolMessageCache;
+
+//! Counters of the connection to a client
+struct ClientCounters {
+    //! Traffic on the client's stream
+    StreamCounters m_stream;
+
+    //! Messages received from the client by message code
+    std::map<std::string, std::uint64_t> m_messagesReceived;
+
+    //! Clipboard data sent to and received from the client
+    std::uint64_t m_clipboardBytesSent = 0;
+    std::uint64_t m_clipboardBytesReceived = 0;
+
+    //! Mouse moves replaced while still waiting to be sent
+    std::uint64_t m_replacedMoves = 0;
+};
 
 //! Generic proxy for client or primary
 class BaseClientProxy : public IClient {
@@ -42,6 +63,29 @@ public:
     */
     void setJumpCursorPos(std::int32_t x, std::int32_t y);
 
+    //! Set screen id
+    /*!
+    Set the id of the canonical name of the screen in the configuration.
+    The server assigns it when adding the client.
+    */
+    void setScreenId(ScreenId id) { m_screenId = id; }
+
+    //! Notify of key press sent to many clients
+    /*!
+    Like keyDown() but messages formatted for the client are kept in
+    \c messages so that other clients getting the same key event can
+    reuse them instead of formatting their own.
+    */
+    virtual void broadcastKeyDown(KeyID, KeyModifierMask, KeyButton,
+                                  ProtocolMessageCache& messages);
+
+    //! Notify of key release sent to many clients
+    /*!
+    Like keyUp() but shares formatted messages like broadcastKeyDown().
+    */
+    virtual void broadcastKeyUp(KeyID, KeyModifierMask, KeyButton,
+                                ProtocolMessageCache& messages);
+
     //@}
     //! @name accessors
     //@{
@@ -58,6 +102,26 @@ public:
     */
     virtual bool isPrimary() const { return false; }
 
+    //! Get screen id
+    /*!
+    Returns the id set by setScreenId() or \c kNoScreenId if none.
+    */
+    ScreenId getScreenId() const { return m_screenId; }
+
+    //! Get counters
+    /*!
+    Fills \c counters with the counters of the connection to the client.
+    Proxies without a connection leave them alone.
+    */
+    virtual void getCounters(ClientCounters& counters) const { (void) counters; }
+
+    //! Get round-trip time estimate
+    /*!
+    Returns the round-trip time estimate of the link to the client, or
+    nullptr if the client is not probed.
+    */
+    virtual const LinkQuality* getLinkQuality() const { return nullptr; }
+
     //@}
 
     // IClient overrides
@@ -69,6 +133,7 @@ public:
 private:
     std::string m_name;
     std::int32_t m_x, m_y;
+    ScreenId m_screenId = kNoScreenId;
 };
 
 } // namespace inputleap
@@ -134,6 +134,11 @@ ClientProxy1_0::handle_data()
             return;
         }
 
+        m_messagesReceived[(static_cast<std::uint32_t>(code[0]) << 24) |
+                           (static_cast<std::uint32_t>(code[1]) << 16) |
+                           (static_cast<std::uint32_t>(code[2]) << 8) |
+                            static_cast<std::uint32_t>(code[3])]++;
+
         // parse message
         try {
             LOG((CLOG_DEBUG2 "msg from \"%s\": %c%c%c%c", getName().c_str(), code[0], code[1], code[2], code[3]));
@@ -308,6 +313,37 @@ ClientProxy1_0::keyUp(KeyID key, KeyModifierMask mask, KeyButton)
     ProtocolUtil::writef(getStream(), kMsgDKeyUp1_0, key, mask);
 }
 
+void ClientProxy1_0::broadcastKeyDown(KeyID key, KeyModifierMask mask, KeyButton,
+                                      ProtocolMessageCache& messages)
+{
+    LOG((CLOG_DEBUG1 "send key down to \"%s\" id=%d, mask=0x%04x", getName().c_str(), key, mask));
+    ProtocolUtil::writef(getStream(), messages, kMsgDKeyDown1_0, key, mask);
+}
+
+void ClientProxy1_0::broadcastKeyUp(KeyID key, KeyModifierMask mask, KeyButton,
+                                    ProtocolMessageCache& messages)
+{
+    LOG((CLOG_DEBUG1 "send key up to \"%s\" id=%d, mask=0x%04x", getName().c_str(), key, mask));
+    ProtocolUtil::writef(getStream(), messages, kMsgDKeyUp1_0, key, mask);
+}
+
+void ClientProxy1_0::getCounters(ClientCounters& counters) const
+{
+    counters.m_stream = getStream()->getCounters();
+    for (const auto& entry : m_messagesReceived) {
+        const char code[] = {
+            static_cast<char>((entry.first >> 24) & 0xff),
+            static_cast<char>((entry.first >> 16) & 0xff),
+            static_cast<char>((entry.first >> 8) & 0xff),
+            static_cast<char>(entry.first & 0xff)
+        };
+        counters.m_messagesReceived[std::string(code, sizeof(code))] = entry.second;
+    }
+    counters.m_clipboardBytesSent     = m_clipboardBytesSent;
+    counters.m_clipboardBytesReceived = m_clipboardBytesReceived;
+    counters.m_replacedMoves          = m_replacedMoves;
+}
+
 void
 ClientProxy1_0::mouseDown(ButtonID button)
 {
@@ -325,7 +361,7 @@ ClientProxy1_0::mouseUp(ButtonID button)
 void ClientProxy1_0::mouseMove(std::int32_t xAbs, std::int32_t yAbs)
 {
     LOG((CLOG_DEBUG2 "send mouse move to \"%s\" %d,%d", getName().c_str(), xAbs, yAbs));
-    ProtocolUtil::writef(getStream(), kMsgDMouseMove, xAbs, yAbs);
+    writeMouseMove(kMsgDMouseMove, xAbs, yAbs, false);
 }
 
 void ClientProxy1_0::mouseRelativeMove(std::int32_t, std::int32_t)
@@ -333,6 +369,37 @@ void ClientProxy1_0::mouseRelativeMove(std::int32_t, std::int32_t)
     // ignore -- not supported in protocol 1.0
 }
 
+void ClientProxy1_0::writeMouseMove(const char* fmt, std::int32_t x, std::int32_t y,
+                                    bool relative)
+{
+    // on a slow link the previous move may still be queued for sending.
+    // replacing it lets the client catch up instead of replaying a trail.
+    if (fmt == m_lastMoveFormat) {
+        std::int32_t xMove = relative ? m_lastMoveX + x : x;
+        std::int32_t yMove = relative ? m_lastMoveY + y : y;
+        if (xMove >= -32768 && xMove <= 32767 && yMove >= -32768 && yMove <= 32767) {
+            ProtocolUtil::formatf(m_nextMove, fmt, xMove, yMove);
+            if (m_nextMove.size() == m_lastMove.size() &&
+                    getStream()->replaceLastWrite(m_lastMove.data(), m_nextMove.data(),
+                                                  static_cast<std::uint32_t>(m_nextMove.size()))) {
+                m_lastMove.swap(m_nextMove);
+                m_lastMoveX = xMove;
+                m_lastMoveY = yMove;
+                ++m_replacedMoves;
+                LOG((CLOG_DEBUG2 "replaced unsent mouse move to \"%s\", %llu so far",
+                     getName().c_str(), static_cast<unsigned long long>(m_replacedMoves)));
+                return;
+            }
+        }
+    }
+
+    ProtocolUtil::formatf(m_lastMove, fmt, x, y);
+    getStream()->write(m_lastMove.data(), static_cast<std::uint32_t>(m_lastMove.size()));
+    m_lastMoveFormat = fmt;
+    m_lastMoveX = x;
+    m_lastMoveY = y;
+}
+
 void ClientProxy1_0::mouseWheel(std::int32_t, std::int32_t yDelta)
 {
     // clients prior to 1.3 only support the y axis
@@ -22,6 +22,9 @@
 #include "inputleap/Clipboard.h"
 #include "inputleap/protocol_types.h"
 
+#include <map>
+#include <vector>
+
 namespace inputleap {
 
 class Event;
@@ -61,6 +64,13 @@ public:
     void sendDragInfo(std::uint32_t fileCount, const char* info, size_t size) override;
     void fileChunkSending(std::uint8_t mark, const char* data, size_t dataSize) override;
 
+    // BaseClientProxy overrides
+    void broadcastKeyDown(KeyID, KeyModifierMask, KeyButton,
+                          ProtocolMessageCache& messages) override;
+    void broadcastKeyUp(KeyID, KeyModifierMask, KeyButton,
+                        ProtocolMessageCache& messages) override;
+    void getCounters(ClientCounters& counters) const override;
+
 protected:
     virtual bool parseHandshakeMessage(const std::uint8_t* code);
     virtual bool parseMessage(const std::uint8_t* code);
@@ -71,6 +81,11 @@ protected:
     virtual void addHeartbeatTimer();
     virtual void removeHeartbeatTimer();
     virtual bool recvClipboard();
+
+    // write a mouse move message.  if the previous move with the same
+    // format is still waiting to be sent it's replaced instead, by this
+    // position or, for relative moves, by the sum of both motions.
+    void writeMouseMove(const char* fmt, std::int32_t x, std::int32_t y, bool relative);
 private:
     void disconnect();
     void removeHandlers();
@@ -95,6 +110,8 @@ protected:
     };
 
     ClientClipboard m_clipboard[kClipboardEnd];
+    std::uint64_t m_clipboardBytesSent = 0;
+    std::uint64_t m_clipboardBytesReceived = 0;
 
 private:
     typedef bool (ClientProxy1_0::*MessageParser)(const std::uint8_t*);
@@ -104,6 +121,17 @@ private:
     EventQueueTimer* m_heartbeatTimer;
     MessageParser m_parser;
     IEventQueue* m_events;
+
+    // the last mouse move written and the space for formatting the next
+    const char* m_lastMoveFormat = nullptr;
+    std::int32_t m_lastMoveX = 0;
+    std::int32_t m_lastMoveY = 0;
+    std::vector<std::uint8_t> m_lastMove;
+    std::vector<std::uint8_t> m_nextMove;
+    std::uint64_t m_replacedMoves = 0;
+
+    // messages received by code, packed big endian
+    std::map<std::uint32_t, std::uint64_t> m_messagesReceived;
 };
 
 } // namespace inputleap
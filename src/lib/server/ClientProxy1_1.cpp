@@ -58,4 +58,18 @@ ClientProxy1_1::keyUp(KeyID key, KeyModifierMask mask, KeyButton button)
     ProtocolUtil::writef(getStream(), kMsgDKeyUp, key, mask, button);
 }
 
+void ClientProxy1_1::broadcastKeyDown(KeyID key, KeyModifierMask mask, KeyButton button,
+                                      ProtocolMessageCache& messages)
+{
+    LOG((CLOG_DEBUG1 "send key down to \"%s\" id=%d, mask=0x%04x, button=0x%04x", getName().c_str(), key, mask, button));
+    ProtocolUtil::writef(getStream(), messages, kMsgDKeyDown, key, mask, button);
+}
+
+void ClientProxy1_1::broadcastKeyUp(KeyID key, KeyModifierMask mask, KeyButton button,
+                                    ProtocolMessageCache& messages)
+{
+    LOG((CLOG_DEBUG1 "send key up to \"%s\" id=%d, mask=0x%04x, button=0x%04x", getName().c_str(), key, mask, button));
+    ProtocolUtil::writef(getStream(), messages, kMsgDKeyUp, key, mask, button);
+}
+
 } // namespace inputleap
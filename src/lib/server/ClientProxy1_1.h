@@ -32,6 +32,12 @@ public:
     void keyDown(KeyID, KeyModifierMask, KeyButton) override;
     void keyRepeat(KeyID, KeyModifierMask, std::int32_t count, KeyButton) override;
     void keyUp(KeyID, KeyModifierMask, KeyButton) override;
+
+    // BaseClientProxy overrides
+    void broadcastKeyDown(KeyID, KeyModifierMask, KeyButton,
+                          ProtocolMessageCache& messages) override;
+    void broadcastKeyUp(KeyID, KeyModifierMask, KeyButton,
+                        ProtocolMessageCache& messages) override;
 };
 
 } // namespace inputleap
@@ -38,7 +38,7 @@ ClientProxy1_2::~ClientProxy1_2()
 void ClientProxy1_2::mouseRelativeMove(std::int32_t xRel, std::int32_t yRel)
 {
     LOG((CLOG_DEBUG2 "send mouse relative move to \"%s\" %d,%d", getName().c_str(), xRel, yRel));
-    ProtocolUtil::writef(getStream(), kMsgDMouseRelMove, xRel, yRel);
+    writeMouseMove(kMsgDMouseRelMove, xRel, yRel, true);
 }
 
 } // namespace inputleap
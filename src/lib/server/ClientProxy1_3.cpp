@@ -54,6 +54,24 @@ bool ClientProxy1_3::parseMessage(const std::uint8_t* code)
     if (memcmp(code, kMsgCKeepAlive, 4) == 0) {
         // reset alarm
         resetHeartbeatTimer();
+
+        bool wasDegraded = m_linkQuality.is_degraded();
+        if (m_linkQuality.probe_answered(m_linkClock.getTime())) {
+            LOG((CLOG_DEBUG2 "round trip to \"%s\" %.1fms, jitter %.1fms", getName().c_str(),
+                 1000.0 * m_linkQuality.rtt(), 1000.0 * m_linkQuality.jitter()));
+            if (m_linkQuality.is_degraded() != wasDegraded) {
+                if (m_linkQuality.is_degraded()) {
+                    LOG((CLOG_WARN "link to \"%s\" degraded: round trip %.0fms, jitter %.0fms",
+                         getName().c_str(), 1000.0 * m_linkQuality.rtt(),
+                         1000.0 * m_linkQuality.jitter()));
+                }
+                else {
+                    LOG((CLOG_NOTE "link to \"%s\" recovered: round trip %.0fms, jitter %.0fms",
+                         getName().c_str(), 1000.0 * m_linkQuality.rtt(),
+                         1000.0 * m_linkQuality.jitter()));
+                }
+            }
+        }
         return true;
     }
     else {
@@ -61,6 +79,11 @@ bool ClientProxy1_3::parseMessage(const std::uint8_t* code)
     }
 }
 
+const LinkQuality* ClientProxy1_3::getLinkQuality() const
+{
+    return &m_linkQuality;
+}
+
 void
 ClientProxy1_3::resetHeartbeatRate()
 {
@@ -118,6 +141,7 @@ void ClientProxy1_3::handle_keep_alive()
 void
 ClientProxy1_3::keepAlive()
 {
+    m_linkQuality.probe_sent(m_linkClock.getTime());
     ProtocolUtil::writef(getStream(), kMsgCKeepAlive);
 }
 
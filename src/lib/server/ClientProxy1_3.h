@@ -19,6 +19,8 @@
 #pragma once
 
 #include "server/ClientProxy1_2.h"
+#include "server/LinkQuality.h"
+#include "base/Stopwatch.h"
 
 namespace inputleap {
 
@@ -31,6 +33,9 @@ public:
     // IClient overrides
     void mouseWheel(std::int32_t xDelta, std::int32_t yDelta) override;
 
+    // BaseClientProxy overrides
+    const LinkQuality* getLinkQuality() const override;
+
     void handle_keep_alive();
 
 protected:
@@ -47,6 +52,10 @@ private:
     double m_keepAliveRate;
     EventQueueTimer* m_keepAliveTimer;
     IEventQueue* m_events;
+
+    // keep alives are answered right away, so they double as round-trip probes
+    LinkQuality m_linkQuality;
+    Stopwatch m_linkClock;
 };
 
 } // namespace inputleap
@@ -52,6 +52,7 @@ ClientProxy1_6::setClipboard(ClipboardID id, const IClipboard* clipboard)
 
         size_t size = data.size();
         LOG((CLOG_DEBUG "sending clipboard %d to \"%s\"", id, getName().c_str()));
+        m_clipboardBytesSent += size;
 
         StreamChunker::sendClipboard(data, size, id, 0, m_events, this);
     }
@@ -79,6 +80,8 @@ ClientProxy1_6::recvClipboard()
     else if (r == kFinish) {
         LOG((CLOG_DEBUG "received client \"%s\" clipboard %d seqnum=%d, size=%d",
                 getName().c_str(), id, seq, dataCached.size()));
+        m_clipboardBytesReceived += dataCached.size();
+
         // save clipboard
         m_clipboard[id].m_clipboard.unmarshall(dataCached, 0);
         m_clipboard[id].m_sequenceNumber = seq;
@@ -614,6 +614,24 @@ Config::getInputFilter()
 	return &m_inputFilter;
 }
 
+const InputFilter* Config::getInputFilter() const
+{
+	return &m_inputFilter;
+}
+
+void Config::update(const Config& config)
+{
+	if (&config == this) {
+		return;
+	}
+	m_map = config.m_map;
+	m_nameToCanonicalName = config.m_nameToCanonicalName;
+	listen_address_ = config.listen_address_;
+	m_globalOptions = config.m_globalOptions;
+	m_hasLockToScreenAction = config.m_hasLockToScreenAction;
+	m_inputFilter.updateRules(config.m_inputFilter);
+}
+
 std::string Config::formatInterval(const Interval& x)
 {
 	if (x.first == 0.0f && x.second == 1.0f) {
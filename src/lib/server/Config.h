@@ -314,6 +314,14 @@ public:
     */
     virtual InputFilter* getInputFilter();
 
+    //! Update configuration
+    /*!
+    Makes this configuration equal to \c config.  Unlike assignment, the
+    filter rules found in both configurations are kept as they are, so
+    their hotkeys stay registered on the primary screen.
+    */
+    void update(const Config& config);
+
     //@}
     //! @name accessors
     //@{
@@ -394,6 +402,9 @@ public:
     */
     const ScreenOptions* getOptions(const std::string& name) const;
 
+    //! Get the hot key input filter
+    const InputFilter* getInputFilter() const;
+
     //! Check for lock to screen action
     /*!
     Returns \c true if this configuration has a lock to screen action.
@@ -0,0 +1,167 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "server/ConfigDiff.h"
+#include "server/Config.h"
+
+#include <utility>
+#include <vector>
+
+namespace inputleap {
+
+namespace {
+
+using inputleap::string::CaselessCmp;
+
+bool same_links(const Config& from, const Config& to, const std::string& screen)
+{
+    auto i = from.beginNeighbor(screen);
+    auto j = to.beginNeighbor(screen);
+    for (; i != from.endNeighbor(screen) && j != to.endNeighbor(screen); ++i, ++j) {
+        // CellEdge comparison ignores names so compare the destination's
+        if (i->first != j->first || i->second != j->second ||
+                !CaselessCmp::equal(i->second.getName(), j->second.getName())) {
+            return false;
+        }
+    }
+    return i == from.endNeighbor(screen) && j == to.endNeighbor(screen);
+}
+
+std::vector<std::pair<std::string, std::string>> get_aliases(const Config& config)
+{
+    std::vector<std::pair<std::string, std::string>> aliases;
+    for (auto i = config.beginAll(); i != config.endAll(); ++i) {
+        if (!CaselessCmp::equal(i->first, i->second)) {
+            aliases.push_back(*i);
+        }
+    }
+    return aliases;
+}
+
+bool same_aliases(const Config& from, const Config& to)
+{
+    auto a = get_aliases(from);
+    auto b = get_aliases(to);
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (!CaselessCmp::equal(a[i].first, b[i].first) ||
+                !CaselessCmp::equal(a[i].second, b[i].second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void append(std::string& s, const std::string& what)
+{
+    if (!s.empty()) {
+        s += "; ";
+    }
+    s += what;
+}
+
+void append(std::string& s, const char* what, const ConfigDiff::ScreenSet& screens)
+{
+    if (screens.empty()) {
+        return;
+    }
+    std::string names;
+    for (const auto& screen : screens) {
+        if (!names.empty()) {
+            names += ", ";
+        }
+        names += screen;
+    }
+    append(s, std::string(what) + " " + names);
+}
+
+} // namespace
+
+ConfigDiff::ConfigDiff(const Config& from, const Config& to)
+{
+    for (const auto& screen : from) {
+        if (!to.isCanonicalName(screen)) {
+            removed_screens_.insert(screen);
+        }
+    }
+    for (const auto& screen : to) {
+        if (!from.isCanonicalName(screen)) {
+            added_screens_.insert(screen);
+            continue;
+        }
+        if (!links_changed_ && !same_links(from, to, screen)) {
+            links_changed_ = true;
+        }
+        if (*from.getOptions(screen) != *to.getOptions(screen)) {
+            changed_options_screens_.insert(screen);
+        }
+    }
+
+    aliases_changed_ = !same_aliases(from, to);
+    global_options_changed_ = *from.getOptions("") != *to.getOptions("");
+
+    // rules are tried in order so a reordering is a change, too
+    filter_changed_ = from.getInputFilter()->format("") != to.getInputFilter()->format("");
+    listen_address_changed_ = from.get_listen_address() != to.get_listen_address();
+}
+
+bool ConfigDiff::empty() const
+{
+    return !topology_changed() && changed_options_screens_.empty() && !global_options_changed_ &&
+            !filter_changed_ && !listen_address_changed_;
+}
+
+bool ConfigDiff::topology_changed() const
+{
+    return !removed_screens_.empty() || !added_screens_.empty() || links_changed_ ||
+            aliases_changed_;
+}
+
+bool ConfigDiff::options_changed(const std::string& screen) const
+{
+    return global_options_changed_ ||
+            changed_options_screens_.count(screen) != 0 ||
+            added_screens_.count(screen) != 0;
+}
+
+std::string ConfigDiff::to_string() const
+{
+    std::string s;
+    append(s, "removed screens", removed_screens_);
+    append(s, "added screens", added_screens_);
+    if (links_changed_) {
+        append(s, "links");
+    }
+    if (aliases_changed_) {
+        append(s, "aliases");
+    }
+    if (global_options_changed_) {
+        append(s, "global options");
+    }
+    append(s, "options of", changed_options_screens_);
+    if (filter_changed_) {
+        append(s, "filter rules");
+    }
+    if (listen_address_changed_) {
+        append(s, "listen address");
+    }
+    return s.empty() ? "no changes" : s;
+}
+
+} // namespace inputleap
@@ -0,0 +1,97 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "base/String.h"
+
+#include <set>
+#include <string>
+
+namespace inputleap {
+
+class Config;
+
+//! Differences between two server configurations
+/*!
+Compares a configuration with the one replacing it, so that a reloaded
+configuration can be applied by changing only what differs.  Screens are
+referred to by their canonical names.
+*/
+class ConfigDiff {
+public:
+    typedef std::set<std::string, inputleap::string::CaselessCmp> ScreenSet;
+
+    ConfigDiff(const Config& from, const Config& to);
+
+    //! @name accessors
+    //@{
+
+    //! Check for differences
+    bool empty() const;
+
+    //! Get the screens that are only in the old configuration
+    const ScreenSet& removed_screens() const { return removed_screens_; }
+
+    //! Get the screens that are only in the new configuration
+    const ScreenSet& added_screens() const { return added_screens_; }
+
+    //! Get the screens in both configurations whose own options differ
+    const ScreenSet& changed_options_screens() const { return changed_options_screens_; }
+
+    //! Check if links between screens in both configurations differ
+    bool links_changed() const { return links_changed_; }
+
+    //! Check if aliases differ
+    bool aliases_changed() const { return aliases_changed_; }
+
+    //! Check if the screens, their links or their aliases differ
+    bool topology_changed() const;
+
+    //! Check if the global options differ
+    bool global_options_changed() const { return global_options_changed_; }
+
+    //! Check if the options a screen is sent differ
+    /*!
+    A screen is sent its own options followed by the global options.
+    Returns true if either differ or if the screen is new.
+    */
+    bool options_changed(const std::string& screen) const;
+
+    //! Check if the input filter rules or their order differ
+    bool filter_changed() const { return filter_changed_; }
+
+    //! Check if the listen address differs
+    bool listen_address_changed() const { return listen_address_changed_; }
+
+    //! Describe the differences for logging
+    std::string to_string() const;
+
+    //@}
+
+private:
+    ScreenSet removed_screens_;
+    ScreenSet added_screens_;
+    ScreenSet changed_options_screens_;
+    bool links_changed_ = false;
+    bool aliases_changed_ = false;
+    bool global_options_changed_ = false;
+    bool filter_changed_ = false;
+    bool listen_address_changed_ = false;
+};
+
+} // namespace inputleap
@@ -28,6 +28,10 @@
 
 namespace inputleap {
 
+// modifiers that cannot be combined with a mouse button
+static const KeyModifierMask s_buttonIgnoreMask =
+    KeyModifierAltGr | KeyModifierCapsLock | KeyModifierNumLock | KeyModifierScrollLock;
+
 // -----------------------------------------------------------------------------
 // Input Filter Condition Classes
 // -----------------------------------------------------------------------------
@@ -53,6 +57,11 @@ InputFilter::Condition::disablePrimary(PrimaryClient*)
     // do nothing
 }
 
+bool InputFilter::Condition::getIndexKeys(std::vector<IndexKey>&) const
+{
+    return false;
+}
+
 InputFilter::KeystrokeCondition::KeystrokeCondition(IEventQueue* events,
                                                     const IPlatformScreen::KeyInfo& info) :
     m_id(0),
@@ -139,6 +148,13 @@ InputFilter::KeystrokeCondition::disablePrimary(PrimaryClient* primary)
     m_id = 0;
 }
 
+bool InputFilter::KeystrokeCondition::getIndexKeys(std::vector<IndexKey>& keys) const
+{
+    keys.push_back({EventType::PRIMARY_SCREEN_HOTKEY_DOWN, m_id, 0});
+    keys.push_back({EventType::PRIMARY_SCREEN_HOTKEY_UP, m_id, 0});
+    return true;
+}
+
 InputFilter::MouseButtonCondition::MouseButtonCondition(IEventQueue* events,
                                                         const IPrimaryScreen::ButtonInfo& info) :
     m_button(info.m_button),
@@ -191,10 +207,6 @@ std::string InputFilter::MouseButtonCondition::format() const
 InputFilter::EFilterStatus
 InputFilter::MouseButtonCondition::match(const Event& event)
 {
-    static const KeyModifierMask s_ignoreMask =
-        KeyModifierAltGr | KeyModifierCapsLock |
-        KeyModifierNumLock | KeyModifierScrollLock;
-
     EFilterStatus status;
 
     // check for hotkey events
@@ -211,13 +223,20 @@ InputFilter::MouseButtonCondition::match(const Event& event)
     // check if it's the right button and modifiers.  ignore modifiers
     // that cannot be combined with a mouse button.
     const auto& minfo = event.get_data_as<IPlatformScreen::ButtonInfo>();
-    if (minfo.m_button != m_button || (minfo.m_mask & ~s_ignoreMask) != m_mask) {
+    if (minfo.m_button != m_button || (minfo.m_mask & ~s_buttonIgnoreMask) != m_mask) {
         return kNoMatch;
     }
 
     return status;
 }
 
+bool InputFilter::MouseButtonCondition::getIndexKeys(std::vector<IndexKey>& keys) const
+{
+    keys.push_back({EventType::PRIMARY_SCREEN_BUTTON_DOWN, m_button, m_mask});
+    keys.push_back({EventType::PRIMARY_SCREEN_BUTTON_UP, m_button, m_mask});
+    return true;
+}
+
 InputFilter::ScreenConnectedCondition::ScreenConnectedCondition(IEventQueue* events,
                                                                 const std::string& screen) :
     m_screen(screen),
@@ -255,6 +274,12 @@ InputFilter::ScreenConnectedCondition::match(const Event& event)
     return kNoMatch;
 }
 
+bool InputFilter::ScreenConnectedCondition::getIndexKeys(std::vector<IndexKey>& keys) const
+{
+    keys.push_back({EventType::SERVER_CONNECTED, 0, 0});
+    return true;
+}
+
 // -----------------------------------------------------------------------------
 // Input Filter Action Classes
 // -----------------------------------------------------------------------------
@@ -314,6 +339,7 @@ InputFilter::LockCursorToScreenAction::perform(const Event& event)
 InputFilter::SwitchToScreenAction::SwitchToScreenAction(IEventQueue* events,
                                                         const std::string& screen) :
     m_screen(screen),
+    m_screenId(screen.empty() ? kNoScreenId : ScreenIds::intern(screen)),
     m_events(events)
 {
     // do nothing
@@ -341,13 +367,15 @@ InputFilter::SwitchToScreenAction::perform(const Event& event)
     // pick screen name.  if m_screen is empty then use the screen from
     // event if it has one.
     std::string screen = m_screen;
+    ScreenId screenId = m_screenId;
     if (screen.empty() && event.getType() == EventType::SERVER_CONNECTED) {
         const auto& info = event.get_data_as<Server::ScreenConnectedInfo>();
         screen = info.m_screen;
+        screenId = ScreenIds::intern(screen);
     }
 
     // send event
-    Server::SwitchToScreenInfo info{screen};
+    Server::SwitchToScreenInfo info{screenId, screen};
     m_events->add_event(EventType::SERVER_SWITCH_TO_SCREEN, event.getTarget(),
                         create_event_data<Server::SwitchToScreenInfo>(info),
                         Event::kDeliverImmediately);
@@ -431,6 +459,7 @@ InputFilter::KeyboardBroadcastAction::KeyboardBroadcastAction(IEventQueue* event
                                                               const std::set<std::string>& screens) :
     m_mode(mode),
     m_screens(IKeyState::KeyInfo::join(screens)),
+    m_screenIds(ScreenIdSet::from_names(screens)),
     m_events(events)
 {
     // do nothing
@@ -480,7 +509,7 @@ InputFilter::KeyboardBroadcastAction::perform(const Event& event)
     };
 
     // send event
-    Server::KeyboardBroadcastInfo info{s_state[m_mode], m_screens};
+    Server::KeyboardBroadcastInfo info{s_state[m_mode], m_screenIds};
     m_events->add_event(EventType::SERVER_KEYBOARD_BROADCAST, event.getTarget(),
                         create_event_data<Server::KeyboardBroadcastInfo>(info),
                         Event::kDeliverImmediately);
@@ -630,6 +659,17 @@ InputFilter::Rule::Rule(const Rule& rule) :
     copy(rule);
 }
 
+InputFilter::Rule::Rule(Rule&& rule) noexcept :
+    m_condition(rule.m_condition),
+    m_activateActions(std::move(rule.m_activateActions)),
+    m_deactivateActions(std::move(rule.m_deactivateActions))
+{
+    // the moved rule keeps its condition's state, e.g. a registered hotkey
+    rule.m_condition = nullptr;
+    rule.m_activateActions.clear();
+    rule.m_deactivateActions.clear();
+}
+
 InputFilter::Rule::~Rule()
 {
     clear();
@@ -644,6 +684,18 @@ InputFilter::Rule::operator=(const Rule& rule)
     return *this;
 }
 
+InputFilter::Rule& InputFilter::Rule::operator=(Rule&& rule) noexcept
+{
+    if (&rule != this) {
+        clear();
+        m_condition = rule.m_condition;
+        m_activateActions.swap(rule.m_activateActions);
+        m_deactivateActions.swap(rule.m_deactivateActions);
+        rule.m_condition = nullptr;
+    }
+    return *this;
+}
+
 void
 InputFilter::Rule::clear()
 {
@@ -871,6 +923,7 @@ InputFilter::operator=(const InputFilter& x)
         setPrimaryClient(nullptr);
 
         m_ruleList = x.m_ruleList;
+        m_ruleIndexValid = false;
 
         setPrimaryClient(oldClient);
     }
@@ -884,6 +937,7 @@ InputFilter::addFilterRule(const Rule& rule)
     if (m_primaryClient != nullptr) {
         m_ruleList.back().enable(m_primaryClient);
     }
+    m_ruleIndexValid = false;
 }
 
 void InputFilter::removeFilterRule(std::uint32_t index)
@@ -892,10 +946,68 @@ void InputFilter::removeFilterRule(std::uint32_t index)
         m_ruleList[index].disable(m_primaryClient);
     }
     m_ruleList.erase(m_ruleList.begin() + index);
+    m_ruleIndexValid = false;
+}
+
+void InputFilter::updateRules(const InputFilter& x)
+{
+    if (&x == this) {
+        return;
+    }
+
+    // find the current rule, if any, that each new rule is identical to
+    std::unordered_multimap<std::string, std::uint32_t> current;
+    for (std::uint32_t i = 0; i < m_ruleList.size(); ++i) {
+        current.emplace(m_ruleList[i].format(), i);
+    }
+    const std::uint32_t kNew = static_cast<std::uint32_t>(m_ruleList.size());
+    std::vector<std::uint32_t> source;
+    source.reserve(x.m_ruleList.size());
+    for (const Rule& rule : x.m_ruleList) {
+        auto match = current.find(rule.format());
+        if (match != current.end()) {
+            source.push_back(match->second);
+            current.erase(match);
+        }
+        else {
+            source.push_back(kNew);
+        }
+    }
+
+    // disable the dropped rules before enabling the added ones, which may
+    // want the same hotkeys
+    if (m_primaryClient != nullptr) {
+        for (const auto& dropped : current) {
+            m_ruleList[dropped.second].disable(m_primaryClient);
+        }
+    }
+
+    RuleList rules;
+    rules.reserve(x.m_ruleList.size());
+    std::uint32_t kept = 0;
+    for (std::uint32_t i = 0; i < source.size(); ++i) {
+        if (source[i] != kNew) {
+            rules.push_back(std::move(m_ruleList[source[i]]));
+            ++kept;
+        }
+        else {
+            rules.push_back(x.m_ruleList[i]);
+            if (m_primaryClient != nullptr) {
+                rules.back().enable(m_primaryClient);
+            }
+        }
+    }
+    LOG((CLOG_DEBUG "input filter: kept %u rules, removed %u, added %u", kept,
+         static_cast<std::uint32_t>(current.size()), static_cast<std::uint32_t>(rules.size()) - kept));
+
+    m_ruleList.swap(rules);
+    m_ruleIndexValid = false;
 }
 
 InputFilter::Rule& InputFilter::getRule(std::uint32_t index)
 {
+    // the caller may change the condition
+    m_ruleIndexValid = false;
     return m_ruleList[index];
 }
 
@@ -923,6 +1035,7 @@ InputFilter::setPrimaryClient(PrimaryClient* client)
     }
 
     m_primaryClient = client;
+    m_ruleIndexValid = false;
 
     if (m_primaryClient != nullptr) {
         auto event_target = m_primaryClient->getEventTarget();
@@ -1003,10 +1116,26 @@ void InputFilter::handle_event(const Event& event)
     Event myEvent(event.getType(), this, nullptr, event.getFlags() | Event::kDeliverImmediately);
     myEvent.clone_data_from(event);
 
-    // let each rule try to match the event until one does
-    for (RuleList::iterator rule  = m_ruleList.begin();
-                             rule != m_ruleList.end(); ++rule) {
-        if (rule->handleEvent(myEvent)) {
+    if (!m_ruleIndexValid) {
+        buildRuleIndex();
+    }
+
+    // let each rule that can match the event try to, in rule order, until
+    // one does.  the rules that must see every event are merged in.
+    static const RuleIndices s_noRules;
+    auto indexed = m_ruleIndex.find(getEventIndexKey(event));
+    const RuleIndices& candidates = (indexed == m_ruleIndex.end()) ? s_noRules : indexed->second;
+    RuleIndices::const_iterator i = candidates.begin();
+    RuleIndices::const_iterator j = m_unindexedRules.begin();
+    while (i != candidates.end() || j != m_unindexedRules.end()) {
+        std::uint32_t rule;
+        if (j == m_unindexedRules.end() || (i != candidates.end() && *i < *j)) {
+            rule = *i++;
+        }
+        else {
+            rule = *j++;
+        }
+        if (m_ruleList[rule].handleEvent(myEvent)) {
             // handled
             return;
         }
@@ -1016,4 +1145,50 @@ void InputFilter::handle_event(const Event& event)
     m_events->add_event(std::move(myEvent));
 }
 
+void InputFilter::buildRuleIndex()
+{
+    m_ruleIndex.clear();
+    m_unindexedRules.clear();
+
+    std::vector<IndexKey> keys;
+    for (std::uint32_t rule = 0; rule < m_ruleList.size(); ++rule) {
+        const Condition* condition = m_ruleList[rule].getCondition();
+        if (condition == nullptr) {
+            // never matches
+            continue;
+        }
+        keys.clear();
+        if (!condition->getIndexKeys(keys)) {
+            m_unindexedRules.push_back(rule);
+            continue;
+        }
+        for (const IndexKey& key : keys) {
+            RuleIndices& rules = m_ruleIndex[key];
+            if (rules.empty() || rules.back() != rule) {
+                rules.push_back(rule);
+            }
+        }
+    }
+    m_ruleIndexValid = true;
+}
+
+InputFilter::IndexKey InputFilter::getEventIndexKey(const Event& event)
+{
+    EventType type = event.getType();
+    switch (type) {
+    case EventType::PRIMARY_SCREEN_HOTKEY_DOWN:
+    case EventType::PRIMARY_SCREEN_HOTKEY_UP:
+        return {type, event.get_data_as<IPlatformScreen::HotKeyInfo>().m_id, 0};
+
+    case EventType::PRIMARY_SCREEN_BUTTON_DOWN:
+    case EventType::PRIMARY_SCREEN_BUTTON_UP: {
+        const auto& info = event.get_data_as<IPlatformScreen::ButtonInfo>();
+        return {type, info.m_button, info.m_mask & ~s_buttonIgnoreMask};
+    }
+
+    default:
+        return {type, 0, 0};
+    }
+}
+
 } // namespace inputleap
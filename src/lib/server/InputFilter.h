@@ -25,6 +25,8 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace inputleap {
 
@@ -43,6 +45,23 @@ public:
         kDeactivate
     };
 
+    //! Key of the rule index
+    /*!
+    Identifies the events a condition can match: the event type and, for
+    hotkey and mouse button events, the hotkey id or the button and its
+    modifiers.
+    */
+    struct IndexKey {
+        EventType m_type;
+        std::uint32_t m_id;
+        KeyModifierMask m_mask;
+
+        bool operator==(const IndexKey& other) const
+        {
+            return m_type == other.m_type && m_id == other.m_id && m_mask == other.m_mask;
+        }
+    };
+
     class Condition {
     public:
         Condition();
@@ -55,6 +74,11 @@ public:
 
         virtual void enablePrimary(PrimaryClient*);
         virtual void disablePrimary(PrimaryClient*);
+
+        // add the keys of all events that match() may not return kNoMatch
+        // for.  returns false if the condition must be tried on every
+        // event instead.  only valid while the primary is enabled.
+        virtual bool getIndexKeys(std::vector<IndexKey>& keys) const;
     };
 
     // KeystrokeCondition
@@ -73,6 +97,7 @@ public:
         EFilterStatus match(const Event&) override;
         void enablePrimary(PrimaryClient*) override;
         void disablePrimary(PrimaryClient*) override;
+        bool getIndexKeys(std::vector<IndexKey>& keys) const override;
 
     private:
         std::uint32_t m_id;
@@ -95,6 +120,7 @@ public:
         Condition* clone() const override;
         std::string format() const override;
         EFilterStatus match(const Event&) override;
+        bool getIndexKeys(std::vector<IndexKey>& keys) const override;
 
     private:
         ButtonID m_button;
@@ -112,6 +138,7 @@ public:
         Condition* clone() const override;
         std::string format() const override;
         EFilterStatus match(const Event&) override;
+        bool getIndexKeys(std::vector<IndexKey>& keys) const override;
 
     private:
         std::string m_screen;
@@ -166,6 +193,7 @@ public:
 
     private:
         std::string m_screen;
+        ScreenId m_screenId;
         IEventQueue* m_events;
     };
 
@@ -219,6 +247,7 @@ public:
     private:
         Mode m_mode;
         std::string m_screens;
+        ScreenIdSet m_screenIds;
         IEventQueue* m_events;
     };
 
@@ -274,9 +303,11 @@ public:
         Rule();
         Rule(Condition* adopted);
         Rule(const Rule&);
+        Rule(Rule&&) noexcept;
         ~Rule();
 
         Rule& operator=(const Rule&);
+        Rule& operator=(Rule&&) noexcept;
 
         // replace the condition
         void setCondition(Condition* adopted);
@@ -342,7 +373,12 @@ public:
     // remove a rule
     void removeFilterRule(std::uint32_t index);
 
-    // get rule by index
+    // replace the rules with those of another filter, in its order.  rules
+    // found in both filters are kept as they are, so their hotkeys stay
+    // registered, and only the other rules are disabled or enabled.
+    void updateRules(const InputFilter&);
+
+    // get rule by index.  the rule may be modified.
     Rule& getRule(std::uint32_t index);
 
     // enable event filtering using the given primary client.  disable
@@ -364,10 +400,30 @@ private:
     // event handling
     void handle_event(const Event&);
 
+    // map events to the rules that can match them
+    void buildRuleIndex();
+    static IndexKey getEventIndexKey(const Event&);
+
+    struct IndexKeyHash {
+        std::size_t operator()(const IndexKey& key) const
+        {
+            return (static_cast<std::size_t>(key.m_type) * 31 + key.m_id) * 31 + key.m_mask;
+        }
+    };
+
+    typedef std::vector<std::uint32_t> RuleIndices;
+
 private:
     RuleList m_ruleList;
     PrimaryClient* m_primaryClient;
     IEventQueue* m_events;
+
+    // the rules that can match events with a key, and the rules that must
+    // be tried on every event, each in m_ruleList order.  rebuilt before
+    // handling an event after the rules or the primary client changed.
+    std::unordered_map<IndexKey, RuleIndices, IndexKeyHash> m_ruleIndex;
+    RuleIndices m_unindexedRules;
+    bool m_ruleIndexValid = false;
 };
 
 } // namespace inputleap
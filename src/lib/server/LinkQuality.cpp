@@ -0,0 +1,82 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "server/LinkQuality.h"
+
+#include <cmath>
+
+namespace inputleap {
+
+constexpr double LinkQuality::kDegradedDelay;
+constexpr double LinkQuality::kRecoveredDelay;
+
+void LinkQuality::probe_sent(double time)
+{
+    // an unanswered probe is as good as lost, measure from the newer ones
+    if (outstanding_.size() == kMaxOutstanding) {
+        outstanding_.pop_front();
+    }
+    outstanding_.push_back(time);
+}
+
+bool LinkQuality::probe_answered(double time)
+{
+    if (outstanding_.empty()) {
+        return false;
+    }
+    double sent = outstanding_.front();
+    outstanding_.pop_front();
+    add_sample(time > sent ? time - sent : 0.0);
+    return true;
+}
+
+void LinkQuality::reset()
+{
+    outstanding_.clear();
+    rtt_ = 0.0;
+    jitter_ = 0.0;
+    samples_ = 0;
+    degraded_ = false;
+}
+
+void LinkQuality::add_sample(double rtt)
+{
+    if (samples_ == 0) {
+        rtt_ = rtt;
+        jitter_ = rtt / 2.0;
+    }
+    else {
+        jitter_ += (std::fabs(rtt_ - rtt) - jitter_) / 4.0;
+        rtt_ += (rtt - rtt_) / 8.0;
+    }
+    ++samples_;
+
+    // the first estimates are too rough to judge the link
+    if (samples_ < kMinSamples) {
+        return;
+    }
+
+    double delay = rtt_ + 4.0 * jitter_;
+    if (!degraded_ && delay > kDegradedDelay) {
+        degraded_ = true;
+    }
+    else if (degraded_ && delay < kRecoveredDelay) {
+        degraded_ = false;
+    }
+}
+
+} // namespace inputleap
@@ -0,0 +1,89 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+namespace inputleap {
+
+//! Round-trip time estimate of a client link
+/*!
+Measures the time between sending a probe to a client and the client's answer and smooths the
+samples the way TCP does (RFC 6298): the round-trip time with a gain of 1/8 and its mean
+deviation, the jitter, with a gain of 1/4.  Probes are answered in the order they were sent.
+
+The link is considered degraded when the expected worst round trip, rtt() + 4 * jitter(),
+exceeds kDegradedDelay, and recovered once it falls below kRecoveredDelay.  The first few
+samples are not judged.
+*/
+class LinkQuality {
+public:
+    //! Expected worst round trip in seconds above which the link is degraded
+    static constexpr double kDegradedDelay = 0.25;
+
+    //! Expected worst round trip in seconds below which a degraded link has recovered
+    static constexpr double kRecoveredDelay = 0.125;
+
+    //! @name manipulators
+    //@{
+
+    //! Record that a probe was sent at \p time seconds
+    void probe_sent(double time);
+
+    //! Record that the oldest outstanding probe was answered at \p time seconds
+    /*!
+    Returns false if no probe was outstanding.
+    */
+    bool probe_answered(double time);
+
+    //! Forget the estimate and any outstanding probes
+    void reset();
+
+    //@}
+    //! @name accessors
+    //@{
+
+    //! Smoothed round-trip time in seconds
+    double rtt() const { return rtt_; }
+
+    //! Smoothed mean deviation of the round-trip time in seconds
+    double jitter() const { return jitter_; }
+
+    //! Number of answered probes
+    std::uint64_t samples() const { return samples_; }
+
+    //! Returns true if the link is degraded
+    bool is_degraded() const { return degraded_; }
+
+    //@}
+
+private:
+    static const std::size_t kMaxOutstanding = 8;
+    static const std::uint64_t kMinSamples = 4;
+
+    void add_sample(double rtt);
+
+    std::deque<double> outstanding_;
+    double rtt_ = 0.0;
+    double jitter_ = 0.0;
+    std::uint64_t samples_ = 0;
+    bool degraded_ = false;
+};
+
+} // namespace inputleap
@@ -0,0 +1,116 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "server/ScreenTopology.h"
+#include "server/Config.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace inputleap {
+
+ScreenTopology::ScreenTopology(const Config& config)
+{
+    // screens are referred to by the id of their canonical name
+    std::vector<std::string> names;
+    for (Config::const_iterator i = config.begin(); i != config.end(); ++i) {
+        ScreenId id = ScreenIds::intern(*i);
+        ids_[*i] = id;
+        if (id >= names.size()) {
+            names.resize(id + 1);
+        }
+        names[id] = *i;
+        size_++;
+    }
+    for (Config::all_const_iterator i = config.beginAll(); i != config.endAll(); ++i) {
+        ids_[i->first] = ids_[i->second];
+    }
+
+    // the links of a cell are sorted by side and then by start, which is
+    // the order of our edges.  ids without a screen get empty edges.
+    edge_begin_.reserve(names.size() * kNumDirections + 1);
+    for (ScreenId screen = 0; screen < names.size(); screen++) {
+        if (names[screen].empty()) {
+            edge_begin_.insert(edge_begin_.end(), kNumDirections,
+                               static_cast<std::uint32_t>(links_.size()));
+            continue;
+        }
+        Config::link_const_iterator link = config.beginNeighbor(names[screen]);
+        Config::link_const_iterator end = config.endNeighbor(names[screen]);
+        for (int side = kFirstDirection; side <= kLastDirection; side++) {
+            edge_begin_.push_back(static_cast<std::uint32_t>(links_.size()));
+            for (; link != end && link->first.getSide() == side; ++link) {
+                Config::Interval src = link->first.getInterval();
+                Config::Interval dst = link->second.getInterval();
+                links_.push_back({src.first, src.second, dst.first, dst.second,
+                                  find(link->second.getName())});
+            }
+        }
+        assert(link == end);
+    }
+    edge_begin_.push_back(static_cast<std::uint32_t>(links_.size()));
+}
+
+ScreenId ScreenTopology::find(const std::string& name) const
+{
+    auto i = ids_.find(name);
+    return i == ids_.end() ? kNoScreenId : i->second;
+}
+
+ScreenId ScreenTopology::neighbor(ScreenId screen, EDirection side, float position,
+                                  float* position_out) const
+{
+    assert(side >= kFirstDirection && side <= kLastDirection);
+
+    if (edge(screen, side) + 1 >= edge_begin_.size()) {
+        return kNoScreenId;
+    }
+
+    auto begin = links_.begin() + edge_begin_[edge(screen, side)];
+    auto end = links_.begin() + edge_begin_[edge(screen, side) + 1];
+
+    // find the last link that starts at or before the position
+    auto link = std::upper_bound(begin, end, position, [](float p, const Link& l) {
+        return p < l.src_start;
+    });
+    if (link == begin) {
+        return kNoScreenId;
+    }
+    --link;
+    if (position >= link->src_end || link->dst == kNoScreenId) {
+        return kNoScreenId;
+    }
+
+    // same arithmetic as CellEdge::transform() and inverseTransform()
+    if (position_out != nullptr) {
+        float t = (position - link->src_start) / (link->src_end - link->src_start);
+        *position_out = t * (link->dst_end - link->dst_start) + link->dst_start;
+    }
+    return link->dst;
+}
+
+bool ScreenTopology::has_neighbor(ScreenId screen, EDirection side) const
+{
+    assert(side >= kFirstDirection && side <= kLastDirection);
+
+    if (edge(screen, side) + 1 >= edge_begin_.size()) {
+        return false;
+    }
+    return edge_begin_[edge(screen, side)] != edge_begin_[edge(screen, side) + 1];
+}
+
+} // namespace inputleap
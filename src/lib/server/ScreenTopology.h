@@ -0,0 +1,99 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "base/String.h"
+#include "inputleap/ScreenId.h"
+#include "inputleap/protocol_types.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace inputleap {
+
+class Config;
+
+//! Precompiled screen links of a configuration
+/*!
+An immutable copy of the links of a Config in which screens are referred
+to by their ScreenId.  The links on each side of a screen are kept sorted
+by their start so the link at a position is found with a binary search.
+Looking up a neighbor does no string work; names are only needed to find
+the id of a screen.
+*/
+class ScreenTopology {
+public:
+    ScreenTopology() = default;
+    explicit ScreenTopology(const Config& config);
+
+    //! @name accessors
+    //@{
+
+    //! Get the number of screens
+    std::size_t size() const { return size_; }
+
+    //! Find a screen
+    /*!
+    Returns the id of the screen with the given name or alias, or
+    \c kNoScreenId if there is no such screen in the configuration.
+    */
+    ScreenId find(const std::string& name) const;
+
+    //! Get neighbor
+    /*!
+    Returns the neighbor of \c screen on \c side at \c position, which is
+    a fraction of the side, or \c kNoScreenId if there is none.  Saves the
+    position on the neighbor in \c position_out if it's not \c nullptr.
+    Behaves like Config::getNeighbor().
+    */
+    ScreenId neighbor(ScreenId screen, EDirection side, float position, float* position_out) const;
+
+    //! Check for neighbor
+    /*!
+    Returns true if \c screen has a link anywhere along \c side.  Behaves
+    like Config::hasNeighbor().
+    */
+    bool has_neighbor(ScreenId screen, EDirection side) const;
+
+    //@}
+
+private:
+    struct Link {
+        float src_start;
+        float src_end;
+        float dst_start;
+        float dst_end;
+        ScreenId dst;
+    };
+
+    std::size_t edge(ScreenId screen, EDirection side) const
+    {
+        return static_cast<std::size_t>(screen) * kNumDirections + (side - kFirstDirection);
+    }
+
+    std::size_t size_ = 0;
+    std::map<std::string, ScreenId, inputleap::string::CaselessCmp> ids_;
+
+    // edges are indexed by screen id.  links of edge e are links_[edge_begin_[e]] to links_[edge_begin_[e + 1] - 1]
+    std::vector<Link> links_;
+    std::vector<std::uint32_t> edge_begin_;
+};
+
+} // namespace inputleap
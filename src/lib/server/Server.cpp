@@ -22,6 +22,8 @@
 #include "server/ClientProxyUnknown.h"
 #include "server/PrimaryClient.h"
 #include "server/ClientListener.h"
+#include "server/ConfigDiff.h"
+#include "server/LinkQuality.h"
 #include "inputleap/FileChunk.h"
 #include "inputleap/IPlatformScreen.h"
 #include "inputleap/DropHelper.h"
@@ -33,6 +35,7 @@
 #include "inputleap/KeyState.h"
 #include "inputleap/Screen.h"
 #include "inputleap/PacketStreamFilter.h"
+#include "inputleap/ProtocolUtil.h"
 #include "net/TCPSocket.h"
 #include "net/IDataSocket.h"
 #include "net/IListenSocket.h"
@@ -41,8 +44,10 @@
 #include "arch/Arch.h"
 #include "base/IEventQueue.h"
 #include "base/Log.h"
+#include "base/MetricsText.h"
 #include "base/Time.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <sstream>
@@ -134,6 +139,21 @@ Server::Server(
     m_events->add_handler(EventType::PRIMARY_SCREEN_WHEEL,
                           m_primaryClient->getEventTarget(),
                           [this](const auto& e){ handle_wheel_event(e); });
+
+    // when motion arrives faster than we handle it merge the queued events,
+    // so the cursor catches up instead of replaying the backlog
+    m_events->set_event_merger(EventType::PRIMARY_SCREEN_MOTION_ON_PRIMARY,
+                               [](Event& queued, const Event& later) {
+        queued.get_data_as<IPlatformScreen::MotionInfo>() =
+                later.get_data_as<IPlatformScreen::MotionInfo>();
+    });
+    m_events->set_event_merger(EventType::PRIMARY_SCREEN_MOTION_ON_SECONDARY,
+                               [](Event& queued, const Event& later) {
+        auto& motion = queued.get_data_as<IPlatformScreen::MotionInfo>();
+        const auto& delta = later.get_data_as<IPlatformScreen::MotionInfo>();
+        motion.m_x += delta.m_x;
+        motion.m_y += delta.m_y;
+    });
     m_events->add_handler(EventType::PRIMARY_SCREEN_SAVER_ACTIVATED,
                           m_primaryClient->getEventTarget(),
                           [this](const auto& e){ handle_screensaver_activated_event(); });
@@ -162,6 +182,9 @@ Server::Server(
                               [this](const auto& e){ handle_file_receive_completed_event(e); });
 	}
 
+	// the screens of the configuration get their ids with the topology
+	m_topology = ScreenTopology(config);
+
 	// add connection
 	addClient(m_primaryClient);
 
@@ -195,6 +218,8 @@ Server::~Server()
     m_events->removeHandler(EventType::PRIMARY_SCREEN_MOTION_ON_PRIMARY, m_primaryClient->getEventTarget());
     m_events->removeHandler(EventType::PRIMARY_SCREEN_MOTION_ON_SECONDARY, m_primaryClient->getEventTarget());
     m_events->removeHandler(EventType::PRIMARY_SCREEN_WHEEL, m_primaryClient->getEventTarget());
+    m_events->set_event_merger(EventType::PRIMARY_SCREEN_MOTION_ON_PRIMARY, nullptr);
+    m_events->set_event_merger(EventType::PRIMARY_SCREEN_MOTION_ON_SECONDARY, nullptr);
     m_events->removeHandler(EventType::PRIMARY_SCREEN_SAVER_ACTIVATED, m_primaryClient->getEventTarget());
     m_events->removeHandler(EventType::PRIMARY_SCREEN_SAVER_DEACTIVATED, m_primaryClient->getEventTarget());
     m_events->removeHandler(EventType::PRIMARY_SCREEN_FAKE_INPUT_BEGIN, m_inputFilter);
@@ -229,13 +254,77 @@ Server::setConfig(const Config& config)
 		return false;
 	}
 
+	// at startup we're given the configuration we already hold; apply
+	// all of it
+	if (&config == m_config) {
+		m_topology = ScreenTopology(*m_config);
+		invalidateEdges();
+		processOptions();
+		addLockToScreenRule(*m_config);
+		m_primaryClient->reconfigure(getActivePrimarySides());
+		for (ClientSet::const_iterator index = m_clientSet.begin();
+									index != m_clientSet.end(); ++index) {
+			sendOptions(*index);
+		}
+		return true;
+	}
+
+	// otherwise apply only what differs from the current configuration.
+	// compare with the ScrollLock rule in place, like we hold it.
+	Config next(config);
+	addLockToScreenRule(next);
+	ConfigDiff diff(*m_config, next);
+	LOG((CLOG_DEBUG "configuration changes: %s", diff.to_string().c_str()));
+	if (diff.empty()) {
+		return true;
+	}
+	if (diff.listen_address_changed()) {
+		LOG((CLOG_NOTE "the new listen address takes effect when the server is restarted"));
+	}
+
 	// close clients that are connected but being dropped from the
 	// configuration.
-	closeClients(config);
+	if (!diff.removed_screens().empty()) {
+		closeClients(next);
+	}
+
+	// cut over.  unchanged filter rules keep their hotkeys.
+	std::vector<ScreenId> optionsChanged;
+	for (ClientSet::const_iterator index = m_clientSet.begin();
+								index != m_clientSet.end(); ++index) {
+		if (diff.options_changed(getName(*index))) {
+			optionsChanged.push_back((*index)->getScreenId());
+		}
+	}
+	m_config->update(next);
+	invalidateEdges();
 
-	// cut over
-	processOptions();
+	if (diff.topology_changed()) {
+		m_topology = ScreenTopology(*m_config);
+	}
+	if (diff.global_options_changed()) {
+		processOptions();
+	}
+
+	// tell primary screen about reconfiguration
+	if (diff.topology_changed()) {
+		m_primaryClient->reconfigure(getActivePrimarySides());
+	}
+
+	// tell the (connected) clients whose options changed
+	for (ScreenId id : optionsChanged) {
+		BaseClientProxy* client = findClient(id);
+		if (client != nullptr) {
+			sendOptions(client);
+		}
+	}
 
+	return true;
+}
+
+void
+Server::addLockToScreenRule(Config& config) const
+{
 	// add ScrollLock as a hotkey to lock to the screen.  this was a
 	// built-in feature in earlier releases and is now supported via
 	// the user configurable hotkey mechanism.  if the user has already
@@ -243,24 +332,12 @@ Server::setConfig(const Config& config)
 	// we will unfortunately generate a warning.  if the user has
 	// configured a LockCursorToScreenAction then we don't add
 	// ScrollLock as a hotkey.
-	if (!m_config->hasLockToScreenAction()) {
+	if (!config.hasLockToScreenAction()) {
         IPlatformScreen::KeyInfo key{kKeyScrollLock, 0, 0, 0};
 		InputFilter::Rule rule(new InputFilter::KeystrokeCondition(m_events, key));
 		rule.adoptAction(new InputFilter::LockCursorToScreenAction(m_events), true);
-		m_inputFilter->addFilterRule(rule);
+		config.getInputFilter()->addFilterRule(rule);
 	}
-
-	// tell primary screen about reconfiguration
-	m_primaryClient->reconfigure(getActivePrimarySides());
-
-	// tell all (connected) clients about current options
-	for (ClientList::const_iterator index = m_clients.begin();
-								index != m_clients.end(); ++index) {
-		BaseClientProxy* client = index->second;
-		sendOptions(client);
-	}
-
-	return true;
 }
 
 void
@@ -306,7 +383,7 @@ void
 Server::disconnect()
 {
 	// close all secondary clients
-	if (m_clients.size() > 1 || !m_oldClients.empty()) {
+	if (m_clientSet.size() > 1 || !m_oldClients.empty()) {
 		Config emptyConfig(m_events);
 		closeClients(emptyConfig);
 	}
@@ -317,16 +394,106 @@ Server::disconnect()
 
 std::uint32_t Server::getNumClients() const
 {
-    return static_cast<std::int32_t>(m_clients.size());
+    return static_cast<std::int32_t>(m_clientSet.size());
 }
 
 void
 Server::getClients(std::vector<std::string>& list) const
 {
 	list.clear();
-	for (ClientList::const_iterator index = m_clients.begin();
-							index != m_clients.end(); ++index) {
-		list.push_back(index->first);
+	for (ClientSet::const_iterator index = m_clientSet.begin();
+							index != m_clientSet.end(); ++index) {
+		list.push_back(getName(*index));
+	}
+	std::sort(list.begin(), list.end());
+}
+
+void
+Server::writeMetrics(MetricsText& metrics) const
+{
+	// collect the counters of the client connections
+	std::vector<std::pair<std::string, ClientCounters>> clients;
+	std::map<std::string, const LinkQuality*> links;
+	for (ClientSet::const_iterator index = m_clientSet.begin();
+							index != m_clientSet.end(); ++index) {
+		if (*index != m_primaryClient) {
+			clients.emplace_back(getName(*index), ClientCounters());
+			(*index)->getCounters(clients.back().second);
+			const LinkQuality* link = (*index)->getLinkQuality();
+			if (link != nullptr && link->samples() > 0) {
+				links[clients.back().first] = link;
+			}
+		}
+	}
+	std::sort(clients.begin(), clients.end(),
+		[](const auto& a, const auto& b) { return a.first < b.first; });
+
+	metrics.family("inputleap_clients", "gauge", "Connected clients.");
+	metrics.sample("inputleap_clients", static_cast<std::uint64_t>(clients.size()));
+
+	metrics.family("inputleap_screen_switches_total", "counter",
+		"Switches to another screen.");
+	metrics.sample("inputleap_screen_switches_total", m_switchCount);
+
+	metrics.family("inputleap_screen_switch_seconds", "summary",
+		"Time taken to leave a screen and enter another.");
+	metrics.summary("inputleap_screen_switch_seconds", m_switchTime);
+
+	struct Counter {
+		const char* name;
+		const char* type;
+		const char* help;
+		std::uint64_t (*get)(const ClientCounters&);
+	};
+	static const Counter kCounters[] = {
+		{ "inputleap_client_received_bytes_total", "counter",
+			"Bytes received from the client.",
+			[](const ClientCounters& c) { return c.m_stream.m_bytesRead; } },
+		{ "inputleap_client_sent_bytes_total", "counter",
+			"Bytes sent to the client.",
+			[](const ClientCounters& c) { return c.m_stream.m_bytesWritten; } },
+		{ "inputleap_client_output_queue_bytes", "gauge",
+			"Bytes waiting to be sent to the client.",
+			[](const ClientCounters& c) {
+				return static_cast<std::uint64_t>(c.m_stream.m_bytesPending); } },
+		{ "inputleap_client_clipboard_sent_bytes_total", "counter",
+			"Clipboard data sent to the client.",
+			[](const ClientCounters& c) { return c.m_clipboardBytesSent; } },
+		{ "inputleap_client_clipboard_received_bytes_total", "counter",
+			"Clipboard data received from the client.",
+			[](const ClientCounters& c) { return c.m_clipboardBytesReceived; } },
+		{ "inputleap_client_replaced_mouse_moves_total", "counter",
+			"Mouse moves replaced by later ones before they were sent.",
+			[](const ClientCounters& c) { return c.m_replacedMoves; } },
+	};
+	for (const Counter& counter : kCounters) {
+		metrics.family(counter.name, counter.type, counter.help);
+		for (const auto& client : clients) {
+			metrics.sample(counter.name, counter.get(client.second),
+				{{"client", client.first}});
+		}
+	}
+
+	metrics.family("inputleap_client_received_messages_total", "counter",
+		"Messages received from the client by message code.");
+	for (const auto& client : clients) {
+		for (const auto& message : client.second.m_messagesReceived) {
+			metrics.sample("inputleap_client_received_messages_total", message.second,
+				{{"client", client.first}, {"code", message.first}});
+		}
+	}
+
+	metrics.family("inputleap_client_rtt_seconds", "gauge",
+		"Smoothed round-trip time of keep alives to the client.");
+	for (const auto& link : links) {
+		metrics.sample("inputleap_client_rtt_seconds", link.second->rtt(),
+			{{"client", link.first}});
+	}
+	metrics.family("inputleap_client_rtt_jitter_seconds", "gauge",
+		"Smoothed mean deviation of the round-trip time to the client.");
+	for (const auto& link : links) {
+		metrics.sample("inputleap_client_rtt_jitter_seconds", link.second->jitter(),
+			{{"client", link.first}});
 	}
 }
 
@@ -339,6 +506,27 @@ std::string Server::getName(const BaseClientProxy* client) const
 	return name;
 }
 
+BaseClientProxy* Server::findClient(ScreenId id) const
+{
+	return id < m_topologyClients.size() ? m_topologyClients[id] : nullptr;
+}
+
+void Server::updateKeyboardBroadcastTargets()
+{
+    m_keyboardBroadcastTargets.clear();
+    if (!m_keyboardBroadcasting) {
+        return;
+    }
+
+    // no screens means all screens
+    for (ClientSet::const_iterator index = m_clientSet.begin(); index != m_clientSet.end(); ++index) {
+        if (m_keyboardBroadcastingScreens.empty() ||
+            m_keyboardBroadcastingScreens.contains((*index)->getScreenId())) {
+            m_keyboardBroadcastTargets.push_back(*index);
+        }
+    }
+}
+
 std::uint32_t Server::getActivePrimarySides() const
 {
     std::uint32_t sides = 0;
@@ -393,6 +581,53 @@ std::int32_t Server::getJumpZoneSize(BaseClientProxy* client) const
 	}
 }
 
+const Server::ScreenEdges&
+Server::getActiveEdges()
+{
+	ScreenEdges& edges = m_activeEdges;
+	if (edges.m_screen == m_active) {
+		return edges;
+	}
+
+	edges.m_screen = m_active;
+	m_active->getShape(edges.m_x, edges.m_y, edges.m_w, edges.m_h);
+	edges.m_zoneSize        = getJumpZoneSize(m_active);
+	edges.m_left            = edges.m_x + edges.m_zoneSize;
+	edges.m_right           = edges.m_x + edges.m_w - edges.m_zoneSize;
+	edges.m_top             = edges.m_y + edges.m_zoneSize;
+	edges.m_bottom          = edges.m_y + edges.m_h - edges.m_zoneSize;
+	edges.m_primaryZoneSize = m_primaryClient->getJumpZoneSize();
+
+	// get the locked corners.  first check if screen has the option set
+	// and, if not, check the global options.
+	edges.m_corners    = 0;
+	edges.m_cornerSize = 0;
+	const Config::ScreenOptions* options =
+						m_config->getOptions(getName(m_active));
+	if (options == nullptr || options->count(kOptionScreenSwitchCorners) == 0) {
+		options = m_config->getOptions("");
+	}
+	if (options != nullptr && options->count(kOptionScreenSwitchCorners) > 0) {
+		Config::ScreenOptions::const_iterator i =
+			options->find(kOptionScreenSwitchCorners);
+		edges.m_corners = static_cast<std::uint32_t>(i->second);
+		i = options->find(kOptionScreenSwitchCornerSize);
+		if (i != options->end()) {
+			edges.m_cornerSize = i->second;
+		}
+	}
+
+	LOG((CLOG_DEBUG2 "edges of \"%s\" are %d,%d %dx%d, jump zone %d", getName(m_active).c_str(), edges.m_x, edges.m_y, edges.m_w, edges.m_h, edges.m_zoneSize));
+	return edges;
+}
+
+void
+Server::invalidateEdges()
+{
+	m_activeEdges.m_screen = nullptr;
+	m_lastNeighbor.m_src   = nullptr;
+}
+
 void Server::switchScreen(BaseClientProxy* dst, std::int32_t x, std::int32_t y, bool forScreensaver)
 {
 	assert(dst != nullptr);
@@ -423,6 +658,8 @@ void Server::switchScreen(BaseClientProxy* dst, std::int32_t x, std::int32_t y,
 	// since that's a waste of time we skip that and just warp the
 	// mouse.
 	if (m_active != dst) {
+		Stopwatch timer;
+
 		// leave active screen
 		if (!m_active->leave()) {
 			// cannot leave screen
@@ -460,9 +697,12 @@ void Server::switchScreen(BaseClientProxy* dst, std::int32_t x, std::int32_t y,
 			}
 		}
 
-        Server::SwitchToScreenInfo info{m_active->getName()};
+		Server::SwitchToScreenInfo info{m_active->getScreenId(), m_active->getName()};
         m_events->add_event(EventType::SERVER_SCREEN_SWITCHED, this,
                             create_event_data<Server::SwitchToScreenInfo>(info));
+
+		++m_switchCount;
+		m_switchTime.record(static_cast<std::uint64_t>(timer.getTime() * 1.0e6));
 	}
 	else {
 		m_active->mouseMove(x, y);
@@ -536,7 +776,7 @@ Server::hasAnyNeighbor(BaseClientProxy* client, EDirection dir) const
 {
 	assert(client != nullptr);
 
-	return m_config->hasNeighbor(getName(client), dir);
+	return m_topology.has_neighbor(client->getScreenId(), dir);
 }
 
 BaseClientProxy* Server::getNeighbor(BaseClientProxy* src, EDirection dir, std::int32_t& x,
@@ -546,44 +786,46 @@ BaseClientProxy* Server::getNeighbor(BaseClientProxy* src, EDirection dir, std::
 
 	assert(src != nullptr);
 
-	// get source screen name
-    std::string srcName = getName(src);
-	assert(!srcName.empty());
-	LOG((CLOG_DEBUG2 "find neighbor on %s of \"%s\"", Config::dirName(dir), srcName.c_str()));
+	// get source screen
+	ScreenId srcScreen = src->getScreenId();
+	LOG((CLOG_DEBUG2 "find neighbor on %s of \"%s\"", Config::dirName(dir), getName(src).c_str()));
 
 	// convert position to fraction
 	float t = mapToFraction(src, dir, x, y);
 
-	// search for the closest neighbor that exists in direction dir
+	// search for the closest neighbor that exists in direction dir.
+	// skipping more screens than there are means we're going in circles
+	// through unconnected screens.
 	float tTmp;
-	for (;;) {
-        std::string dstName(m_config->getNeighbor(srcName, dir, t, &tTmp));
+	for (std::size_t skipped = 0; skipped <= m_topology.size(); ++skipped) {
+		ScreenId dstScreen = m_topology.neighbor(srcScreen, dir, t, &tTmp);
 
 		// if nothing in that direction then return nullptr. if the
 		// destination is the source then we can make no more
 		// progress in this direction.  since we haven't found a
 		// connected neighbor we return nullptr.
-		if (dstName.empty()) {
-			LOG((CLOG_DEBUG2 "no neighbor on %s of \"%s\"", Config::dirName(dir), srcName.c_str()));
+		if (dstScreen == kNoScreenId) {
+			LOG((CLOG_DEBUG2 "no neighbor on %s of \"%s\"", Config::dirName(dir), ScreenIds::name(srcScreen).c_str()));
 			return nullptr;
 		}
 
 		// look up neighbor cell.  if the screen is connected and
 		// ready then we can stop.
-		ClientList::const_iterator index = m_clients.find(dstName);
-		if (index != m_clients.end()) {
-			LOG((CLOG_DEBUG2 "\"%s\" is on %s of \"%s\" at %f", dstName.c_str(), Config::dirName(dir), srcName.c_str(), t));
-			mapToPixel(index->second, dir, tTmp, x, y);
-			return index->second;
+		BaseClientProxy* dst = findClient(dstScreen);
+		if (dst != nullptr) {
+			LOG((CLOG_DEBUG2 "\"%s\" is on %s of \"%s\" at %f", ScreenIds::name(dstScreen).c_str(), Config::dirName(dir), ScreenIds::name(srcScreen).c_str(), t));
+			mapToPixel(dst, dir, tTmp, x, y);
+			return dst;
 		}
 
 		// skip over unconnected screen
-		LOG((CLOG_DEBUG2 "ignored \"%s\" on %s of \"%s\"", dstName.c_str(), Config::dirName(dir), srcName.c_str()));
-		srcName = dstName;
+		LOG((CLOG_DEBUG2 "ignored \"%s\" on %s of \"%s\"", ScreenIds::name(dstScreen).c_str(), Config::dirName(dir), ScreenIds::name(srcScreen).c_str()));
+		srcScreen = dstScreen;
 
 		// use position on skipped screen
 		t = tTmp;
 	}
+	return nullptr;
 }
 
 BaseClientProxy* Server::mapToNeighbor(BaseClientProxy* src, EDirection srcSide, std::int32_t& x,
@@ -694,6 +936,24 @@ BaseClientProxy* Server::mapToNeighbor(BaseClientProxy* src, EDirection srcSide,
 	return dst;
 }
 
+BaseClientProxy* Server::mapToNeighborCached(BaseClientProxy* src, EDirection srcSide,
+                                             std::int32_t& x, std::int32_t& y)
+{
+	NeighborLookup& last = m_lastNeighbor;
+	if (last.m_src != src || last.m_dir != srcSide || last.m_x != x || last.m_y != y) {
+		last.m_src  = src;
+		last.m_dir  = srcSide;
+		last.m_x    = x;
+		last.m_y    = y;
+		last.m_dstX = x;
+		last.m_dstY = y;
+		last.m_dst  = mapToNeighbor(src, srcSide, last.m_dstX, last.m_dstY);
+	}
+	x = last.m_dstX;
+	y = last.m_dstY;
+	return last.m_dst;
+}
+
 void Server::avoidJumpZone(BaseClientProxy* dst, EDirection dir, std::int32_t& x,
                            std::int32_t& y) const
 {
@@ -702,7 +962,7 @@ void Server::avoidJumpZone(BaseClientProxy* dst, EDirection dir, std::int32_t& x
 		return;
 	}
 
-    const std::string dstName(getName(dst));
+	ScreenId dstScreen = dst->getScreenId();
 	std::int32_t dx, dy, dw, dh;
 	dst->getShape(dx, dy, dw, dh);
 	float t = mapToFraction(dst, dir, x, y);
@@ -713,25 +973,25 @@ void Server::avoidJumpZone(BaseClientProxy* dst, EDirection dir, std::int32_t& x
 	// don't need to move inwards because that side can't provoke a jump.
 	switch (dir) {
 	case kLeft:
-		if (!m_config->getNeighbor(dstName, kRight, t, nullptr).empty() &&
+		if (m_topology.neighbor(dstScreen, kRight, t, nullptr) != kNoScreenId &&
 			x > dx + dw - 1 - z)
 			x = dx + dw - 1 - z;
 		break;
 
 	case kRight:
-		if (!m_config->getNeighbor(dstName, kLeft, t, nullptr).empty() &&
+		if (m_topology.neighbor(dstScreen, kLeft, t, nullptr) != kNoScreenId &&
 			x < dx + z)
 			x = dx + z;
 		break;
 
 	case kTop:
-		if (!m_config->getNeighbor(dstName, kBottom, t, nullptr).empty() &&
+		if (m_topology.neighbor(dstScreen, kBottom, t, nullptr) != kNoScreenId &&
 			y > dy + dh - 1 - z)
 			y = dy + dh - 1 - z;
 		break;
 
 	case kBottom:
-		if (!m_config->getNeighbor(dstName, kTop, t, nullptr).empty() &&
+		if (m_topology.neighbor(dstScreen, kTop, t, nullptr) != kNoScreenId &&
 			y < dy + z)
 			y = dy + z;
 		break;
@@ -792,31 +1052,14 @@ bool Server::isSwitchOkay(BaseClientProxy* newScreen, EDirection dir, std::int32
 		preventSwitch = true;
 	}
 
-	// are we in a locked corner?  first check if screen has the option set
-	// and, if not, check the global options.
-	const Config::ScreenOptions* options =
-						m_config->getOptions(getName(m_active));
-	if (options == nullptr || options->count(kOptionScreenSwitchCorners) == 0) {
-		options = m_config->getOptions("");
-	}
-	if (options != nullptr && options->count(kOptionScreenSwitchCorners) > 0) {
-		// get corner mask and size
-		Config::ScreenOptions::const_iterator i =
-			options->find(kOptionScreenSwitchCorners);
-        std::uint32_t corners = static_cast<std::uint32_t>(i->second);
-		i = options->find(kOptionScreenSwitchCornerSize);
-		std::int32_t size = 0;
-		if (i != options->end()) {
-			size = i->second;
-		}
-
-		// see if we're in a locked corner
-		if ((getCorner(m_active, xActive, yActive, size) & corners) != 0) {
-			// yep, no switching
-			LOG((CLOG_DEBUG1 "locked in corner"));
-			preventSwitch = true;
-			stopSwitch();
-		}
+	// are we in a locked corner?
+	const ScreenEdges& edges = getActiveEdges();
+	if (edges.m_corners != 0 &&
+		(getCorner(edges, xActive, yActive) & edges.m_corners) != 0) {
+		// yep, no switching
+		LOG((CLOG_DEBUG1 "locked in corner"));
+		preventSwitch = true;
+		stopSwitch();
 	}
 
 	// ignore if mouse is locked to screen and don't try to switch later
@@ -878,14 +1121,13 @@ void Server::armSwitchTwoTap(std::int32_t x, std::int32_t y)
 		else if (!m_switchTwoTapArmed) {
 			// still time for a double tap.  see if we left the tap
 			// zone and, if so, arm the two tap.
-			std::int32_t ax, ay, aw, ah;
-			m_active->getShape(ax, ay, aw, ah);
-			std::int32_t tapZone = m_primaryClient->getJumpZoneSize();
+			const ScreenEdges& edges = getActiveEdges();
+			std::int32_t tapZone = edges.m_primaryZoneSize;
 			if (tapZone < m_switchTwoTapZone) {
 				tapZone = m_switchTwoTapZone;
 			}
-			if (x >= ax + tapZone && x < ax + aw - tapZone &&
-				y >= ay + tapZone && y < ay + ah - tapZone) {
+			if (x >= edges.m_x + tapZone && x < edges.m_x + edges.m_w - tapZone &&
+				y >= edges.m_y + tapZone && y < edges.m_y + edges.m_h - tapZone) {
 				// win32 can generate bogus mouse events that appear to
 				// move in the opposite direction that the mouse actually
 				// moved.  try to ignore that crap here.
@@ -961,14 +1203,13 @@ Server::isSwitchWaitStarted() const
 	return (m_switchWaitTimer != nullptr);
 }
 
-std::uint32_t Server::getCorner(BaseClientProxy* client, std::int32_t x, std::int32_t y,
-                                std::int32_t size) const
+std::uint32_t Server::getCorner(const ScreenEdges& edges, std::int32_t x, std::int32_t y) const
 {
-	assert(client != nullptr);
+	assert(edges.m_screen != nullptr);
 
 	// get client screen shape
-	std::int32_t ax, ay, aw, ah;
-	client->getShape(ax, ay, aw, ah);
+	const std::int32_t ax = edges.m_x, ay = edges.m_y, aw = edges.m_w, ah = edges.m_h;
+	const std::int32_t size = edges.m_cornerSize;
 
 	// check for x,y on the left or right
 	std::int32_t xSide;
@@ -1135,6 +1376,7 @@ void Server::handle_shape_changed(BaseClientProxy* client)
 	}
 
 	LOG((CLOG_DEBUG "screen \"%s\" shape changed", getName(client).c_str()));
+	invalidateEdges();
 
 	// update jump coordinate
 	std::int32_t x, y;
@@ -1198,9 +1440,9 @@ void Server::handle_clipboard_grabbed(const Event& event, BaseClientProxy* grabb
 
 	// tell all other screens to take ownership of clipboard.  tell the
 	// grabber that it's clipboard isn't dirty.
-	for (ClientList::iterator index = m_clients.begin();
-								index != m_clients.end(); ++index) {
-		BaseClientProxy* client = index->second;
+	for (ClientSet::iterator index = m_clientSet.begin();
+								index != m_clientSet.end(); ++index) {
+		BaseClientProxy* client = *index;
 		if (client == grabber) {
             client->setClipboardDirty(info.m_id, false);
 		}
@@ -1223,13 +1465,13 @@ void Server::handle_clipboard_changed(const Event& event, BaseClientProxy* clien
 void Server::handle_key_down_event(const Event& event)
 {
     const auto& info = event.get_data_as<IPlatformScreen::KeyInfo>();
-    onKeyDown(info.m_key, info.m_mask, info.m_button, info.screens_or_nullptr());
+    onKeyDown(info.m_key, info.m_mask, info.m_button, info.screen_ids_or_nullptr());
 }
 
 void Server::handle_key_up_event(const Event& event)
 {
     const auto& info = event.get_data_as<IPlatformScreen::KeyInfo>();
-    onKeyUp(info.m_key, info.m_mask, info.m_button, info.screens_or_nullptr());
+    onKeyUp(info.m_key, info.m_mask, info.m_button, info.screen_ids_or_nullptr());
 }
 
 void Server::handle_key_repeat_event(const Event& event)
@@ -1314,12 +1556,12 @@ void Server::handle_switch_to_screen_event(const Event& event)
 {
     const auto& info = event.get_data_as<SwitchToScreenInfo>();
 
-    ClientList::const_iterator index = m_clients.find(info.m_screen);
-	if (index == m_clients.end()) {
+	BaseClientProxy* client = findClient(info.m_screenId);
+	if (client == nullptr) {
         LOG((CLOG_DEBUG1 "screen \"%s\" not active", info.m_screen.c_str()));
 	}
 	else {
-        jumpToScreen(index->second);
+        jumpToScreen(client);
 	}
 }
 
@@ -1328,17 +1570,27 @@ Server::handle_toggle_screen_event(const Event& event)
 {
     (void) event;
 
+  // screens are toggled in the order of their names
   std::string current = getName(m_active);
-  ClientList::const_iterator index = m_clients.find(current);
-  if (index == m_clients.end()) {
-    LOG((CLOG_DEBUG1 "screen \"%s\" not active", current.c_str()));
-  }
-  else {
-    ++index;
-    if (index == m_clients.end()) {
-      index = m_clients.begin();
+  BaseClientProxy* next = nullptr;
+  BaseClientProxy* first = nullptr;
+  std::string nextName, firstName;
+  for (ClientSet::const_iterator index = m_clientSet.begin(); index != m_clientSet.end(); ++index) {
+    std::string name = getName(*index);
+    if (first == nullptr || name < firstName) {
+      first = *index;
+      firstName = name;
+    }
+    if (current < name && (next == nullptr || name < nextName)) {
+      next = *index;
+      nextName = name;
     }
-    jumpToScreen(index->second);
+  }
+  if (next == nullptr) {
+    next = first;
+  }
+  if (next != nullptr) {
+    jumpToScreen(next);
   }
 }
 
@@ -1384,7 +1636,8 @@ void Server::handle_keyboard_broadcast_event(const Event& event)
         info.screens_ != m_keyboardBroadcastingScreens) {
 		m_keyboardBroadcasting        = newState;
         m_keyboardBroadcastingScreens = info.screens_;
-		LOG((CLOG_DEBUG "keyboard broadcasting %s: %s", m_keyboardBroadcasting ? "on" : "off", m_keyboardBroadcastingScreens.c_str()));
+        updateKeyboardBroadcastTargets();
+		LOG((CLOG_DEBUG "keyboard broadcasting %s: %s", m_keyboardBroadcasting ? "on" : "off", m_keyboardBroadcastingScreens.to_string().c_str()));
 	}
 }
 
@@ -1454,7 +1707,7 @@ void Server::onClipboardChanged(BaseClientProxy* sender, ClipboardID id, std::ui
 	}
 
 	// should be the expected client
-	assert(sender == m_clients.find(clipboard.m_clipboardOwner)->second);
+	assert(sender->getScreenId() == ScreenIds::find(clipboard.m_clipboardOwner));
 
 	// get data
 	if (!sender->getClipboard(id, &clipboard.m_clipboard)) {
@@ -1475,9 +1728,9 @@ void Server::onClipboardChanged(BaseClientProxy* sender, ClipboardID id, std::ui
 	clipboard.m_clipboardData = data;
 
 	// tell all clients except the sender that the clipboard is dirty
-	for (ClientList::const_iterator index = m_clients.begin();
-								index != m_clients.end(); ++index) {
-		BaseClientProxy* client = index->second;
+	for (ClientSet::const_iterator index = m_clientSet.begin();
+								index != m_clientSet.end(); ++index) {
+		BaseClientProxy* client = *index;
 		client->setClipboardDirty(id, client != sender);
 	}
 
@@ -1533,35 +1786,37 @@ Server::onScreensaver(bool activated)
 	}
 
 	// send message to all clients
-	for (ClientList::const_iterator index = m_clients.begin();
-								index != m_clients.end(); ++index) {
-		BaseClientProxy* client = index->second;
+	for (ClientSet::const_iterator index = m_clientSet.begin();
+								index != m_clientSet.end(); ++index) {
+		BaseClientProxy* client = *index;
 		client->screensaver(activated);
 	}
 }
 
 void
 Server::onKeyDown(KeyID id, KeyModifierMask mask, KeyButton button,
-				const char* screens)
+				const ScreenIdSet* screens)
 {
 	LOG((CLOG_DEBUG1 "onKeyDown id=%d mask=0x%04x button=0x%04x", id, mask, button));
 	assert(m_active != nullptr);
 
 	// relay
-	if (!m_keyboardBroadcasting && IKeyState::KeyInfo::isDefault(screens)) {
+	if (screens == nullptr && !m_keyboardBroadcasting) {
 		m_active->keyDown(id, mask, button);
 	}
-	else {
-		if (!screens && m_keyboardBroadcasting) {
-			screens = m_keyboardBroadcastingScreens.c_str();
-			if (IKeyState::KeyInfo::isDefault(screens)) {
-				screens = "*";
-			}
+	else if (screens == nullptr) {
+		// the message is formatted once and written to every target
+		ProtocolMessageCache messages;
+		for (BaseClientProxy* client : m_keyboardBroadcastTargets) {
+			client->broadcastKeyDown(id, mask, button, messages);
 		}
-		for (ClientList::const_iterator index = m_clients.begin();
-								index != m_clients.end(); ++index) {
-			if (IKeyState::KeyInfo::contains(screens, index->first)) {
-				index->second->keyDown(id, mask, button);
+	}
+	else {
+		ProtocolMessageCache messages;
+		for (ClientSet::const_iterator index = m_clientSet.begin();
+								index != m_clientSet.end(); ++index) {
+			if (screens->contains((*index)->getScreenId())) {
+				(*index)->broadcastKeyDown(id, mask, button, messages);
 			}
 		}
 	}
@@ -1569,26 +1824,28 @@ Server::onKeyDown(KeyID id, KeyModifierMask mask, KeyButton button,
 
 void
 Server::onKeyUp(KeyID id, KeyModifierMask mask, KeyButton button,
-				const char* screens)
+				const ScreenIdSet* screens)
 {
 	LOG((CLOG_DEBUG1 "onKeyUp id=%d mask=0x%04x button=0x%04x", id, mask, button));
 	assert(m_active != nullptr);
 
 	// relay
-	if (!m_keyboardBroadcasting && IKeyState::KeyInfo::isDefault(screens)) {
+	if (screens == nullptr && !m_keyboardBroadcasting) {
 		m_active->keyUp(id, mask, button);
 	}
-	else {
-		if (!screens && m_keyboardBroadcasting) {
-			screens = m_keyboardBroadcastingScreens.c_str();
-			if (IKeyState::KeyInfo::isDefault(screens)) {
-				screens = "*";
-			}
+	else if (screens == nullptr) {
+		// the message is formatted once and written to every target
+		ProtocolMessageCache messages;
+		for (BaseClientProxy* client : m_keyboardBroadcastTargets) {
+			client->broadcastKeyUp(id, mask, button, messages);
 		}
-		for (ClientList::const_iterator index = m_clients.begin();
-								index != m_clients.end(); ++index) {
-			if (IKeyState::KeyInfo::contains(screens, index->first)) {
-				index->second->keyUp(id, mask, button);
+	}
+	else {
+		ProtocolMessageCache messages;
+		for (ClientSet::const_iterator index = m_clientSet.begin();
+								index != m_clientSet.end(); ++index) {
+			if (screens->contains((*index)->getScreenId())) {
+				(*index)->broadcastKeyUp(id, mask, button, messages);
 			}
 		}
 	}
@@ -1665,10 +1922,17 @@ bool Server::onMouseMovePrimary(std::int32_t x, std::int32_t y)
 	m_x       = x;
 	m_y       = y;
 
+	// most motion is nowhere near a jump zone
+	const ScreenEdges& edges = getActiveEdges();
+	if (edges.isInside(x, y)) {
+		// still on local screen
+		noSwitch(x, y);
+		return false;
+	}
+
 	// get screen shape
-	std::int32_t ax, ay, aw, ah;
-	m_active->getShape(ax, ay, aw, ah);
-	std::int32_t zoneSize = getJumpZoneSize(m_active);
+	const std::int32_t ax = edges.m_x, ay = edges.m_y, aw = edges.m_w, ah = edges.m_h;
+	const std::int32_t zoneSize = edges.m_zoneSize;
 
 	// clamp position to screen
 	std::int32_t xc = x, yc = y;
@@ -1706,11 +1970,6 @@ bool Server::onMouseMovePrimary(std::int32_t x, std::int32_t y)
 		yv  += zoneSize;
 		dirv = kBottom;
 	}
-	if (dirh == kNoDirection && dirv == kNoDirection) {
-		// still on local screen
-		noSwitch(x, y);
-		return false;
-	}
 
 	// check both horizontally and vertically
 	EDirection dirs[] = {dirh, dirv};
@@ -1723,7 +1982,7 @@ bool Server::onMouseMovePrimary(std::int32_t x, std::int32_t y)
 		x = xs[i], y = ys[i];
 
 		// get jump destination
-		BaseClientProxy* newScreen = mapToNeighbor(m_active, dir, x, y);
+		BaseClientProxy* newScreen = mapToNeighborCached(m_active, dir, x, y);
 
 		// should we switch or not?
 		if (isSwitchOkay(newScreen, dir, x, y, xc, yc)) {
@@ -1835,8 +2094,8 @@ void Server::onMouseMoveSecondary(std::int32_t dx, std::int32_t dy)
 	m_y      += dy;
 
 	// get screen shape
-	std::int32_t ax, ay, aw, ah;
-	m_active->getShape(ax, ay, aw, ah);
+	const ScreenEdges& edges = getActiveEdges();
+	const std::int32_t ax = edges.m_x, ay = edges.m_y, aw = edges.m_w, ah = edges.m_h;
 
 	// find direction of neighbor and get the neighbor
 	bool jump = true;
@@ -1880,7 +2139,7 @@ void Server::onMouseMoveSecondary(std::int32_t dx, std::int32_t dy)
 			// then arm the double tap.
 			if (m_switchScreen != nullptr) {
 				bool clearWait;
-				std::int32_t zoneSize = m_primaryClient->getJumpZoneSize();
+				std::int32_t zoneSize = edges.m_primaryZoneSize;
 				switch (m_switchDir) {
 				case kLeft:
 					clearWait = (m_x >= ax + zoneSize);
@@ -1913,7 +2172,7 @@ void Server::onMouseMoveSecondary(std::int32_t dx, std::int32_t dy)
 		}
 
 		// try to switch screen.  get the neighbor.
-		newScreen = mapToNeighbor(m_active, dir, m_x, m_y);
+		newScreen = mapToNeighborCached(m_active, dir, m_x, m_y);
 
 		// see if we should switch
 		if (!isSwitchOkay(newScreen, dir, m_x, m_y, xc, yc)) {
@@ -2004,8 +2263,9 @@ void Server::write_to_drop_dir_thread()
 bool
 Server::addClient(BaseClientProxy* client)
 {
-    std::string name = getName(client);
-	if (m_clients.count(name) != 0) {
+	// only screens of the configuration have an id
+	ScreenId id = ScreenIds::find(getName(client));
+	if (id == kNoScreenId || findClient(id) != nullptr) {
 		return false;
 	}
 
@@ -2019,7 +2279,13 @@ Server::addClient(BaseClientProxy* client)
 
 	// add to list
 	m_clientSet.insert(client);
-	m_clients.insert(std::make_pair(name, client));
+	if (id >= m_topologyClients.size()) {
+		m_topologyClients.resize(id + 1, nullptr);
+	}
+	m_topologyClients[id] = client;
+	client->setScreenId(id);
+	updateKeyboardBroadcastTargets();
+	invalidateEdges();
 
 	// initialize client data
 	std::int32_t x, y;
@@ -2047,8 +2313,10 @@ Server::removeClient(BaseClientProxy* client)
     m_events->removeHandler(EventType::CLIPBOARD_CHANGED, client->getEventTarget());
 
 	// remove from list
-	m_clients.erase(getName(client));
+	m_topologyClients[client->getScreenId()] = nullptr;
 	m_clientSet.erase(i);
+	updateKeyboardBroadcastTargets();
+	invalidateEdges();
 
 	return true;
 }
@@ -2065,7 +2333,7 @@ Server::closeClient(BaseClientProxy* client, const char* msg)
 	// quickly enough.  we also remove the client from the active
 	// client list since we're not going to listen to it anymore.
 	// note that this method also works on clients that are not in
-	// the m_clients list.  adoptClient() may call us with such a
+	// the m_clientSet list.  adoptClient() may call us with such a
 	// client.
 	LOG((CLOG_NOTE "disconnecting client \"%s\"", getName(client).c_str()));
 
@@ -2098,10 +2366,10 @@ Server::closeClients(const Config& config)
 	// from the configuration (or who's canonical name is changing).
 	typedef std::set<BaseClientProxy*> RemovedClients;
 	RemovedClients removed;
-	for (ClientList::iterator index = m_clients.begin();
-								index != m_clients.end(); ++index) {
-		if (!config.isCanonicalName(index->first)) {
-			removed.insert(index->second);
+	for (ClientSet::iterator index = m_clientSet.begin();
+								index != m_clientSet.end(); ++index) {
+		if (!config.isCanonicalName(ScreenIds::name((*index)->getScreenId()))) {
+			removed.insert(*index);
 		}
 	}
 
@@ -2122,7 +2390,7 @@ Server::removeActiveClient(BaseClientProxy* client)
 	if (removeClient(client)) {
 		forceLeaveClient(client);
         m_events->removeHandler(EventType::CLIENT_PROXY_DISCONNECTED, client);
-		if (m_clients.size() == 1 && m_oldClients.empty()) {
+		if (m_clientSet.size() == 1 && m_oldClients.empty()) {
             m_events->add_event(EventType::SERVER_DISCONNECTED, this);
 		}
 	}
@@ -2137,7 +2405,7 @@ Server::removeOldClient(BaseClientProxy* client)
         m_events->removeHandler(EventType::TIMER, i->second);
 		m_events->deleteTimer(i->second);
 		m_oldClients.erase(i);
-		if (m_clients.size() == 1 && m_oldClients.empty()) {
+		if (m_clientSet.size() == 1 && m_oldClients.empty()) {
             m_events->add_event(EventType::SERVER_DISCONNECTED, this);
 		}
 	}
@@ -2171,7 +2439,7 @@ Server::forceLeaveClient(BaseClientProxy* client)
 								m_primaryClient->getToggleMask(), false);
 		}
 
-        Server::SwitchToScreenInfo info{m_active->getName()};
+		Server::SwitchToScreenInfo info{m_active->getScreenId(), m_active->getName()};
         m_events->add_event(EventType::SERVER_SCREEN_SWITCHED, this,
                             create_event_data<Server::SwitchToScreenInfo>(info));
 	}
@@ -2201,6 +2469,28 @@ Server::ClipboardInfo::ClipboardInfo() :
 	// do nothing
 }
 
+Server::ScreenEdges::ScreenEdges() :
+	m_screen(nullptr),
+	m_x(0), m_y(0), m_w(0), m_h(0),
+	m_zoneSize(0),
+	m_left(0), m_right(0), m_top(0), m_bottom(0),
+	m_primaryZoneSize(0),
+	m_corners(0),
+	m_cornerSize(0)
+{
+	// do nothing
+}
+
+Server::NeighborLookup::NeighborLookup() :
+	m_src(nullptr),
+	m_dir(kNoDirection),
+	m_x(0), m_y(0),
+	m_dst(nullptr),
+	m_dstX(0), m_dstY(0)
+{
+	// do nothing
+}
+
 bool
 Server::isReceivedFileSizeValid()
 {
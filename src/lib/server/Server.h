@@ -19,16 +19,19 @@
 #pragma once
 
 #include "server/Config.h"
+#include "server/ScreenTopology.h"
 #include "inputleap/clipboard_types.h"
 #include "inputleap/Clipboard.h"
 #include "inputleap/key_types.h"
 #include "inputleap/mouse_types.h"
 #include "inputleap/INode.h"
+#include "inputleap/ScreenId.h"
 #include "inputleap/DragInformation.h"
 #include "inputleap/ServerArgs.h"
 #include "base/Event.h"
 #include "base/Stopwatch.h"
 #include "base/EventTypes.h"
+#include "base/LatencyHistogram.h"
 
 #include <map>
 #include <set>
@@ -45,6 +48,7 @@ class Screen;
 class IEventQueue;
 class Thread;
 class ClientListener;
+class MetricsText;
 
 /// This class implements the top-level server algorithms for InputLeap.
 class Server : public INode {
@@ -63,11 +67,13 @@ public:
     //! Switch to screen data
     class SwitchToScreenInfo {
     public:
-        SwitchToScreenInfo(const std::string& screen) :
+        SwitchToScreenInfo(ScreenId screenId, const std::string& screen) :
+            m_screenId{screenId},
             m_screen{screen}
         {}
 
     public:
+        ScreenId m_screenId;
         std::string m_screen;
     };
 
@@ -98,14 +104,14 @@ public:
             m_state{state}
         {}
 
-        KeyboardBroadcastInfo(State state, const std::string& screens) :
+        KeyboardBroadcastInfo(State state, const ScreenIdSet& screens) :
             m_state{state},
             screens_{screens}
         {}
 
     public:
         State m_state;
-        std::string screens_;
+        ScreenIdSet screens_;
     };
 
     /*!
@@ -130,6 +136,9 @@ public:
     Change the server's configuration.  Returns true iff the new
     configuration was accepted (it must include the server's name).
     This will disconnect any clients no longer in the configuration.
+    Only the differences to the current configuration are applied:
+    clients are sent their options only if those changed and filter
+    rules found in both configurations stay registered.
     */
     bool setConfig(const Config&);
 
@@ -174,6 +183,13 @@ public:
     */
     void getClients(std::vector<std::string>& list) const;
 
+    //! Get metrics
+    /*!
+    Adds the screen switch counters and the counters of the connections
+    to all clients to \c metrics.
+    */
+    void writeMetrics(MetricsText& metrics) const;
+
     //! Return true if received file size is valid
     bool isReceivedFileSizeValid();
 
@@ -189,9 +205,60 @@ public:
     //@}
 
 private:
+    // what the server needs to know about the edges of the active screen
+    // to handle mouse motion on it
+    class ScreenEdges {
+    public:
+        ScreenEdges();
+
+        // returns true iff x,y is not in a jump zone
+        bool isInside(std::int32_t x, std::int32_t y) const
+        {
+            return (x >= m_left && x < m_right && y >= m_top && y < m_bottom);
+        }
+
+    public:
+        // the screen these are the edges of or nullptr if not computed
+        BaseClientProxy* m_screen;
+        std::int32_t m_x, m_y, m_w, m_h;
+
+        // jump zone of the screen and the area inside of it
+        std::int32_t m_zoneSize;
+        std::int32_t m_left, m_right, m_top, m_bottom;
+
+        // jump zone of the primary screen
+        std::int32_t m_primaryZoneSize;
+
+        // locked corners (EScreenSwitchCornerMasks) and their size
+        std::uint32_t m_corners;
+        std::int32_t m_cornerSize;
+    };
+
+    // the last lookup done by mapToNeighborCached()
+    class NeighborLookup {
+    public:
+        NeighborLookup();
+
+    public:
+        // the screen the lookup started from or nullptr if none cached
+        BaseClientProxy* m_src;
+        EDirection m_dir;
+        std::int32_t m_x, m_y;
+
+        // the result
+        BaseClientProxy* m_dst;
+        std::int32_t m_dstX, m_dstY;
+    };
+
     // get canonical name of client
     std::string getName(const BaseClientProxy*) const;
 
+    // get the connected client of a screen or nullptr
+    BaseClientProxy* findClient(ScreenId) const;
+
+    // collect the clients that broadcasted keys go to
+    void updateKeyboardBroadcastTargets();
+
     // get the sides of the primary screen that have neighbors
     std::uint32_t getActivePrimarySides() const;
 
@@ -238,6 +305,12 @@ private:
     BaseClientProxy* mapToNeighbor(BaseClientProxy*, EDirection, std::int32_t& x,
                                    std::int32_t& y) const;
 
+    // like mapToNeighbor() but reuses the result of the previous lookup
+    // if it was for the same screen, direction and position.  this is
+    // the common case while the mouse dwells at an edge.
+    BaseClientProxy* mapToNeighborCached(BaseClientProxy*, EDirection, std::int32_t& x,
+                                         std::int32_t& y);
+
     // adjusts x and y or neither to avoid ending up in a jump zone
     // after entering the client in the given direction.
     void avoidJumpZone(BaseClientProxy*, EDirection, std::int32_t& x, std::int32_t& y) const;
@@ -280,9 +353,18 @@ private:
     bool isSwitchWaitStarted() const;
 
     // returns the corner (EScreenSwitchCornerMasks) where x,y is on the
-    // given client.  corners have the given size.
-    std::uint32_t getCorner(BaseClientProxy*, std::int32_t x, std::int32_t y,
-                            std::int32_t size) const;
+    // screen with the given edges.  corners have the size configured
+    // for that screen.
+    std::uint32_t getCorner(const ScreenEdges&, std::int32_t x, std::int32_t y) const;
+
+    // returns the edges of the active screen, computing them if they're
+    // not cached
+    const ScreenEdges& getActiveEdges();
+
+    // discard the cached edges and neighbor lookup.  must be called
+    // when the shape of a screen, the options or the set of connected
+    // screens changes.
+    void invalidateEdges();
 
     // stop relative mouse moves
     void stopRelativeMoves();
@@ -293,6 +375,9 @@ private:
     // process options from configuration
     void processOptions();
 
+    // add the ScrollLock lock to screen hotkey unless configured otherwise
+    void addLockToScreenRule(Config&) const;
+
     // event handlers
     void handle_shape_changed(BaseClientProxy* client);
     void handle_clipboard_grabbed(const Event& event, BaseClientProxy* client);
@@ -324,9 +409,9 @@ private:
     void onClipboardChanged(BaseClientProxy* sender, ClipboardID id, std::uint32_t seqNum);
     void onScreensaver(bool activated);
     void onKeyDown(KeyID, KeyModifierMask, KeyButton,
-                            const char* screens);
+                            const ScreenIdSet* screens);
     void onKeyUp(KeyID, KeyModifierMask, KeyButton,
-                            const char* screens);
+                            const ScreenIdSet* screens);
     void onKeyRepeat(KeyID, KeyModifierMask, std::int32_t, KeyButton);
     void onMouseDown(ButtonID);
     void onMouseUp(ButtonID);
@@ -389,11 +474,11 @@ private:
     // the primary screen client
     PrimaryClient* m_primaryClient;
 
-    // all clients (including the primary client) indexed by name
-    typedef std::map<std::string, BaseClientProxy*> ClientList;
+    // all clients (including the primary client) and the connected client
+    // of each screen, indexed by screen id (nullptr if not connected)
     typedef std::set<BaseClientProxy*> ClientSet;
-    ClientList m_clients;
     ClientSet m_clientSet;
+    std::vector<BaseClientProxy*> m_topologyClients;
 
     // all old connections that we're waiting to hangup
     typedef std::map<BaseClientProxy*, EventQueueTimer*> OldClients;
@@ -419,6 +504,17 @@ private:
     // current configuration
     Config* m_config;
 
+    // links of m_config
+    ScreenTopology m_topology;
+
+    // number of switches to another screen and the time they took (us)
+    std::uint64_t m_switchCount = 0;
+    LatencyHistogram m_switchTime;
+
+    // cached edges of the active screen and neighbor lookup
+    ScreenEdges m_activeEdges;
+    NeighborLookup m_lastNeighbor;
+
     // input filter (from m_config);
     InputFilter* m_inputFilter;
 
@@ -457,7 +553,12 @@ private:
     // flag whether or not we have broadcasting enabled and the screens to
     // which we should send broadcasted keys.
     bool m_keyboardBroadcasting;
-    std::string m_keyboardBroadcastingScreens;
+    ScreenIdSet m_keyboardBroadcastingScreens;
+
+    // the clients in m_keyboardBroadcastingScreens, resolved whenever the
+    // broadcast state or the set of clients changes.  empty if not
+    // broadcasting.
+    std::vector<BaseClientProxy*> m_keyboardBroadcastTargets;
 
     // screen locking (former scroll lock)
     bool m_lockedToScreen;
@@ -0,0 +1,194 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if SYSAPI_UNIX
+
+#include "test/mock/inputleap/MockEventQueue.h"
+#include "server/ClientProxy1_2.h"
+#include "inputleap/PacketStreamFilter.h"
+#include "net/NetworkAddress.h"
+#include "net/SocketMultiplexer.h"
+#include "net/TCPSocket.h"
+#include "base/Stopwatch.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace inputleap {
+
+using ::testing::NiceMock;
+
+namespace {
+
+// Loopback peer with a tiny receive buffer that reads nothing until asked to.  This keeps
+// everything written after a large payload unsent in the sender's output buffer, like a client
+// on a slow link.
+class ThrottledPeer {
+public:
+    ThrottledPeer()
+    {
+        listener_ = socket(AF_INET, SOCK_STREAM, 0);
+        int size = 4096;
+        setsockopt(listener_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listener_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listener_, 1);
+
+        socklen_t len = sizeof(addr);
+        getsockname(listener_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+
+    ~ThrottledPeer()
+    {
+        if (connection_ != -1) {
+            close(connection_);
+        }
+        close(listener_);
+    }
+
+    int port() const { return port_; }
+
+    void accept() { connection_ = ::accept(listener_, nullptr, nullptr); }
+
+    // reads until \p size bytes have arrived or \p timeout seconds have passed
+    std::vector<std::uint8_t> read(std::size_t size, double timeout)
+    {
+        std::vector<std::uint8_t> data;
+        std::uint8_t buffer[65536];
+        Stopwatch timer(false);
+        while (data.size() < size && timer.getTime() < timeout) {
+            pollfd pfd = { connection_, POLLIN, 0 };
+            if (poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            ssize_t n = recv(connection_, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                break;
+            }
+            data.insert(data.end(), buffer, buffer + n);
+        }
+        return data;
+    }
+
+private:
+    int listener_ = -1;
+    int connection_ = -1;
+    int port_ = 0;
+};
+
+struct Packet {
+    std::string code;
+    std::vector<std::uint8_t> payload;
+
+    std::int16_t int16_at(std::size_t offset) const
+    {
+        return static_cast<std::int16_t>((payload[offset] << 8) | payload[offset + 1]);
+    }
+};
+
+std::vector<Packet> split_packets(const std::vector<std::uint8_t>& data)
+{
+    std::vector<Packet> packets;
+    std::size_t offset = 0;
+    while (offset + 4 <= data.size()) {
+        std::uint32_t size = (static_cast<std::uint32_t>(data[offset]) << 24) |
+                             (static_cast<std::uint32_t>(data[offset + 1]) << 16) |
+                             (static_cast<std::uint32_t>(data[offset + 2]) << 8) |
+                              static_cast<std::uint32_t>(data[offset + 3]);
+        offset += 4;
+        if (size < 4 || offset + size > data.size()) {
+            break;
+        }
+        Packet packet;
+        packet.code.assign(reinterpret_cast<const char*>(&data[offset]), 4);
+        packet.payload.assign(data.begin() + offset + 4, data.begin() + offset + size);
+        packets.push_back(packet);
+        offset += size;
+    }
+    return packets;
+}
+
+} // namespace
+
+TEST(TCPSocketTests, replaceLastWrite_throttledPeer_unsentMovesSquashedInOrder)
+{
+    ThrottledPeer peer;
+    SocketMultiplexer multiplexer;
+    NiceMock<MockEventQueue> events;
+
+    TCPSocket* socket = new TCPSocket(&events, &multiplexer, IArchNetwork::kINET);
+    NetworkAddress address("127.0.0.1", peer.port());
+    address.resolve();
+    socket->connect(address);
+    peer.accept();
+
+    PacketStreamFilter* stream = new PacketStreamFilter(&events, socket, true);
+    std::size_t expected_size = 0;
+    {
+        ClientProxy1_2 proxy("client", stream, &events);
+        expected_size += 4 + 4; // QINF
+
+        // back up the link so that everything after this stays in our output buffer
+        const std::vector<std::uint8_t> filler(8 * 1024 * 1024, 'x');
+        stream->write(filler.data(), static_cast<std::uint32_t>(filler.size()));
+        expected_size += 4 + filler.size();
+
+        for (std::int32_t i = 1; i <= 100; ++i) {
+            proxy.mouseMove(i, 2 * i);
+        }
+        proxy.mouseDown(1);
+        for (std::int32_t i = 1; i <= 50; ++i) {
+            proxy.mouseRelativeMove(1, -1);
+        }
+        proxy.mouseMove(500, 600);
+        proxy.mouseMove(501, 601);
+        expected_size += 3 * (4 + 8) + (4 + 5);
+
+        std::vector<Packet> packets = split_packets(peer.read(expected_size, 30));
+        ASSERT_EQ(6u, packets.size());
+        EXPECT_EQ("QINF", packets[0].code);
+        EXPECT_EQ(filler.size() - 4, packets[1].payload.size());
+
+        EXPECT_EQ("DMMV", packets[2].code);
+        EXPECT_EQ(100, packets[2].int16_at(0));
+        EXPECT_EQ(200, packets[2].int16_at(2));
+
+        EXPECT_EQ("DMDN", packets[3].code);
+
+        EXPECT_EQ("DMRM", packets[4].code);
+        EXPECT_EQ(50, packets[4].int16_at(0));
+        EXPECT_EQ(-50, packets[4].int16_at(2));
+
+        EXPECT_EQ("DMMV", packets[5].code);
+        EXPECT_EQ(501, packets[5].int16_at(0));
+        EXPECT_EQ(601, packets[5].int16_at(2));
+    }
+}
+
+} // namespace inputleap
+
+#endif // SYSAPI_UNIX
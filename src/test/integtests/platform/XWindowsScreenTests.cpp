@@ -18,13 +18,139 @@
 
 #include "test/mock/inputleap/MockEventQueue.h"
 #include "platform/XWindowsScreen.h"
+#include "inputleap/Clipboard.h"
 
 #include <gtest/gtest.h>
+#include <X11/Xatom.h>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
 
 namespace inputleap {
 
 using ::testing::_;
+using ::testing::NiceMock;
+
+namespace {
+
+// Asks the server where the pointer is, on a connection of our own.
+void queryPointer(const char* displayName, std::int32_t& x, std::int32_t& y)
+{
+    Display* display = XOpenDisplay(displayName);
+    ASSERT_NE(nullptr, display);
+    Window root, child;
+    int xRoot, yRoot, xWindow, yWindow;
+    unsigned int mask;
+    XQueryPointer(display, DefaultRootWindow(display), &root, &child,
+                  &xRoot, &yRoot, &xWindow, &yWindow, &mask);
+    XCloseDisplay(display);
+    x = xRoot;
+    y = yRoot;
+}
+
+// Owns the PRIMARY selection on a connection of its own and answers requests for its text as
+// UTF8_STRING from a thread, counting the requests.
+class SelectionOwner {
+public:
+    explicit SelectionOwner(const char* displayName) :
+        display_(XOpenDisplay(displayName))
+    {
+        window_ = XCreateSimpleWindow(display_, DefaultRootWindow(display_), 0, 0, 1, 1, 0, 0, 0);
+        targets_ = XInternAtom(display_, "TARGETS", False);
+        utf8_ = XInternAtom(display_, "UTF8_STRING", False);
+        thread_ = std::thread([this]() { run(); });
+    }
+
+    ~SelectionOwner()
+    {
+        stop_ = true;
+        thread_.join();
+        XDestroyWindow(display_, window_);
+        XCloseDisplay(display_);
+    }
+
+    void take(const std::string& text)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        text_ = text;
+        XSetSelectionOwner(display_, XA_PRIMARY, window_, CurrentTime);
+        XSync(display_, False);
+    }
+
+    int requests() const { return requests_; }
+
+private:
+    void run()
+    {
+        while (!stop_) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                while (XPending(display_) > 0) {
+                    XEvent event;
+                    XNextEvent(display_, &event);
+                    if (event.type == SelectionRequest) {
+                        answer(event.xselectionrequest);
+                    }
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void answer(const XSelectionRequestEvent& request)
+    {
+        requests_++;
+
+        XEvent reply;
+        reply.xselection.type = SelectionNotify;
+        reply.xselection.display = request.display;
+        reply.xselection.requestor = request.requestor;
+        reply.xselection.selection = request.selection;
+        reply.xselection.target = request.target;
+        reply.xselection.property = request.property;
+        reply.xselection.time = request.time;
+        if (request.target == targets_) {
+            Atom targets[] = { targets_, utf8_ };
+            XChangeProperty(display_, request.requestor, request.property, XA_ATOM, 32,
+                            PropModeReplace, reinterpret_cast<unsigned char*>(targets), 2);
+        } else if (request.target == utf8_) {
+            XChangeProperty(display_, request.requestor, request.property, utf8_, 8,
+                            PropModeReplace,
+                            reinterpret_cast<const unsigned char*>(text_.data()),
+                            static_cast<int>(text_.size()));
+        } else {
+            reply.xselection.property = None;
+        }
+        XSendEvent(display_, request.requestor, False, 0, &reply);
+        XFlush(display_);
+    }
+
+    Display* display_;
+    Window window_;
+    Atom targets_;
+    Atom utf8_;
+    std::mutex mutex_;
+    std::string text_;
+    std::atomic<int> requests_{0};
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+std::string get_selection_text(const XWindowsScreen& screen)
+{
+    Clipboard clipboard;
+    if (!screen.getClipboard(kClipboardSelection, &clipboard) || !clipboard.open(0)) {
+        return "";
+    }
+    std::string text = clipboard.has(IClipboard::kText) ? clipboard.get(IClipboard::kText) : "";
+    clipboard.close();
+    return text;
+}
+
+} // namespace
 
 TEST(CXWindowsScreenTests, fakeMouseMove_nonPrimary_getCursorPosValuesCorrect)
 {
@@ -47,4 +173,80 @@ TEST(CXWindowsScreenTests, fakeMouseMove_nonPrimary_getCursorPosValuesCorrect)
     ASSERT_EQ(20, y);
 }
 
+TEST(CXWindowsScreenTests, leaveThenEnter_primary_pointerAtCenterThenAtWarp)
+{
+    const char* displayName = std::getenv("DISPLAY");
+
+    if (displayName == nullptr)
+        GTEST_SKIP() << "DISPLAY environment variable not set, skipping test";
+
+    NiceMock<MockEventQueue> eventQueue;
+    XWindowsScreen screen(new XWindowsImpl(), displayName, true, 0, &eventQueue);
+    screen.enable();
+
+    // the grab confines the pointer to the capture window (or warps it
+    // there without one) so it must end up at the center
+    ASSERT_TRUE(screen.leave());
+
+    std::int32_t x, y;
+    screen.getCursorCenter(x, y);
+    std::int32_t xPointer, yPointer;
+    queryPointer(displayName, xPointer, yPointer);
+    EXPECT_EQ(x, xPointer);
+    EXPECT_EQ(y, yPointer);
+
+    // switching back warps the pointer before entering the screen, which
+    // must not be held at the center by the grab
+    screen.warpCursor(x / 2, y / 2);
+    screen.enter();
+
+    queryPointer(displayName, xPointer, yPointer);
+    EXPECT_EQ(x / 2, xPointer);
+    EXPECT_EQ(y / 2, yPointer);
+
+    screen.disable();
+}
+
+TEST(CXWindowsScreenTests, getClipboard_ownerChanged_rereadsSelection)
+{
+    const char* displayName = std::getenv("DISPLAY");
+
+    if (displayName == nullptr)
+        GTEST_SKIP() << "DISPLAY environment variable not set, skipping test";
+
+    NiceMock<MockEventQueue> eventQueue;
+    XWindowsScreen screen(new XWindowsImpl(), displayName, false, 0, &eventQueue);
+    SelectionOwner owner(displayName);
+
+    owner.take("first");
+    EXPECT_EQ("first", get_selection_text(screen));
+    int requests = owner.requests();
+    EXPECT_GT(requests, 0);
+
+    // XFixes reports the new owner, which flushes the cache
+    owner.take("second");
+    EXPECT_EQ("second", get_selection_text(screen));
+    EXPECT_GT(owner.requests(), requests);
+}
+
+TEST(CXWindowsScreenTests, getClipboard_ownerUnchanged_readsNothing)
+{
+    const char* displayName = std::getenv("DISPLAY");
+
+    if (displayName == nullptr)
+        GTEST_SKIP() << "DISPLAY environment variable not set, skipping test";
+
+    NiceMock<MockEventQueue> eventQueue;
+    XWindowsScreen screen(new XWindowsImpl(), displayName, false, 0, &eventQueue);
+    SelectionOwner owner(displayName);
+
+    owner.take("text");
+    EXPECT_EQ("text", get_selection_text(screen));
+    int requests = owner.requests();
+
+    // the tracked owner and its time are unchanged so the cache is used
+    EXPECT_EQ("text", get_selection_text(screen));
+    EXPECT_EQ(requests, owner.requests());
+}
+
 } // namespace inputleap
@@ -0,0 +1,124 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// gtest must be included before Xlib which defines conflicting macros
+#include <gtest/gtest.h>
+
+#include "platform/XWindowsXCBImpl.h"
+#include "platform/XWindowsUtil.h"
+
+#include <cstdlib>
+
+namespace inputleap {
+
+class XWindowsXCBImplTests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_display = XOpenDisplay(nullptr);
+        if (m_display == nullptr && std::getenv("DISPLAY") == nullptr)
+            GTEST_SKIP() << "DISPLAY environment variable not set, skipping test";
+        ASSERT_TRUE(m_display != nullptr);
+
+        // a parent with an override-redirect child that selects some events
+        Window root = DefaultRootWindow(m_display);
+        m_parent = XCreateSimpleWindow(m_display, root, 10, 20, 30, 40, 0, 0, 0);
+        XSetWindowAttributes attr;
+        attr.override_redirect = True;
+        attr.event_mask = PointerMotionMask | PropertyChangeMask;
+        m_child = XCreateWindow(m_display, m_parent, 1, 2, 3, 4, 0, 0, InputOnly,
+                                reinterpret_cast<Visual*>(CopyFromParent),
+                                CWOverrideRedirect | CWEventMask, &attr);
+        XSync(m_display, False);
+    }
+
+    void TearDown() override
+    {
+        if (m_display != nullptr) {
+            XDestroyWindow(m_display, m_parent);
+            XCloseDisplay(m_display);
+        }
+    }
+
+    Display* m_display = nullptr;
+    Window m_parent = None;
+    Window m_child = None;
+};
+
+TEST_F(XWindowsXCBImplTests, getWindowAttributesBatch_matchesXlib)
+{
+    // the last window doesn't exist
+    Window windows[] = { m_parent, m_child, m_child + 1000 };
+    XWindowAttributes xlibAttrs[3];
+    XWindowAttributes xcbAttrs[3];
+    Status xlibStatus[3];
+    Status xcbStatus[3];
+    XWindowsImpl xlib;
+    XWindowsXCBImpl xcb;
+    {
+        XWindowsUtil::ErrorLock lock(m_display);
+        xlib.do_XGetWindowAttributesBatch(m_display, windows, 3, xlibAttrs, xlibStatus);
+    }
+    xcb.do_XGetWindowAttributesBatch(m_display, windows, 3, xcbAttrs, xcbStatus);
+
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_NE(0, xcbStatus[i]);
+        ASSERT_NE(0, xlibStatus[i]);
+        EXPECT_EQ(xlibAttrs[i].x, xcbAttrs[i].x);
+        EXPECT_EQ(xlibAttrs[i].y, xcbAttrs[i].y);
+        EXPECT_EQ(xlibAttrs[i].width, xcbAttrs[i].width);
+        EXPECT_EQ(xlibAttrs[i].height, xcbAttrs[i].height);
+        EXPECT_EQ(xlibAttrs[i].root, xcbAttrs[i].root);
+        EXPECT_EQ(xlibAttrs[i].screen, xcbAttrs[i].screen);
+        EXPECT_EQ(xlibAttrs[i].visual, xcbAttrs[i].visual);
+        EXPECT_EQ(xlibAttrs[i].c_class, xcbAttrs[i].c_class);
+        EXPECT_EQ(xlibAttrs[i].override_redirect, xcbAttrs[i].override_redirect);
+        EXPECT_EQ(xlibAttrs[i].all_event_masks, xcbAttrs[i].all_event_masks);
+        EXPECT_EQ(xlibAttrs[i].your_event_mask, xcbAttrs[i].your_event_mask);
+    }
+    EXPECT_EQ(0, xlibStatus[2]);
+    EXPECT_EQ(0, xcbStatus[2]);
+    EXPECT_EQ(PointerMotionMask | PropertyChangeMask, xcbAttrs[1].all_event_masks);
+    EXPECT_EQ(True, xcbAttrs[1].override_redirect);
+}
+
+TEST_F(XWindowsXCBImplTests, queryTreeBatch_matchesXlib)
+{
+    Window windows[] = { m_parent, m_child, m_child + 1000 };
+    std::vector<Window> xlibChildren[3];
+    std::vector<Window> xcbChildren[3];
+    Status xlibStatus[3];
+    Status xcbStatus[3];
+    XWindowsImpl xlib;
+    XWindowsXCBImpl xcb;
+    {
+        XWindowsUtil::ErrorLock lock(m_display);
+        xlib.do_XQueryTreeBatch(m_display, windows, 3, xlibChildren, xlibStatus);
+    }
+    xcb.do_XQueryTreeBatch(m_display, windows, 3, xcbChildren, xcbStatus);
+
+    EXPECT_EQ(std::vector<Window>(1, m_child), xcbChildren[0]);
+    EXPECT_TRUE(xcbChildren[1].empty());
+    EXPECT_EQ(0, xcbStatus[2]);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(xlibStatus[i] != 0, xcbStatus[i] != 0);
+        EXPECT_EQ(xlibChildren[i], xcbChildren[i]);
+    }
+}
+
+} // namespace inputleap
@@ -42,6 +42,12 @@ public:
     MOCK_METHOD1(deleteTimer, void(EventQueueTimer*));
     MOCK_METHOD0(getSystemTarget, void*());
     MOCK_CONST_METHOD0(waitForReady, void());
+    MOCK_METHOD1(set_dispatch_stats_enabled, void(bool));
+    MOCK_CONST_METHOD0(is_dispatch_stats_enabled, bool());
+    MOCK_CONST_METHOD0(get_dispatch_stats_report, std::string());
+    MOCK_METHOD2(set_event_merger, void(EventType, const EventMerger&));
+    MOCK_CONST_METHOD0(get_merged_event_count, std::uint64_t());
+    MOCK_CONST_METHOD1(write_metrics, void(MetricsText&));
 };
 
 } // namespace inputleap
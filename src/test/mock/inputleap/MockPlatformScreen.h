@@ -0,0 +1,84 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "inputleap/PlatformScreen.h"
+
+#include <gmock/gmock.h>
+
+namespace inputleap {
+
+// mocks the pure virtual methods of PlatformScreen and the key state methods that
+// synthesize input or set options, so no key state is needed
+class MockPlatformScreen : public PlatformScreen
+{
+public:
+    explicit MockPlatformScreen(IEventQueue* events) : PlatformScreen(events) { }
+
+    // IScreen
+    MOCK_CONST_METHOD0(getEventTarget, void*());
+    MOCK_CONST_METHOD2(getClipboard, bool(ClipboardID, IClipboard*));
+    MOCK_CONST_METHOD4(getShape, void(std::int32_t&, std::int32_t&, std::int32_t&,
+                                      std::int32_t&));
+    MOCK_CONST_METHOD2(getCursorPos, void(std::int32_t&, std::int32_t&));
+
+    // IPrimaryScreen
+    MOCK_METHOD1(reconfigure, void(std::uint32_t));
+    MOCK_METHOD2(warpCursor, void(std::int32_t, std::int32_t));
+    MOCK_METHOD2(registerHotKey, std::uint32_t(KeyID, KeyModifierMask));
+    MOCK_METHOD1(unregisterHotKey, void(std::uint32_t));
+    MOCK_METHOD0(fakeInputBegin, void());
+    MOCK_METHOD0(fakeInputEnd, void());
+    MOCK_CONST_METHOD0(getJumpZoneSize, std::int32_t());
+    MOCK_CONST_METHOD1(isAnyMouseButtonDown, bool(std::uint32_t&));
+    MOCK_CONST_METHOD2(getCursorCenter, void(std::int32_t&, std::int32_t&));
+
+    // ISecondaryScreen
+    MOCK_METHOD0(fakeBatchBegin, void());
+    MOCK_METHOD0(fakeBatchEnd, void());
+    MOCK_METHOD2(fakeMouseButton, void(ButtonID, bool));
+    MOCK_METHOD2(fakeMouseMove, void(std::int32_t, std::int32_t));
+    MOCK_CONST_METHOD2(fakeMouseRelativeMove, void(std::int32_t, std::int32_t));
+    MOCK_CONST_METHOD2(fakeMouseWheel, void(std::int32_t, std::int32_t));
+
+    // IKeyState
+    MOCK_METHOD1(setHalfDuplexMask, void(KeyModifierMask));
+    MOCK_METHOD3(fakeKeyDown, void(KeyID, KeyModifierMask, KeyButton));
+
+    // IPlatformScreen
+    MOCK_METHOD0(enable, void());
+    MOCK_METHOD0(disable, void());
+    MOCK_METHOD0(enter, void());
+    MOCK_METHOD0(leave, bool());
+    MOCK_METHOD2(setClipboard, bool(ClipboardID, const IClipboard*));
+    MOCK_METHOD0(checkClipboards, void());
+    MOCK_METHOD1(openScreensaver, void(bool));
+    MOCK_METHOD0(closeScreensaver, void());
+    MOCK_METHOD1(screensaver, void(bool));
+    MOCK_METHOD0(resetOptions, void());
+    MOCK_METHOD1(setOptions, void(const OptionsList&));
+    MOCK_METHOD1(setSequenceNumber, void(std::uint32_t));
+    MOCK_CONST_METHOD0(isPrimary, bool());
+    MOCK_METHOD1(handle_system_event, void(const Event&));
+
+    // PlatformScreen
+    MOCK_METHOD0(updateButtons, void());
+    MOCK_CONST_METHOD0(getKeyState, IKeyState*());
+};
+
+} // namespace inputleap
@@ -0,0 +1,192 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/EventQueue.h"
+
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+namespace inputleap {
+
+namespace {
+
+// Queues events before running the queue, which moves them into its buffer in order and then
+// dispatches them until the quit event.
+class EventQueueHarness {
+public:
+    EventQueueHarness()
+    {
+        for (void* target : { static_cast<void*>(&screen_), static_cast<void*>(&other_) }) {
+            for (EventType type : { EventType::PRIMARY_SCREEN_MOTION_ON_SECONDARY,
+                                    EventType::PRIMARY_SCREEN_BUTTON_DOWN,
+                                    EventType::DATA_SOCKET_CONNECTED }) {
+                events_.add_handler(type, target, [this, target](const Event& event) {
+                    int value = event.getType() == EventType::PRIMARY_SCREEN_MOTION_ON_SECONDARY
+                            ? event.get_data_as<int>() : 0;
+                    dispatched_.push_back({ event.getType(), target == &screen_ ? value : -1 });
+                });
+            }
+        }
+    }
+
+    void enable_merging()
+    {
+        events_.set_event_merger(EventType::PRIMARY_SCREEN_MOTION_ON_SECONDARY,
+                                 [](Event& queued, const Event& later) {
+            queued.get_data_as<int>() += later.get_data_as<int>();
+        });
+    }
+
+    void motion(int delta)
+    {
+        events_.add_event(Event(EventType::PRIMARY_SCREEN_MOTION_ON_SECONDARY, &screen_,
+                                create_event_data<int>(delta)));
+    }
+
+    void add(EventType type, bool other_target = false)
+    {
+        events_.add_event(Event(type, other_target ? static_cast<void*>(&other_)
+                                                   : static_cast<void*>(&screen_)));
+    }
+
+    void add_immediately(EventType type)
+    {
+        events_.add_event(Event(type, &screen_, nullptr, Event::kDeliverImmediately));
+    }
+
+    void run()
+    {
+        events_.add_event(Event(EventType::QUIT));
+        events_.loop();
+    }
+
+    std::uint64_t merged() const { return events_.get_merged_event_count(); }
+
+    // type and motion of the dispatched events for the screen, -1 for the other target
+    std::vector<std::pair<EventType, int>> dispatched_;
+
+private:
+    EventQueue events_;
+    int screen_ = 0;
+    int other_ = 0;
+};
+
+const EventType kMotion = EventType::PRIMARY_SCREEN_MOTION_ON_SECONDARY;
+const EventType kButton = EventType::PRIMARY_SCREEN_BUTTON_DOWN;
+const EventType kSocket = EventType::DATA_SOCKET_CONNECTED;
+
+} // namespace
+
+TEST(EventQueueTests, loop_queuedMotion_mergedUntilButton)
+{
+    EventQueueHarness harness;
+    harness.enable_merging();
+
+    harness.motion(1);
+    harness.motion(2);
+    harness.motion(3);
+    harness.add(kButton);
+    harness.motion(4);
+    harness.motion(5);
+    harness.run();
+
+    std::vector<std::pair<EventType, int>> expected = {
+        { kMotion, 6 }, { kButton, 0 }, { kMotion, 9 }
+    };
+    EXPECT_EQ(harness.dispatched_, expected);
+    EXPECT_EQ(harness.merged(), 3u);
+}
+
+TEST(EventQueueTests, loop_eventForOtherTarget_motionStillMerged)
+{
+    EventQueueHarness harness;
+    harness.enable_merging();
+
+    harness.motion(1);
+    harness.add(kSocket, true);
+    harness.motion(2);
+    harness.run();
+
+    std::vector<std::pair<EventType, int>> expected = { { kMotion, 3 }, { kSocket, -1 } };
+    EXPECT_EQ(harness.dispatched_, expected);
+}
+
+TEST(EventQueueTests, loop_otherEventForTarget_stopsMerge)
+{
+    EventQueueHarness harness;
+    harness.enable_merging();
+
+    harness.motion(1);
+    harness.add(kSocket);
+    harness.motion(2);
+    harness.run();
+
+    std::vector<std::pair<EventType, int>> expected = {
+        { kMotion, 1 }, { kSocket, 0 }, { kMotion, 2 }
+    };
+    EXPECT_EQ(harness.dispatched_, expected);
+    EXPECT_EQ(harness.merged(), 0u);
+}
+
+TEST(EventQueueTests, loop_inputForOtherTarget_stopsMerge)
+{
+    EventQueueHarness harness;
+    harness.enable_merging();
+
+    harness.motion(1);
+    harness.add(kButton, true);
+    harness.motion(2);
+    harness.run();
+
+    std::vector<std::pair<EventType, int>> expected = {
+        { kMotion, 1 }, { kButton, -1 }, { kMotion, 2 }
+    };
+    EXPECT_EQ(harness.dispatched_, expected);
+}
+
+TEST(EventQueueTests, loop_immediateInput_stopsMerge)
+{
+    EventQueueHarness harness;
+    harness.enable_merging();
+
+    harness.motion(1);
+    harness.add_immediately(kButton);
+    harness.motion(2);
+    harness.run();
+
+    std::vector<std::pair<EventType, int>> expected = {
+        { kButton, 0 }, { kMotion, 1 }, { kMotion, 2 }
+    };
+    EXPECT_EQ(harness.dispatched_, expected);
+    EXPECT_EQ(harness.merged(), 0u);
+}
+
+TEST(EventQueueTests, loop_noMerger_motionQueuedSeparately)
+{
+    EventQueueHarness harness;
+
+    harness.motion(1);
+    harness.motion(2);
+    harness.run();
+
+    std::vector<std::pair<EventType, int>> expected = { { kMotion, 1 }, { kMotion, 2 } };
+    EXPECT_EQ(harness.dispatched_, expected);
+    EXPECT_EQ(harness.merged(), 0u);
+}
+
+} // namespace inputleap
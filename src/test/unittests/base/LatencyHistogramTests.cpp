@@ -0,0 +1,130 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/LatencyHistogram.h"
+#include "base/EventDispatchStats.h"
+#include "test/global/TestEventQueue.h"
+
+#include <gtest/gtest.h>
+
+namespace inputleap {
+
+TEST(LatencyHistogramTests, empty_percentilesAreZero)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0u, histogram.value_at_percentile(50.0));
+    EXPECT_EQ(0u, histogram.max());
+}
+
+TEST(LatencyHistogramTests, smallValues_recordedExactly)
+{
+    LatencyHistogram histogram;
+    for (std::uint64_t i = 1; i <= 10; ++i) {
+        histogram.record(i);
+    }
+    EXPECT_EQ(10u, histogram.count());
+    EXPECT_EQ(5u, histogram.value_at_percentile(50.0));
+    EXPECT_EQ(10u, histogram.value_at_percentile(100.0));
+    EXPECT_EQ(1u, histogram.value_at_percentile(0.0));
+}
+
+TEST(LatencyHistogramTests, largeValues_withinRelativeError)
+{
+    LatencyHistogram histogram;
+    for (std::uint64_t i = 1; i <= 100000; ++i) {
+        histogram.record(i);
+    }
+    auto p50 = histogram.value_at_percentile(50.0);
+    auto p99 = histogram.value_at_percentile(99.0);
+    auto p999 = histogram.value_at_percentile(99.9);
+    EXPECT_GE(p50, 50000u);
+    EXPECT_LE(p50, 50000u * 9 / 8);
+    EXPECT_GE(p99, 99000u);
+    EXPECT_LE(p99, 100000u);
+    EXPECT_GE(p999, 99900u);
+    EXPECT_EQ(100000u, histogram.max());
+}
+
+TEST(LatencyHistogramTests, outlier_onlyAffectsHighPercentiles)
+{
+    LatencyHistogram histogram;
+    for (int i = 0; i < 999; ++i) {
+        histogram.record(100);
+    }
+    histogram.record(5000000);
+    EXPECT_LE(histogram.value_at_percentile(99.0), 112u);
+    EXPECT_EQ(5000000u, histogram.value_at_percentile(100.0));
+}
+
+TEST(LatencyHistogramTests, hugeValue_clamped)
+{
+    LatencyHistogram histogram;
+    histogram.record(~std::uint64_t{0});
+    EXPECT_EQ(LatencyHistogram::kMaxTrackableValue, histogram.max());
+    EXPECT_EQ(LatencyHistogram::kMaxTrackableValue, histogram.value_at_percentile(50.0));
+}
+
+TEST(LatencyHistogramTests, reset_forgetsValues)
+{
+    LatencyHistogram histogram;
+    histogram.record(42);
+    histogram.reset();
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0u, histogram.value_at_percentile(99.0));
+}
+
+TEST(EventDispatchStatsTests, report_listsOnlyTypesWithSamples)
+{
+    EventDispatchStats stats;
+    stats.record_queue_wait(EventType::KEY_STATE_KEY_DOWN, 10);
+    stats.record_handler(EventType::KEY_STATE_KEY_DOWN, 20);
+
+    std::string report = stats.report();
+    EXPECT_NE(std::string::npos, report.find("KEY_STATE_KEY_DOWN: n=1"));
+    EXPECT_EQ(std::string::npos, report.find("KEY_STATE_KEY_UP"));
+}
+
+TEST(EventDispatchStatsTests, eventQueue_disabled_recordsNothing)
+{
+    TestEventQueue events;
+    int target = 0;
+    events.add_handler(EventType::CLIPBOARD_GRABBED, &target, [](const Event&) {});
+
+    events.dispatchEvent(Event(EventType::CLIPBOARD_GRABBED, &target));
+
+    EXPECT_FALSE(events.is_dispatch_stats_enabled());
+    EXPECT_EQ(std::string::npos,
+              events.get_dispatch_stats_report().find("CLIPBOARD_GRABBED"));
+}
+
+TEST(EventDispatchStatsTests, eventQueue_enabled_recordsWaitAndHandler)
+{
+    TestEventQueue events;
+    int target = 0;
+    events.add_handler(EventType::CLIPBOARD_GRABBED, &target, [](const Event&) {});
+    events.set_dispatch_stats_enabled(true);
+
+    Event event(EventType::CLIPBOARD_GRABBED, &target);
+    event.set_enqueue_time(std::chrono::steady_clock::now() - std::chrono::milliseconds(5));
+    events.dispatchEvent(event);
+
+    std::string report = events.get_dispatch_stats_report();
+    EXPECT_NE(std::string::npos, report.find("CLIPBOARD_GRABBED: n=1 wait[p50="));
+}
+
+} // namespace inputleap
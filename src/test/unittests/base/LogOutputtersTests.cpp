@@ -0,0 +1,136 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/log_outputters.h"
+#include "io/filesystem.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace inputleap {
+
+namespace {
+
+// a log file in the temporary directory that is removed with all rotated generations
+class TempLogFile {
+public:
+    explicit TempLogFile(const char* name) :
+        path_((fs::temp_directory_path() / name).u8string())
+    {
+        remove_all();
+    }
+
+    ~TempLogFile() { remove_all(); }
+
+    const std::string& path() const { return path_; }
+
+    std::string generation(int index) const { return path_ + "." + std::to_string(index); }
+
+    static std::string read(const std::string& path)
+    {
+        std::ifstream stream;
+        open_utf8_path(stream, fs::u8path(path));
+        std::stringstream contents;
+        contents << stream.rdbuf();
+        return contents.str();
+    }
+
+private:
+    void remove_all()
+    {
+        std::error_code ec;
+        fs::remove(fs::u8path(path_), ec);
+        for (int i = 1; i <= 10; i++) {
+            fs::remove(fs::u8path(generation(i)), ec);
+        }
+    }
+
+    std::string path_;
+};
+
+} // namespace
+
+TEST(FileLogOutputterTests, write_info_bufferedUntilFlushInterval)
+{
+    TempLogFile file("inputleap-test-buffered.log");
+    FileLogOutputter outputter(file.path().c_str());
+    outputter.setFlushInterval(std::chrono::milliseconds(50));
+
+    outputter.write(kINFO, "info message");
+    EXPECT_EQ(TempLogFile::read(file.path()), "");
+
+    std::string contents;
+    for (int i = 0; i < 200 && contents.empty(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        contents = TempLogFile::read(file.path());
+    }
+    EXPECT_EQ(contents, "info message\n");
+}
+
+TEST(FileLogOutputterTests, write_warning_flushedImmediately)
+{
+    TempLogFile file("inputleap-test-warning.log");
+    FileLogOutputter outputter(file.path().c_str());
+    outputter.setFlushInterval(std::chrono::hours(1));
+
+    outputter.write(kINFO, "info message");
+    outputter.write(kWARNING, "warning message");
+
+    EXPECT_EQ(TempLogFile::read(file.path()), "info message\nwarning message\n");
+}
+
+TEST(FileLogOutputterTests, close_bufferedMessages_written)
+{
+    TempLogFile file("inputleap-test-close.log");
+    FileLogOutputter outputter(file.path().c_str());
+    outputter.setFlushInterval(std::chrono::hours(1));
+
+    outputter.write(kDEBUG, "debug message");
+    outputter.close();
+    EXPECT_EQ(TempLogFile::read(file.path()), "debug message\n");
+
+    // writing after close reopens the file
+    outputter.write(kERROR, "error message");
+    EXPECT_EQ(TempLogFile::read(file.path()), "debug message\nerror message\n");
+}
+
+TEST(FileLogOutputterTests, write_exceedsMaxSize_rotatesGenerations)
+{
+    TempLogFile file("inputleap-test-rotate.log");
+    {
+        FileLogOutputter outputter(file.path().c_str());
+        outputter.setMaxSize(20);
+        outputter.setGenerations(3);
+
+        // each message is 10 bytes with the newline, every third one triggers a rotation
+        for (int i = 0; i < 15; i++) {
+            outputter.write(kINFO, ("message " + std::to_string(i % 10)).c_str());
+        }
+    }
+
+    EXPECT_EQ(TempLogFile::read(file.path()), "");
+    EXPECT_EQ(TempLogFile::read(file.generation(1)), "message 2\nmessage 3\nmessage 4\n");
+    EXPECT_EQ(TempLogFile::read(file.generation(2)), "message 9\nmessage 0\nmessage 1\n");
+    EXPECT_EQ(TempLogFile::read(file.generation(3)), "message 6\nmessage 7\nmessage 8\n");
+    EXPECT_FALSE(fs::exists(fs::u8path(file.generation(4))));
+}
+
+} // namespace inputleap
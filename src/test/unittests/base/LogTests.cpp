@@ -0,0 +1,405 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/AsyncLogWriter.h"
+#include "base/ILogOutputter.h"
+#include "base/Log.h"
+#include "base/LogRing.h"
+#include "base/Stopwatch.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace inputleap {
+
+namespace {
+
+LogRing::Record make_record(std::uint64_t sequence, std::size_t length)
+{
+    LogRing::Record record{};
+    record.sequence = sequence;
+    record.priority = kINFO;
+    record.length = static_cast<std::uint32_t>(length);
+    return record;
+}
+
+struct WrittenMessage {
+    ELevel priority;
+    std::string text;
+};
+
+// collects the messages passed to the write function of an AsyncLogWriter
+class MessageCollector {
+public:
+    AsyncLogWriter::WriteFunc write_func()
+    {
+        return [this](ELevel priority, std::time_t, const char*, int, const char* text) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            blocked_cv_.wait(lock, [this]() { return !blocked_; });
+            messages_.push_back({priority, text});
+        };
+    }
+
+    void set_blocked(bool blocked)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            blocked_ = blocked;
+        }
+        blocked_cv_.notify_all();
+    }
+
+    std::vector<WrittenMessage> messages()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable blocked_cv_;
+    bool blocked_ = false;
+    std::vector<WrittenMessage> messages_;
+};
+
+// an outputter that is as slow as writing to a congested terminal or disk
+class SlowLogOutputter : public ILogOutputter {
+public:
+    void open(const char*) override { }
+    void close() override { }
+    void show(bool) override { }
+    bool write(ELevel, const char*) override
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        count_++;
+        // don't pass the messages on to the console
+        return false;
+    }
+
+    int count() const { return count_; }
+
+private:
+    std::atomic<int> count_{0};
+};
+
+// an outputter that doesn't return from write until it's opened, like a hung terminal
+class LatchedLogOutputter : public ILogOutputter {
+public:
+    void open(const char*) override { }
+    void close() override { }
+    void show(bool) override { }
+    bool write(ELevel, const char*) override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        opened_cv_.wait(lock, [this]() { return opened_; });
+        count_++;
+        // don't pass the messages on to the console
+        return false;
+    }
+
+    void open_latch()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            opened_ = true;
+        }
+        opened_cv_.notify_all();
+    }
+
+    int count()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable opened_cv_;
+    bool opened_ = false;
+    int count_ = 0;
+};
+
+// counts how often a message argument is evaluated
+class ArgumentCounter {
+public:
+    const char* evaluate()
+    {
+        count_++;
+        return "argument";
+    }
+
+    int count() const { return count_; }
+
+private:
+    int count_ = 0;
+};
+
+// restores the log filter at the end of a test
+class ScopedLogFilter {
+public:
+    explicit ScopedLogFilter(int filter) : saved_(CLOG->getFilter()) { CLOG->setFilter(filter); }
+    ~ScopedLogFilter() { CLOG->setFilter(saved_); }
+
+private:
+    int saved_;
+};
+
+} // namespace
+
+TEST(LogRingTests, push_thenFront_returnsRecord)
+{
+    LogRing ring(1024);
+    ASSERT_TRUE(ring.push(make_record(7, 5), "hello"));
+
+    const LogRing::Record* record = ring.front();
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->sequence, 7u);
+    EXPECT_STREQ(record->text(), "hello");
+
+    ring.pop();
+    EXPECT_EQ(ring.front(), nullptr);
+}
+
+TEST(LogRingTests, push_full_returnsFalse)
+{
+    LogRing ring(1024);
+    std::string text(100, 'x');
+
+    int pushed = 0;
+    while (ring.push(make_record(pushed, text.size()), text.c_str())) {
+        pushed++;
+    }
+    EXPECT_GT(pushed, 0);
+    EXPECT_LT(pushed, 1024 / 100);
+
+    // the records pushed before the ring became full are intact
+    for (int i = 0; i < pushed; i++) {
+        const LogRing::Record* record = ring.front();
+        ASSERT_NE(record, nullptr);
+        EXPECT_EQ(record->sequence, static_cast<std::uint64_t>(i));
+        EXPECT_EQ(std::string(record->text()), text);
+        ring.pop();
+    }
+    EXPECT_EQ(ring.front(), nullptr);
+}
+
+TEST(LogRingTests, push_acrossEndOfBuffer_wrapsAround)
+{
+    LogRing ring(1024);
+
+    // records of varying sizes hit every possible gap at the end of the buffer
+    for (std::uint64_t i = 0; i < 1000; i++) {
+        std::string text(i % 150, static_cast<char>('a' + i % 26));
+        ASSERT_TRUE(ring.push(make_record(i, text.size()), text.c_str()));
+
+        const LogRing::Record* record = ring.front();
+        ASSERT_NE(record, nullptr);
+        EXPECT_EQ(record->sequence, i);
+        EXPECT_EQ(std::string(record->text()), text);
+        ring.pop();
+    }
+    EXPECT_EQ(ring.front(), nullptr);
+}
+
+TEST(AsyncLogWriterTests, push_manyThreads_writesAllInOrder)
+{
+    MessageCollector collector;
+    const int kThreads = 4;
+    const int kMessagesPerThread = 1000;
+    {
+        AsyncLogWriter writer(collector.write_func());
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; t++) {
+            threads.emplace_back([&writer, t]() {
+                for (int i = 0; i < kMessagesPerThread; i++) {
+                    std::string text = std::to_string(t) + ":" + std::to_string(i);
+                    while (!writer.push(kDEBUG, 0, __FILE__, __LINE__, text.c_str(),
+                                        text.size())) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        writer.flush();
+    }
+
+    // the messages of each thread keep their order
+    std::vector<int> next(kThreads, 0);
+    int written = 0;
+    for (const auto& message : collector.messages()) {
+        if (message.priority != kDEBUG) {
+            continue; // drop reports
+        }
+        int thread = std::stoi(message.text.substr(0, message.text.find(':')));
+        int index = std::stoi(message.text.substr(message.text.find(':') + 1));
+        EXPECT_EQ(index, next[thread]);
+        next[thread] = index + 1;
+        written++;
+    }
+    EXPECT_EQ(written, kThreads * kMessagesPerThread);
+}
+
+TEST(AsyncLogWriterTests, push_writerStalled_dropsAndReportsCount)
+{
+    MessageCollector collector;
+    collector.set_blocked(true);
+
+    std::uint64_t dropped = 0;
+    {
+        AsyncLogWriter writer(collector.write_func(), 1024);
+
+        // the writer takes the first message and stalls writing it, the rest fill the ring
+        std::string text(100, 'x');
+        int accepted = 0;
+        for (int i = 0; i < 100; i++) {
+            if (writer.push(kINFO, 0, __FILE__, __LINE__, text.c_str(), text.size())) {
+                accepted++;
+            }
+        }
+        dropped = writer.dropped_count();
+        EXPECT_EQ(dropped, static_cast<std::uint64_t>(100 - accepted));
+        EXPECT_GT(dropped, 0u);
+
+        collector.set_blocked(false);
+        writer.flush();
+    }
+
+    auto messages = collector.messages();
+    ASSERT_FALSE(messages.empty());
+    EXPECT_EQ(messages.back().priority, kWARNING);
+    EXPECT_EQ(messages.back().text, std::to_string(dropped) +
+                                    " log messages dropped because the log ring was full");
+}
+
+TEST(AsyncLogWriterTests, push_writerIdle_wakesWriterWithoutFlush)
+{
+    MessageCollector collector;
+    AsyncLogWriter writer(collector.write_func());
+
+    // the writer has nothing to do and waits without a timeout
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::string text = "wake up";
+    EXPECT_TRUE(writer.push(kINFO, 0, __FILE__, __LINE__, text.c_str(), text.size()));
+
+    Stopwatch timer(false);
+    while (collector.messages().empty() && timer.getTime() < 5.0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(collector.messages().size(), 1u);
+    EXPECT_EQ(collector.messages()[0].text, text);
+}
+
+TEST(AsyncLogWriterTests, push_longMessage_truncated)
+{
+    MessageCollector collector;
+    {
+        AsyncLogWriter writer(collector.write_func(), 1024);
+        std::string text(5000, 'x');
+        EXPECT_TRUE(writer.push(kINFO, 0, __FILE__, __LINE__, text.c_str(), text.size()));
+        writer.flush();
+    }
+
+    auto messages = collector.messages();
+    ASSERT_EQ(messages.size(), 1u);
+    EXPECT_LT(messages[0].text.size(), 1024u);
+    EXPECT_EQ(messages[0].text.find_first_not_of('x'), std::string::npos);
+}
+
+TEST(LogTests, log_priorityFilteredOut_argumentsNotEvaluated)
+{
+    ScopedLogFilter filter(kINFO);
+    ArgumentCounter counter;
+
+    LOG((CLOG_DEBUG "suppressed %s", counter.evaluate()));
+    LOG((CLOG_DEBUG5 "suppressed %s", counter.evaluate()));
+    LOGC(true, (CLOG_DEBUG2 "suppressed %s", counter.evaluate()));
+
+    EXPECT_EQ(counter.count(), 0);
+}
+
+TEST(LogTests, log_priorityEnabled_argumentsEvaluatedOnce)
+{
+    ScopedLogFilter filter(kINFO);
+    SlowLogOutputter* outputter = new SlowLogOutputter;
+    CLOG->insert(outputter);
+    ArgumentCounter counter;
+
+    LOG((CLOG_INFO "enabled %s", counter.evaluate()));
+    LOGC(true, (CLOG_WARN "enabled %s", counter.evaluate()));
+    LOGC(false, (CLOG_WARN "suppressed %s", counter.evaluate()));
+
+    CLOG->remove(outputter);
+    EXPECT_EQ(counter.count(), 2);
+    EXPECT_EQ(outputter->count(), 2);
+    delete outputter;
+}
+
+// Logs from another thread while the outputter can't write anything.  Without the asynchronous
+// writer the first call would wait for the outputter.
+TEST(LogTests, print_async_hotThreadDoesNotWaitForOutputters)
+{
+    const int kMessages = 500;
+    ScopedLogFilter filter(kDEBUG);
+    LatchedLogOutputter* outputter = new LatchedLogOutputter;
+    CLOG->insert(outputter);
+
+    CLOG->setAsync(true);
+    std::uint64_t dropped_before = CLOG->getDroppedCount();
+
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    bool done = false;
+    std::thread logger([&]() {
+        for (int i = 0; i < kMessages; i++) {
+            LOG((CLOG_DEBUG "async log message %d of %d: %s", i, kMessages, "text"));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        done_cv.notify_all();
+    });
+
+    // the timeout only keeps a regression from hanging the test
+    bool returned;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        returned = done_cv.wait_for(lock, std::chrono::seconds(30), [&]() { return done; });
+    }
+    int written_while_latched = outputter->count();
+
+    outputter->open_latch();
+    logger.join();
+    CLOG->setAsync(false);
+    std::uint64_t dropped = CLOG->getDroppedCount() - dropped_before;
+    CLOG->remove(outputter);
+
+    EXPECT_TRUE(returned);
+    EXPECT_EQ(written_while_latched, 0);
+    // every message was either written or counted, plus one report per batch of drops
+    EXPECT_GE(outputter->count() + static_cast<int>(dropped), kMessages);
+    delete outputter;
+}
+
+} // namespace inputleap
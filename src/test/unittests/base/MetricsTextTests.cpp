@@ -0,0 +1,62 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "base/MetricsText.h"
+#include "base/LatencyHistogram.h"
+
+#include <gtest/gtest.h>
+
+namespace inputleap {
+
+TEST(MetricsTextTests, sample_withoutLabels_followsFamily)
+{
+    MetricsText metrics;
+    metrics.family("inputleap_clients", "gauge", "Connected clients.");
+    metrics.sample("inputleap_clients", std::uint64_t(3));
+
+    EXPECT_EQ("# HELP inputleap_clients Connected clients.\n"
+              "# TYPE inputleap_clients gauge\n"
+              "inputleap_clients 3\n", metrics.str());
+}
+
+TEST(MetricsTextTests, sample_labelValues_escaped)
+{
+    MetricsText metrics;
+    metrics.sample("bytes_total", std::uint64_t(7),
+                   { { "client", "a\"b\\c\nd" }, { "code", "DMMV" } });
+
+    EXPECT_EQ("bytes_total{client=\"a\\\"b\\\\c\\nd\",code=\"DMMV\"} 7\n", metrics.str());
+}
+
+TEST(MetricsTextTests, summary_histogramInMicroseconds_quantilesSumAndCountInSeconds)
+{
+    LatencyHistogram histogram;
+    for (std::uint64_t i = 1; i <= 10; ++i) {
+        histogram.record(i);
+    }
+
+    MetricsText metrics;
+    metrics.summary("wait_seconds", histogram, { { "type", "X" } });
+
+    EXPECT_EQ("wait_seconds{type=\"X\",quantile=\"0.5\"} 5e-06\n"
+              "wait_seconds{type=\"X\",quantile=\"0.99\"} 1e-05\n"
+              "wait_seconds{type=\"X\",quantile=\"0.999\"} 1e-05\n"
+              "wait_seconds_sum{type=\"X\"} 5.5e-05\n"
+              "wait_seconds_count{type=\"X\"} 10\n", metrics.str());
+}
+
+} // namespace inputleap
@@ -0,0 +1,215 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define INPUTLEAP_TEST_ENV
+
+#include "client/ServerProxy.h"
+#include "client/Client.h"
+#include "inputleap/ProtocolUtil.h"
+#include "inputleap/Screen.h"
+#include "inputleap/protocol_types.h"
+#include "net/ISocketFactory.h"
+#include "test/mock/inputleap/MockEventQueue.h"
+#include "test/mock/inputleap/MockPlatformScreen.h"
+#include "test/mock/io/MockStream.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <vector>
+
+using ::testing::_;
+using ::testing::InSequence;
+using ::testing::Invoke;
+using ::testing::Mock;
+using ::testing::NiceMock;
+
+namespace inputleap {
+
+namespace {
+
+const double kMotionInterval = 1.0;
+
+// Creates one-shot timers that only fire when the test says so.
+class TimerEventQueue : public NiceMock<MockEventQueue> {
+public:
+    TimerEventQueue()
+    {
+        ON_CALL(*this, newOneShotTimer(_, _)).WillByDefault(Invoke([this](double timeout, void*) {
+            timeouts_.push_back(timeout);
+            return reinterpret_cast<EventQueueTimer*>(timeouts_.size());
+        }));
+        ON_CALL(*this, add_handler(_, _, _)).WillByDefault(Invoke(
+                [this](EventType type, void* target, const EventHandler& handler) {
+            if (type == EventType::TIMER) {
+                handlers_[target] = handler;
+            }
+        }));
+        ON_CALL(*this, removeHandler(_, _)).WillByDefault(Invoke([this](EventType type,
+                                                                        void* target) {
+            if (type == EventType::TIMER) {
+                handlers_.erase(target);
+            }
+        }));
+    }
+
+    // fires the pending timer that was created with at most the given timeout
+    bool fire_timer(double max_timeout)
+    {
+        for (auto& i : handlers_) {
+            std::size_t index = reinterpret_cast<std::size_t>(i.first) - 1;
+            if (timeouts_[index] <= max_timeout) {
+                EventHandler handler = i.second;
+                handler(Event(EventType::TIMER, i.first));
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::vector<double> timeouts_;
+    std::map<void*, EventHandler> handlers_;
+};
+
+// Serves the messages added to it to the reader.
+class InputStream : public NiceMock<MockStream> {
+public:
+    InputStream()
+    {
+        ON_CALL(*this, read(_, _)).WillByDefault(Invoke([this](void* buffer, std::uint32_t n) {
+            n = std::min(n, static_cast<std::uint32_t>(input_.size()));
+            std::memcpy(buffer, input_.data(), n);
+            input_.erase(input_.begin(), input_.begin() + n);
+            return n;
+        }));
+    }
+
+    template <typename... Args>
+    void add(const char* fmt, Args... args)
+    {
+        std::vector<std::uint8_t> message;
+        ProtocolUtil::formatf(message, fmt, args...);
+        input_.insert(input_.end(), message.begin(), message.end());
+    }
+
+private:
+    std::vector<std::uint8_t> input_;
+};
+
+class NullSocketFactory : public ISocketFactory {
+public:
+    IDataSocket* create(IArchNetwork::EAddressFamily, ConnectionSecurityLevel) const override
+    {
+        return nullptr;
+    }
+
+    IListenSocket* createListen(IArchNetwork::EAddressFamily,
+                                ConnectionSecurityLevel) const override
+    {
+        return nullptr;
+    }
+};
+
+// A client that coalesces motion and doesn't enable its screen on the handshake.
+class TestClient : public Client {
+public:
+    TestClient(IEventQueue* events, Screen* screen) :
+        Client(events, "stub", NetworkAddress(), new NullSocketFactory, screen, make_args())
+    {
+    }
+
+    void handshakeComplete() override { }
+
+private:
+    static ClientArgs make_args()
+    {
+        ClientArgs args;
+        args.coalesce_motion = true;
+        args.coalesce_motion_interval = kMotionInterval;
+        return args;
+    }
+};
+
+// A server proxy past the handshake whose client fakes input on a mocked platform screen.
+class ServerProxyHarness {
+public:
+    ServerProxyHarness() :
+        platform_screen_(new NiceMock<MockPlatformScreen>(&events_)),
+        screen_(platform_screen_, &events_),
+        client_(&events_, &screen_),
+        proxy_(&client_, &stream_, &events_)
+    {
+        std::vector<std::uint32_t> options;
+        stream_.add(kMsgDSetOptions, &options);
+        proxy_.handleDataForTest();
+    }
+
+    TimerEventQueue events_;
+    InputStream stream_;
+    NiceMock<MockPlatformScreen>* platform_screen_;
+    Screen screen_;
+    TestClient client_;
+    ServerProxy proxy_;
+};
+
+} // namespace
+
+TEST(ServerProxyTests, mouseMove_severalWithinInterval_oneMoveToLastPosition)
+{
+    ServerProxyHarness harness;
+    EXPECT_CALL(*harness.platform_screen_, fakeMouseMove(_, _)).Times(0);
+
+    harness.stream_.add(kMsgDMouseMove, 10, 10);
+    harness.stream_.add(kMsgDMouseMove, 20, 20);
+    harness.stream_.add(kMsgDMouseMove, 30, 40);
+    harness.proxy_.handleDataForTest();
+    Mock::VerifyAndClearExpectations(harness.platform_screen_);
+
+    {
+        InSequence seq;
+        EXPECT_CALL(*harness.platform_screen_, fakeBatchBegin());
+        EXPECT_CALL(*harness.platform_screen_, fakeMouseMove(30, 40));
+        EXPECT_CALL(*harness.platform_screen_, fakeBatchEnd());
+    }
+    EXPECT_TRUE(harness.events_.fire_timer(kMotionInterval));
+}
+
+TEST(ServerProxyTests, mouseMove_thenButtonOrKey_flushesMotionFirst)
+{
+    ServerProxyHarness harness;
+    {
+        InSequence seq;
+        EXPECT_CALL(*harness.platform_screen_, fakeMouseMove(10, 20));
+        EXPECT_CALL(*harness.platform_screen_, fakeMouseButton(1, true));
+        EXPECT_CALL(*harness.platform_screen_, fakeMouseMove(30, 40));
+        EXPECT_CALL(*harness.platform_screen_, fakeKeyDown(0x61, 0, 0x26));
+    }
+
+    harness.stream_.add(kMsgDMouseMove, 0, 0);
+    harness.stream_.add(kMsgDMouseMove, 10, 20);
+    harness.stream_.add(kMsgDMouseDown, 1);
+    harness.stream_.add(kMsgDMouseMove, 30, 40);
+    harness.stream_.add(kMsgDKeyDown, 0x61, 0, 0x26);
+    harness.proxy_.handleDataForTest();
+
+    // nothing is left for the timer
+    EXPECT_FALSE(harness.events_.fire_timer(kMotionInterval));
+}
+
+} // namespace inputleap
@@ -53,6 +53,48 @@ TEST(ClientArgsParsingTests, parseClientArgs_yScrollArg_setYScroll)
     EXPECT_EQ(1, clientArgs.m_yscroll);
 }
 
+TEST(ClientArgsParsingTests, parseClientArgs_coalesceMotionArg_setIntervalInSeconds)
+{
+    NiceMock<MockArgParser> argParser;
+    ON_CALL(argParser, parseGenericArgs(_, _, _)).WillByDefault(Invoke(client_stubParseGenericArgs));
+    ON_CALL(argParser, checkUnexpectedArgs()).WillByDefault(Invoke(client_stubCheckUnexpectedArgs));
+    ClientArgs clientArgs;
+    const int argc = 3;
+    const char* kCoalesceMotionCmd[argc] = { "stub", "--coalesce-motion", "8" };
+
+    argParser.parseClientArgs(clientArgs, argc, kCoalesceMotionCmd);
+
+    EXPECT_TRUE(clientArgs.coalesce_motion);
+    EXPECT_DOUBLE_EQ(0.008, clientArgs.coalesce_motion_interval);
+}
+
+TEST(ClientArgsParsingTests, parseClientArgs_coalesceMotionRefreshArg_useRefreshInterval)
+{
+    NiceMock<MockArgParser> argParser;
+    ON_CALL(argParser, parseGenericArgs(_, _, _)).WillByDefault(Invoke(client_stubParseGenericArgs));
+    ON_CALL(argParser, checkUnexpectedArgs()).WillByDefault(Invoke(client_stubCheckUnexpectedArgs));
+    ClientArgs clientArgs;
+    const int argc = 3;
+    const char* kCoalesceMotionCmd[argc] = { "stub", "--coalesce-motion", "refresh" };
+
+    argParser.parseClientArgs(clientArgs, argc, kCoalesceMotionCmd);
+
+    EXPECT_TRUE(clientArgs.coalesce_motion);
+    EXPECT_EQ(0.0, clientArgs.coalesce_motion_interval);
+}
+
+TEST(ClientArgsParsingTests, parseClientArgs_coalesceMotionInvalidArg_returnFalse)
+{
+    NiceMock<MockArgParser> argParser;
+    ON_CALL(argParser, parseGenericArgs(_, _, _)).WillByDefault(Invoke(client_stubParseGenericArgs));
+    ON_CALL(argParser, checkUnexpectedArgs()).WillByDefault(Invoke(client_stubCheckUnexpectedArgs));
+    ClientArgs clientArgs;
+    const int argc = 3;
+    const char* kCoalesceMotionCmd[argc] = { "stub", "--coalesce-motion", "0" };
+
+    EXPECT_FALSE(argParser.parseClientArgs(clientArgs, argc, kCoalesceMotionCmd));
+}
+
 TEST(ClientArgsParsingTests, parseClientArgs_addressArg_set_listen_address)
 {
     NiceMock<MockArgParser> argParser;
@@ -95,6 +95,42 @@ TEST(GenericArgsParsingTests, parseGenericArgs_logFileCmdWithSpace_saveLogFilena
     EXPECT_EQ(a.size(), 0); // all args consumed
 }
 
+TEST(GenericArgsParsingTests, parseGenericArgs_logAsyncCmd_logAsyncTrue)
+{
+    const int argc = 2;
+    const char* kLogAsyncCmd[argc] = { "stub", "--log-async" };
+    Argv a(argc, kLogAsyncCmd);
+
+    ArgParser argParser(nullptr);
+    ArgsBase argsBase;
+    argParser.setArgsBase(argsBase);
+
+    argParser.parseGenericArgs(a);
+
+    EXPECT_TRUE(argsBase.m_logAsync);
+    EXPECT_EQ(a.size(), 0); // all args consumed
+}
+
+TEST(GenericArgsParsingTests, parseGenericArgs_logRotationCmd_saveSizeAndGenerations)
+{
+    const int argc = 5;
+    const char* kLogRotationCmd[argc] = {
+        "stub", "--log-max-size", "4096", "--log-generations", "5"
+    };
+    Argv a(argc, kLogRotationCmd);
+
+    ArgParser argParser(nullptr);
+    ArgsBase argsBase;
+    argParser.setArgsBase(argsBase);
+
+    argParser.parseGenericArgs(a);
+    argParser.parseGenericArgs(a);
+
+    EXPECT_EQ(4096, argsBase.m_logMaxSize);
+    EXPECT_EQ(5, argsBase.m_logGenerations);
+    EXPECT_EQ(a.size(), 0); // all args consumed
+}
+
 TEST(GenericArgsParsingTests, parseGenericArgs_noDeamonCmd_daemonFalse)
 {
     const int argc = 2;
@@ -18,6 +18,8 @@
 #define INPUTLEAP_TEST_ENV
 
 #include "inputleap/KeyMap.h"
+#include "base/Log.h"
+#include "base/Stopwatch.h"
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -31,6 +33,49 @@ using ::testing::SaveArg;
 
 namespace inputleap {
 
+namespace {
+
+// about the size of an X keyboard map with four layouts: every button
+// generates one unshifted and one shifted KeyID in each group, and the
+// first two buttons are the shift keys
+const std::int32_t kBenchGroups = 4;
+const KeyButton kBenchButtons = 120;
+
+KeyID benchKeyID(std::int32_t group, KeyButton button, bool shifted)
+{
+    return 0x100 + group * 0x200 + button * 2 + (shifted ? 1 : 0);
+}
+
+void fillBenchKeyMap(KeyMap& keyMap)
+{
+    for (std::int32_t group = 0; group < kBenchGroups; ++group) {
+        KeyMap::KeyItem item{};
+        item.m_group     = group;
+        item.m_id        = kKeyShift_L;
+        item.m_button    = 1;
+        item.m_generates = KeyModifierShift;
+        keyMap.addKeyEntry(item);
+        item.m_id     = kKeyShift_R;
+        item.m_button = 2;
+        keyMap.addKeyEntry(item);
+
+        item.m_generates = 0;
+        item.m_sensitive = KeyModifierShift;
+        for (KeyButton button = 3; button < kBenchButtons; ++button) {
+            item.m_button   = button;
+            item.m_id       = benchKeyID(group, button, false);
+            item.m_required = 0;
+            keyMap.addKeyEntry(item);
+            item.m_id       = benchKeyID(group, button, true);
+            item.m_required = KeyModifierShift;
+            keyMap.addKeyEntry(item);
+        }
+    }
+    keyMap.finish();
+}
+
+} // namespace
+
 TEST(KeyMapTests, findBestKey_requiredDown_matchExactFirstItem)
 {
     KeyMap keyMap;
@@ -175,6 +220,102 @@ TEST(KeyMapTests, isCommand_shiftMask_returnFalse)
     EXPECT_FALSE(keyMap.isCommand(mask));
 }
 
+TEST(KeyMapTests, mapKey_keyMapReplaced_doesNotReturnCachedKeystrokes)
+{
+    KeyMap keyMap;
+    KeyMap::KeyItem item{};
+    item.m_id = 'a';
+    item.m_button = 10;
+    keyMap.addKeyEntry(item);
+    keyMap.finish();
+
+    KeyMap::Keystrokes keys;
+    KeyMap::ModifierToKeys activeModifiers;
+    KeyModifierMask currentState = 0;
+    const KeyMap::KeyItem* mapped =
+        keyMap.mapKey(keys, 'a', 0, activeModifiers, currentState, 0, false);
+    ASSERT_NE(nullptr, mapped);
+    EXPECT_EQ(10, mapped->m_button);
+
+    KeyMap newKeyMap;
+    item.m_button = 20;
+    newKeyMap.addKeyEntry(item);
+    keyMap.swap(newKeyMap);
+    keyMap.finish();
+
+    keys.clear();
+    mapped = keyMap.mapKey(keys, 'a', 0, activeModifiers, currentState, 0, false);
+    ASSERT_NE(nullptr, mapped);
+    EXPECT_EQ(20, mapped->m_button);
+    ASSERT_EQ(1u, keys.size());
+    EXPECT_EQ(20, keys[0].m_data.m_button.m_button);
+}
+
+TEST(KeyMapTests, findCompatibleKey_combinationEntry_returnsAllItems)
+{
+    KeyMap keyMap;
+    KeyMap::KeyItem item{};
+    item.m_id = kKeyDeadAcute;
+    item.m_button = 10;
+    keyMap.addKeyEntry(item);
+    item.m_id = 'e';
+    item.m_button = 11;
+    keyMap.addKeyEntry(item);
+    keyMap.finish();
+
+    const KeyID keys[] = { kKeyDeadAcute, 'e' };
+    ASSERT_TRUE(keyMap.addKeyCombinationEntry(0xe9, 0, keys, 2));
+    EXPECT_FALSE(keyMap.addKeyCombinationEntry(0xe9, 0, keys, 2));
+
+    KeyMap::KeyItemRange items = keyMap.findCompatibleKey(0xe9, 0, 0, 0);
+    ASSERT_EQ(2u, items.size());
+    EXPECT_EQ(10, items[0].m_button);
+    EXPECT_EQ(11, items.back().m_button);
+    EXPECT_TRUE(keyMap.findCompatibleKey('x', 0, 0, 0).empty());
+}
+
+TEST(KeyMapTests, benchmark_buildAndMapKey)
+{
+    const int kBuilds = 50;
+    const int kLookups = 200000;
+
+    // keep the debug logging of the mapping out of the timings
+    int saved_filter = CLOG->getFilter();
+    CLOG->setFilter(kINFO);
+
+    Stopwatch timer(false);
+    for (int i = 0; i < kBuilds; ++i) {
+        KeyMap keyMap;
+        fillBenchKeyMap(keyMap);
+    }
+    double buildTime = timer.getTime();
+
+    KeyMap keyMap;
+    fillBenchKeyMap(keyMap);
+    int mapped = 0;
+    timer.reset();
+    for (int i = 0; i < kLookups; ++i) {
+        std::int32_t group = i % kBenchGroups;
+        KeyButton button = static_cast<KeyButton>(3 + (i * 7) % (kBenchButtons - 3));
+        KeyMap::Keystrokes keys;
+        KeyMap::ModifierToKeys activeModifiers;
+        KeyModifierMask currentState = 0;
+        keyMap.clearKeystrokeCache();
+        const KeyMap::KeyItem* item = keyMap.mapKey(keys, benchKeyID(group, button, i % 3 == 0),
+                                                    group, activeModifiers, currentState, 0,
+                                                    false);
+        if (item != nullptr && item->m_button == button) {
+            ++mapped;
+        }
+    }
+    double lookupTime = timer.getTime();
+    CLOG->setFilter(saved_filter);
+
+    RecordProperty("build_us_per_map", static_cast<int>(buildTime * 1e6 / kBuilds));
+    RecordProperty("map_key_ns_per_call", static_cast<int>(lookupTime * 1e9 / kLookups));
+    EXPECT_EQ(kLookups, mapped);
+}
+
 TEST(KeyMapTests, isCommand_controlMask_returnTrue)
 {
     KeyMap keyMap;
@@ -19,6 +19,8 @@
 #include "test/mock/inputleap/MockKeyState.h"
 #include "test/mock/inputleap/MockEventQueue.h"
 #include "test/mock/inputleap/MockKeyMap.h"
+#include "base/Log.h"
+#include "base/Stopwatch.h"
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -47,6 +49,94 @@ const inputleap::KeyMap::KeyItem* stubMapKey(inputleap::KeyMap::Keystrokes& keys
 inputleap::KeyMap::Keystroke s_stubKeystroke(1, false, false);
 inputleap::KeyMap::KeyItem s_stubKeyItem;
 
+namespace {
+
+// a US-like layout: a shift key, the letters on shift and the space bar
+void fillTypingKeyMap(inputleap::KeyMap& keyMap)
+{
+    inputleap::KeyMap::KeyItem item{};
+    item.m_id        = kKeyShift_L;
+    item.m_button    = 50;
+    item.m_generates = KeyModifierShift;
+    keyMap.addKeyEntry(item);
+
+    item.m_generates = 0;
+    item.m_sensitive = KeyModifierShift;
+    for (KeyID letter = 0; letter < 26; ++letter) {
+        item.m_button   = static_cast<KeyButton>(10 + letter);
+        item.m_id       = 'a' + letter;
+        item.m_required = 0;
+        keyMap.addKeyEntry(item);
+        item.m_id       = 'A' + letter;
+        item.m_required = KeyModifierShift;
+        keyMap.addKeyEntry(item);
+    }
+
+    item.m_id        = ' ';
+    item.m_button    = 65;
+    item.m_required  = 0;
+    item.m_sensitive = 0;
+    keyMap.addKeyEntry(item);
+}
+
+// a key map that computes every mapping from scratch
+class UncachedKeyMap : public inputleap::KeyMap {
+public:
+    const KeyItem* mapKey(Keystrokes& keys, KeyID id, std::int32_t group,
+                          ModifierToKeys& activeModifiers, KeyModifierMask& currentState,
+                          KeyModifierMask desiredMask, bool isAutoRepeat) const override
+    {
+        const_cast<UncachedKeyMap*>(this)->clearKeystrokeCache();
+        return KeyMap::mapKey(keys, id, group, activeModifiers, currentState, desiredMask,
+                              isAutoRepeat);
+    }
+};
+
+// records the synthesized keystrokes as "+button", "-button" or "group"
+class TypingKeyState : public KeyState {
+public:
+    TypingKeyState(IEventQueue* events, inputleap::KeyMap& keyMap) :
+        KeyState(events, keyMap)
+    {
+        updateKeyMap();
+        updateKeyState();
+    }
+
+    std::vector<std::string> strokes_;
+
+    std::int32_t pollActiveGroup() const override { return 0; }
+    KeyModifierMask pollActiveModifiers() const override { return 0; }
+    void pollPressedKeys(KeyButtonSet&) const override { }
+    bool fakeCtrlAltDel() override { return false; }
+    bool fakeMediaKey(KeyID) override { return false; }
+    void getKeyMap(inputleap::KeyMap& keyMap) override { fillTypingKeyMap(keyMap); }
+
+    void fakeKey(const Keystroke& keystroke) override
+    {
+        if (keystroke.m_type == Keystroke::kButton) {
+            strokes_.push_back((keystroke.m_data.m_button.m_press ? "+" : "-") +
+                               std::to_string(keystroke.m_data.m_button.m_button));
+        } else {
+            strokes_.push_back("group");
+        }
+    }
+};
+
+double typeCorpus(TypingKeyState& keyState, const std::string& corpus, int repeats)
+{
+    Stopwatch timer(false);
+    for (int i = 0; i < repeats; ++i) {
+        for (char c : corpus) {
+            KeyButton serverID = static_cast<KeyButton>(c);
+            keyState.fakeKeyDown(static_cast<KeyID>(c), 0, serverID);
+            keyState.fakeKeyUp(serverID);
+        }
+    }
+    return timer.getTime();
+}
+
+} // namespace
+
 TEST(CKeyStateTests, onKey_aKeyDown_keyStateOne)
 {
     MockKeyMap keyMap;
@@ -245,6 +335,32 @@ TEST(KeyStateTests, fakeKeyDown_mapReturnsKeystrokes_fakeKeyCalled)
     keyState.fakeKeyDown(1, 0, 0);
 }
 
+TEST(KeyStateTests, fakeKeyDown_typingCorpus_cachedMatchesUncached)
+{
+    const std::string corpus = "The quick brown fox jumps over the lazy dog while "
+                               "Pack my Box with Five dozen Liquor jugs";
+    const int kRepeats = 200;
+
+    MockEventQueue eventQueue;
+    inputleap::KeyMap cachedKeyMap;
+    UncachedKeyMap uncachedKeyMap;
+    TypingKeyState cached(&eventQueue, cachedKeyMap);
+    TypingKeyState uncached(&eventQueue, uncachedKeyMap);
+
+    // keep the debug logging of the mapping out of the timings
+    int saved_filter = CLOG->getFilter();
+    CLOG->setFilter(kINFO);
+    double cachedTime   = typeCorpus(cached, corpus, kRepeats);
+    double uncachedTime = typeCorpus(uncached, corpus, kRepeats);
+    CLOG->setFilter(saved_filter);
+
+    const double keys = static_cast<double>(corpus.size()) * kRepeats;
+    RecordProperty("cached_ns_per_key", static_cast<int>(cachedTime * 1e9 / keys));
+    RecordProperty("uncached_ns_per_key", static_cast<int>(uncachedTime * 1e9 / keys));
+    ASSERT_FALSE(cached.strokes_.empty());
+    EXPECT_EQ(uncached.strokes_, cached.strokes_);
+}
+
 TEST(KeyStateTests, fakeKeyRepeat_invalidKey_returnsFalse)
 {
     MockKeyMap keyMap;
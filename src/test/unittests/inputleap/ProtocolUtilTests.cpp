@@ -0,0 +1,110 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "inputleap/ProtocolUtil.h"
+#include "inputleap/PacketStreamFilter.h"
+#include "inputleap/protocol_types.h"
+#include "test/mock/io/MockStream.h"
+#include "test/mock/inputleap/MockEventQueue.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace inputleap {
+
+namespace {
+
+// collects what is written to a mocked stream
+class RecordingStream : public NiceMock<MockStream> {
+public:
+    RecordingStream()
+    {
+        ON_CALL(*this, write(_, _)).WillByDefault(Invoke([this](const void* data,
+                                                                std::uint32_t n) {
+            writes_.push_back(std::string(static_cast<const char*>(data), n));
+        }));
+    }
+
+    std::vector<std::string> writes_;
+};
+
+} // namespace
+
+TEST(ProtocolUtilTests, writef_sharedCache_formatsOnceAndWritesSameBytes)
+{
+    RecordingStream first;
+    RecordingStream second;
+    RecordingStream third;
+    ProtocolMessageCache messages;
+
+    ProtocolUtil::writef(&first, messages, kMsgDKeyDown, 0x61, 0x2, 0x26);
+    ProtocolUtil::writef(&second, messages, kMsgDKeyDown, 0x61, 0x2, 0x26);
+    ProtocolUtil::writef(&third, messages, kMsgDKeyDown1_0, 0x61, 0x2);
+
+    EXPECT_EQ(messages.size(), 2u);
+    ASSERT_EQ(first.writes_.size(), 1u);
+    ASSERT_EQ(second.writes_.size(), 1u);
+    ASSERT_EQ(third.writes_.size(), 1u);
+    EXPECT_EQ(first.writes_[0], std::string("DKDN\x00\x61\x00\x02\x00\x26", 10));
+    EXPECT_EQ(second.writes_[0], first.writes_[0]);
+    EXPECT_EQ(third.writes_[0], std::string("DKDN\x00\x61\x00\x02", 8));
+}
+
+TEST(ProtocolUtilTests, writef_sharedCache_matchesUncachedWrite)
+{
+    RecordingStream cached;
+    RecordingStream uncached;
+    ProtocolMessageCache messages;
+
+    ProtocolUtil::writef(&cached, messages, kMsgDKeyUp, 0x20ac, 0x10, 0x1a);
+    ProtocolUtil::writef(&uncached, kMsgDKeyUp, 0x20ac, 0x10, 0x1a);
+
+    EXPECT_EQ(cached.writes_, uncached.writes_);
+}
+
+TEST(ProtocolUtilTests, packetStreamFilterWrite_smallPacket_singleWrite)
+{
+    NiceMock<MockEventQueue> events;
+    RecordingStream* stream = new RecordingStream;
+    PacketStreamFilter filter(&events, stream, true);
+
+    ProtocolUtil::writef(&filter, kMsgDKeyDown, 0x61, 0x2, 0x26);
+
+    ASSERT_EQ(stream->writes_.size(), 1u);
+    EXPECT_EQ(stream->writes_[0], std::string("\x00\x00\x00\x0a" "DKDN\x00\x61\x00\x02\x00\x26", 14));
+}
+
+TEST(ProtocolUtilTests, packetStreamFilterWrite_largePacket_lengthThenPayload)
+{
+    NiceMock<MockEventQueue> events;
+    RecordingStream* stream = new RecordingStream;
+    PacketStreamFilter filter(&events, stream, true);
+
+    std::string data(1000, 'x');
+    filter.write(data.data(), static_cast<std::uint32_t>(data.size()));
+
+    ASSERT_EQ(stream->writes_.size(), 2u);
+    EXPECT_EQ(stream->writes_[0], std::string("\x00\x00\x03\xe8", 4));
+    EXPECT_EQ(stream->writes_[1], data);
+}
+
+} // namespace inputleap
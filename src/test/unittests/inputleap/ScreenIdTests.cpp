@@ -0,0 +1,92 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "inputleap/ScreenId.h"
+
+#include <gtest/gtest.h>
+
+namespace inputleap {
+
+TEST(ScreenIdTests, intern_differentCase_returnsSameId)
+{
+    ScreenId id = ScreenIds::intern("ScreenIdTests-Desk");
+
+    EXPECT_EQ(ScreenIds::intern("screenidtests-desk"), id);
+    EXPECT_EQ(ScreenIds::find("SCREENIDTESTS-DESK"), id);
+    EXPECT_EQ(ScreenIds::name(id), "ScreenIdTests-Desk");
+    EXPECT_LT(id, ScreenIds::count());
+}
+
+TEST(ScreenIdTests, intern_differentNames_returnsDifferentIds)
+{
+    EXPECT_NE(ScreenIds::intern("ScreenIdTests-a"), ScreenIds::intern("ScreenIdTests-b"));
+}
+
+TEST(ScreenIdTests, find_unknownName_returnsNoScreen)
+{
+    EXPECT_EQ(ScreenIds::find("ScreenIdTests-never-interned"), kNoScreenId);
+}
+
+TEST(ScreenIdSetTests, fromNames_names_containsOnlyThose)
+{
+    ScreenIdSet set = ScreenIdSet::from_names({ "ScreenIdTests-x", "ScreenIdTests-y" });
+
+    EXPECT_FALSE(set.empty());
+    EXPECT_FALSE(set.is_all());
+    EXPECT_TRUE(set.contains(ScreenIds::intern("ScreenIdTests-X")));
+    EXPECT_TRUE(set.contains(ScreenIds::intern("ScreenIdTests-y")));
+    EXPECT_FALSE(set.contains(ScreenIds::intern("ScreenIdTests-z")));
+    EXPECT_EQ(set.to_string(), "ScreenIdTests-x, ScreenIdTests-y");
+}
+
+TEST(ScreenIdSetTests, fromNames_star_containsEverything)
+{
+    ScreenIdSet set = ScreenIdSet::from_names({ "ScreenIdTests-x", "*" });
+
+    EXPECT_TRUE(set.is_all());
+    EXPECT_TRUE(set.contains(ScreenIds::intern("ScreenIdTests-interned-later")));
+    EXPECT_EQ(set, ScreenIdSet::all());
+    EXPECT_EQ(set.to_string(), "*");
+}
+
+TEST(ScreenIdSetTests, contains_idBeyondStoredBits_returnsFalse)
+{
+    ScreenIdSet set;
+    EXPECT_TRUE(set.empty());
+
+    set.insert(3);
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_FALSE(set.contains(1000));
+    EXPECT_FALSE(set.contains(kNoScreenId));
+}
+
+TEST(ScreenIdSetTests, equal_sameIdsInsertedInDifferentOrder_areEqual)
+{
+    ScreenIdSet a;
+    a.insert(70);
+    a.insert(2);
+    ScreenIdSet b;
+    b.insert(2);
+    b.insert(70);
+    ScreenIdSet c;
+    c.insert(2);
+
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_NE(a, ScreenIdSet::all());
+}
+
+} // namespace inputleap
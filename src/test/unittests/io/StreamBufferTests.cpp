@@ -0,0 +1,62 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "io/StreamBuffer.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+namespace inputleap {
+
+TEST(StreamBufferTests, replaceTail_matchingTail_replaced)
+{
+    StreamBuffer buffer;
+    buffer.write("headtail", 8);
+
+    EXPECT_TRUE(buffer.replaceTail("tail", "TAIL", 4));
+
+    EXPECT_EQ(0, std::memcmp("headTAIL", buffer.peek(8), 8));
+}
+
+TEST(StreamBufferTests, replaceTail_tailDiffers_unchanged)
+{
+    StreamBuffer buffer;
+    buffer.write("headtail", 8);
+
+    EXPECT_FALSE(buffer.replaceTail("tale", "TAIL", 4));
+    EXPECT_FALSE(buffer.replaceTail("headtail!", "HEADTAIL!", 9));
+
+    EXPECT_EQ(0, std::memcmp("headtail", buffer.peek(8), 8));
+}
+
+TEST(StreamBufferTests, replaceTail_spansChunks_replaced)
+{
+    // fill the first chunk up to two bytes before its end
+    std::vector<char> head(4094, 'h');
+    StreamBuffer buffer;
+    buffer.write(head.data(), static_cast<std::uint32_t>(head.size()));
+    buffer.write("tail", 4);
+
+    EXPECT_TRUE(buffer.replaceTail("tail", "TAIL", 4));
+
+    buffer.pop(static_cast<std::uint32_t>(head.size()));
+    EXPECT_EQ(4u, buffer.getSize());
+    EXPECT_EQ(0, std::memcmp("TAIL", buffer.peek(4), 4));
+}
+
+} // namespace inputleap
@@ -0,0 +1,169 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// gtest must be included before Xlib which defines conflicting macros
+#include "test/mock/inputleap/MockEventQueue.h"
+#include "platform/XWindowsEventQueueBuffer.h"
+#include "base/Stopwatch.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace inputleap {
+
+namespace {
+
+// Emulates the parts of Xlib that XWindowsEventQueueBuffer uses for waiting.  The X connection
+// is a pipe: writing to it makes the "server" side readable and reading it moves everything
+// into the emulated Xlib event queue.
+class FakeXWindowsImpl : public XWindowsImpl {
+public:
+    FakeXWindowsImpl()
+    {
+        int result = pipe(connection_);
+        assert(result == 0);
+        (void) result;
+        fcntl(connection_[0], F_SETFL, fcntl(connection_[0], F_GETFL) | O_NONBLOCK);
+    }
+
+    ~FakeXWindowsImpl() override
+    {
+        close(connection_[0]);
+        close(connection_[1]);
+    }
+
+    // sends an event from the emulated X server
+    void send_server_event()
+    {
+        ssize_t written = write(connection_[1], "e", 1);
+        (void) written;
+    }
+
+    // emulates Xlib reading an event into its queue without activity on the connection
+    void queue_event_locally() { queued_++; }
+
+    int events_queued_calls() const { return events_queued_calls_; }
+
+    Atom XInternAtom(Display*, _Xconst char*, Bool) override { return 1; }
+    int XFlush(Display*) override { return 1; }
+    Status XSendEvent(Display*, Window, Bool, long, XEvent*) override { return 1; }
+    int XPending(Display* display) override { return XEventsQueued(display, QueuedAfterFlush); }
+    int do_ConnectionNumber(Display*) override { return connection_[0]; }
+
+    int XEventsQueued(Display*, int mode) override
+    {
+        events_queued_calls_++;
+        if (mode != QueuedAlready) {
+            char buf[16];
+            ssize_t n;
+            while ((n = read(connection_[0], buf, sizeof(buf))) > 0) {
+                queued_ += static_cast<int>(n);
+            }
+        }
+        return queued_;
+    }
+
+private:
+    int connection_[2];
+    std::atomic<int> queued_{0};
+    std::atomic<int> events_queued_calls_{0};
+};
+
+Display* fake_display()
+{
+    static int dummy;
+    return reinterpret_cast<Display*>(&dummy);
+}
+
+} // namespace
+
+TEST(XWindowsEventQueueBufferTests, waitForEvent_idle_doesNotWakeUpPeriodically)
+{
+    FakeXWindowsImpl impl;
+    MockEventQueue events;
+    XWindowsEventQueueBuffer buffer(&impl, fake_display(), 1, &events);
+
+    Stopwatch timer(false);
+    buffer.waitForEvent(0.2);
+    double elapsed = timer.getTime();
+
+    EXPECT_GE(elapsed, 0.19);
+    // one check before sleeping and nothing more while idle
+    EXPECT_LE(impl.events_queued_calls(), 2);
+}
+
+TEST(XWindowsEventQueueBufferTests, waitForEvent_eventQueuedInXlib_returnsImmediately)
+{
+    FakeXWindowsImpl impl;
+    MockEventQueue events;
+    XWindowsEventQueueBuffer buffer(&impl, fake_display(), 1, &events);
+
+    impl.queue_event_locally();
+
+    Stopwatch timer(false);
+    buffer.waitForEvent(5.0);
+
+    EXPECT_LT(timer.getTime(), 0.1);
+    EXPECT_FALSE(buffer.isEmpty());
+}
+
+TEST(XWindowsEventQueueBufferTests, waitForEvent_serverEvent_dispatchedWithoutPollDelay)
+{
+    FakeXWindowsImpl impl;
+    MockEventQueue events;
+    XWindowsEventQueueBuffer buffer(&impl, fake_display(), 1, &events);
+
+    Stopwatch timer(false);
+    std::thread server([&impl]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        impl.send_server_event();
+    });
+    buffer.waitForEvent(5.0);
+    double elapsed = timer.getTime();
+    server.join();
+
+    EXPECT_GE(elapsed, 0.045);
+    EXPECT_LT(elapsed, 0.5);
+    EXPECT_FALSE(buffer.isEmpty());
+}
+
+TEST(XWindowsEventQueueBufferTests, waitForEvent_userEventFromOtherThread_wakesUp)
+{
+    FakeXWindowsImpl impl;
+    MockEventQueue events;
+    XWindowsEventQueueBuffer buffer(&impl, fake_display(), 1, &events);
+
+    Stopwatch timer(false);
+    std::thread poster([&impl, &buffer]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        // the flush in addEvent() reads the event into Xlib's queue behind our back
+        impl.queue_event_locally();
+        buffer.addEvent(1);
+    });
+    buffer.waitForEvent(5.0);
+    double elapsed = timer.getTime();
+    poster.join();
+
+    EXPECT_LT(elapsed, 0.5);
+    EXPECT_FALSE(buffer.isEmpty());
+}
+
+} // namespace inputleap
@@ -0,0 +1,328 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// gtest must be included before Xlib which defines conflicting macros
+#include "test/mock/inputleap/MockEventQueue.h"
+#include "platform/XWindowsKeyState.h"
+#include "base/Log.h"
+#include "base/Stopwatch.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <X11/XKBlib.h>
+#define XK_LATIN1
+#define XK_MISCELLANY
+#include <X11/keysymdef.h>
+
+namespace inputleap {
+
+namespace {
+
+// Emulates the parts of Xlib that XWindowsKeyState uses to synthesize keys and counts flushes.
+// If given an XKB keyboard map it emulates a server that has it; the key state takes ownership.
+class FakeXWindowsImpl : public XWindowsImpl {
+public:
+    explicit FakeXWindowsImpl(XkbDescPtr xkb = nullptr) : xkb_(xkb) {}
+
+    int flushes() const { return flushes_; }
+    int key_events() const { return key_events_; }
+    int full_map_fetches() const { return full_map_fetches_; }
+    int partial_map_fetches() const { return partial_map_fetches_; }
+
+    XkbDescPtr XkbGetMap(Display*, unsigned int, unsigned int) override { return xkb_; }
+
+    Status XkbGetState(Display*, unsigned int, XkbStatePtr state) override
+    {
+        std::memset(state, 0, sizeof(*state));
+        return Success;
+    }
+
+    Status XkbGetUpdatedMap(Display*, unsigned int, XkbDescPtr) override
+    {
+        full_map_fetches_++;
+        return Success;
+    }
+
+    Status XkbGetMapChanges(Display*, XkbDescPtr, XkbMapChangesPtr) override
+    {
+        partial_map_fetches_++;
+        return Success;
+    }
+
+    int XGetKeyboardControl(Display*, XKeyboardState* state) override
+    {
+        std::memset(state, 0, sizeof(*state));
+        state->global_auto_repeat = AutoRepeatModeOn;
+        return 1;
+    }
+
+    int XTestFakeKeyEvent(Display*, unsigned int, int, unsigned long) override
+    {
+        key_events_++;
+        return 1;
+    }
+
+    int XFlush(Display*) override
+    {
+        flushes_++;
+        return 1;
+    }
+
+private:
+    XkbDescPtr xkb_;
+    int flushes_ = 0;
+    int key_events_ = 0;
+    int full_map_fetches_ = 0;
+    int partial_map_fetches_ = 0;
+};
+
+class TestXWindowsKeyState : public XWindowsKeyState {
+public:
+    TestXWindowsKeyState(IXWindowsImpl* impl, IEventQueue* events, bool useXKB = false) :
+        XWindowsKeyState(impl, fake_display(), useXKB, events)
+    {
+    }
+
+    using XWindowsKeyState::fakeKey;
+    using XWindowsKeyState::getKeyMap;
+
+private:
+    static Display* fake_display()
+    {
+        static int dummy;
+        return reinterpret_cast<Display*>(&dummy);
+    }
+};
+
+void fake_keystrokes(TestXWindowsKeyState& keyState, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        keyState.fakeKey(KeyMap::Keystroke(38, true, false, 0));
+        keyState.fakeKey(KeyMap::Keystroke(38, false, false, 0));
+    }
+}
+
+const KeyCode kFirstLetterKeycode = 10;
+const KeyCode kShiftKeycode = 50;
+
+void set_xkb_key(XkbDescPtr xkb, KeyCode keycode, KeySym keysym)
+{
+    if (XkbKeyNumGroups(xkb, keycode) == 0) {
+        int type = XkbOneLevelIndex;
+        XkbChangeTypesOfKey(xkb, keycode, 1, XkbGroup1Mask, &type, nullptr);
+    }
+    XkbKeySymsPtr(xkb, keycode)[0] = keysym;
+}
+
+// An XKB keyboard map with just a shift key
+XkbDescPtr make_xkb_keyboard()
+{
+    XkbDescPtr xkb = XkbAllocKeyboard();
+    xkb->min_key_code = 8;
+    xkb->max_key_code = 255;
+    XkbAllocClientMap(xkb, XkbKeyTypesMask | XkbKeySymsMask | XkbModifierMapMask,
+                      XkbNumRequiredTypes);
+    XkbAllocServerMap(xkb, XkbKeyActionsMask | XkbKeyBehaviorsMask, 0);
+    XkbInitCanonicalKeyTypes(xkb, XkbKeyTypesMask, XkbNoModifier);
+
+    set_xkb_key(xkb, kShiftKeycode, XK_Shift_L);
+    xkb->map->modmap[kShiftKeycode] = ShiftMask;
+    XkbAction* action = XkbResizeKeyActions(xkb, kShiftKeycode, 1);
+    action->mods.type = XkbSA_SetMods;
+    action->mods.flags = XkbSA_UseModMapMods;
+    return xkb;
+}
+
+// Maps the letters to consecutive keycodes, starting with the letter \p first
+void set_xkb_letters(XkbDescPtr xkb, int first)
+{
+    for (int i = 0; i < 26; ++i) {
+        set_xkb_key(xkb, static_cast<KeyCode>(kFirstLetterKeycode + i),
+                    XK_a + (first + i) % 26);
+    }
+}
+
+XkbMapNotifyEvent keysyms_changed_event(XkbDescPtr xkb, KeyCode first, int count)
+{
+    XkbMapNotifyEvent event;
+    std::memset(&event, 0, sizeof(event));
+    event.xkb_type = XkbMapNotify;
+    event.changed = XkbKeySymsMask;
+    event.min_key_code = xkb->min_key_code;
+    event.max_key_code = xkb->max_key_code;
+    event.first_key_sym = first;
+    event.num_key_syms = count;
+    return event;
+}
+
+XWindowsKeyState::KeycodeList keycodes_for(const XWindowsKeyState& keyState, KeyID id)
+{
+    XWindowsKeyState::KeycodeList keycodes;
+    keyState.mapKeyToKeycodes(id, keycodes);
+    return keycodes;
+}
+
+} // namespace
+
+TEST(XWindowsKeyStateTests, fakeKey_notDeferred_flushesEveryKey)
+{
+    FakeXWindowsImpl impl;
+    MockEventQueue events;
+    TestXWindowsKeyState keyState(&impl, &events);
+
+    fake_keystrokes(keyState, 3);
+
+    EXPECT_EQ(6, impl.key_events());
+    EXPECT_EQ(6, impl.flushes());
+}
+
+TEST(XWindowsKeyStateTests, fakeKey_deferred_leavesFlushToCaller)
+{
+    FakeXWindowsImpl impl;
+    MockEventQueue events;
+    TestXWindowsKeyState keyState(&impl, &events);
+
+    keyState.setFlushDeferred(true);
+    fake_keystrokes(keyState, 3);
+
+    EXPECT_EQ(6, impl.key_events());
+    EXPECT_EQ(0, impl.flushes());
+
+    keyState.setFlushDeferred(false);
+    fake_keystrokes(keyState, 1);
+    EXPECT_EQ(2, impl.flushes());
+}
+
+TEST(XWindowsKeyStateTests, updateKeyMap_keysymsChanged_rebuildsOnlyChangedKeycodes)
+{
+    XkbDescPtr xkb = make_xkb_keyboard();
+    set_xkb_letters(xkb, 0);
+    FakeXWindowsImpl impl(xkb);
+    MockEventQueue events;
+    TestXWindowsKeyState keyState(&impl, &events, true);
+
+    keyState.updateKeyMap();
+    EXPECT_EQ(1, impl.full_map_fetches());
+    EXPECT_EQ(XWindowsKeyState::KeycodeList{kFirstLetterKeycode}, keycodes_for(keyState, 'a'));
+
+    set_xkb_key(xkb, kFirstLetterKeycode, XK_1);
+    keyState.noteKeyMapChanges(keysyms_changed_event(xkb, kFirstLetterKeycode, 1));
+    keyState.updateKeyMap();
+
+    EXPECT_EQ(1, impl.full_map_fetches());
+    EXPECT_EQ(1, impl.partial_map_fetches());
+    EXPECT_EQ(XWindowsKeyState::KeycodeList{kFirstLetterKeycode}, keycodes_for(keyState, '1'));
+    EXPECT_TRUE(keycodes_for(keyState, 'a').empty());
+    EXPECT_TRUE(keycodes_for(keyState, 'A').empty());
+    EXPECT_EQ(XWindowsKeyState::KeycodeList{kFirstLetterKeycode + 1},
+              keycodes_for(keyState, 'B'));
+}
+
+TEST(XWindowsKeyStateTests, updateKeyMap_keyTypesChanged_fetchesWholeMap)
+{
+    XkbDescPtr xkb = make_xkb_keyboard();
+    set_xkb_letters(xkb, 0);
+    FakeXWindowsImpl impl(xkb);
+    MockEventQueue events;
+    TestXWindowsKeyState keyState(&impl, &events, true);
+    keyState.updateKeyMap();
+
+    XkbMapNotifyEvent event = keysyms_changed_event(xkb, kFirstLetterKeycode, 1);
+    event.changed |= XkbKeyTypesMask;
+    event.num_types = 1;
+    keyState.noteKeyMapChanges(event);
+    keyState.updateKeyMap();
+
+    EXPECT_EQ(2, impl.full_map_fetches());
+    EXPECT_EQ(0, impl.partial_map_fetches());
+}
+
+TEST(XWindowsKeyStateTests, updateKeyMap_switchBackToRecentLayout_restoresLayout)
+{
+    XkbDescPtr xkb = make_xkb_keyboard();
+    set_xkb_letters(xkb, 0);
+    FakeXWindowsImpl impl(xkb);
+    MockEventQueue events;
+    TestXWindowsKeyState keyState(&impl, &events, true);
+    keyState.updateKeyMap();
+
+    set_xkb_letters(xkb, 1);
+    keyState.updateKeyMap();
+    EXPECT_EQ(XWindowsKeyState::KeycodeList{kFirstLetterKeycode}, keycodes_for(keyState, 'b'));
+
+    set_xkb_letters(xkb, 0);
+    keyState.updateKeyMap();
+    EXPECT_EQ(XWindowsKeyState::KeycodeList{kFirstLetterKeycode}, keycodes_for(keyState, 'a'));
+    EXPECT_EQ(XWindowsKeyState::KeycodeList{kFirstLetterKeycode + 1},
+              keycodes_for(keyState, 'b'));
+    EXPECT_EQ(XWindowsKeyState::KeycodeList{kFirstLetterKeycode + 25},
+              keycodes_for(keyState, 'Z'));
+}
+
+TEST(XWindowsKeyStateTests, benchmark_getKeyMap)
+{
+    const int updates = 200;
+    XkbDescPtr xkb = make_xkb_keyboard();
+    set_xkb_letters(xkb, 0);
+    for (int i = 0; i < 100; ++i) {
+        set_xkb_key(xkb, static_cast<KeyCode>(100 + i), XK_exclam + i % 30);
+    }
+    FakeXWindowsImpl impl(xkb);
+    MockEventQueue events;
+    TestXWindowsKeyState keyState(&impl, &events, true);
+    keyState.updateKeyMap();
+
+    int saved_filter = CLOG->getFilter();
+    CLOG->setFilter(kINFO);
+
+    // a different layout every time
+    Stopwatch timer(false);
+    for (int i = 0; i < updates; ++i) {
+        set_xkb_letters(xkb, 7 + i);
+        KeyMap keyMap;
+        keyState.getKeyMap(keyMap);
+    }
+    double newLayout = timer.getTime();
+
+    // switching between two layouts
+    timer.reset();
+    for (int i = 0; i < updates; ++i) {
+        set_xkb_letters(xkb, i % 2);
+        KeyMap keyMap;
+        keyState.getKeyMap(keyMap);
+    }
+    double recentLayout = timer.getTime();
+
+    // one key changed
+    timer.reset();
+    for (int i = 0; i < updates; ++i) {
+        set_xkb_key(xkb, kFirstLetterKeycode, XK_a + i % 26);
+        keyState.noteKeyMapChanges(keysyms_changed_event(xkb, kFirstLetterKeycode, 1));
+        KeyMap keyMap;
+        keyState.getKeyMap(keyMap);
+    }
+    double oneKey = timer.getTime();
+
+    CLOG->setFilter(saved_filter);
+
+    RecordProperty("new_layout_ns_per_update", static_cast<int>(newLayout * 1e9 / updates));
+    RecordProperty("recent_layout_ns_per_update",
+                   static_cast<int>(recentLayout * 1e9 / updates));
+    RecordProperty("one_key_ns_per_update", static_cast<int>(oneKey * 1e9 / updates));
+}
+
+} // namespace inputleap
@@ -0,0 +1,304 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// gtest must be included before Xlib which defines conflicting macros
+#include <gtest/gtest.h>
+#include "platform/XWindowsRawMotion.h"
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+namespace inputleap {
+
+namespace {
+
+// Emulates a server with pointer devices whose x and y valuators are either all relative or
+// all absolute with the given range.
+class FakeXWindowsImpl : public XWindowsImpl {
+public:
+    void add_device(int deviceid, bool absolute, double max = 0.0)
+    {
+        Device& device = devices_[deviceid];
+        for (int i = 0; i < 2; ++i) {
+            std::memset(&device.valuators[i], 0, sizeof(device.valuators[i]));
+            device.valuators[i].type = XIValuatorClass;
+            device.valuators[i].number = i;
+            device.valuators[i].mode = absolute ? XIModeAbsolute : XIModeRelative;
+            device.valuators[i].max = max;
+            device.classes[i] = reinterpret_cast<XIAnyClassInfo*>(&device.valuators[i]);
+        }
+        std::memset(&device.info, 0, sizeof(device.info));
+        device.info.deviceid = deviceid;
+        device.info.classes = device.classes;
+        device.info.num_classes = 2;
+    }
+
+    int queries() const { return queries_; }
+
+    XIDeviceInfo* XIQueryDevice(Display*, int deviceid, int* count) override
+    {
+        queries_++;
+        auto i = devices_.find(deviceid);
+        if (i == devices_.end()) {
+            *count = 0;
+            return nullptr;
+        }
+        *count = 1;
+        return &i->second.info;
+    }
+
+    void XIFreeDeviceInfo(XIDeviceInfo*) override {}
+
+private:
+    struct Device {
+        XIDeviceInfo info;
+        XIValuatorClassInfo valuators[2];
+        XIAnyClassInfo* classes[2];
+    };
+
+    std::map<int, Device> devices_;
+    int queries_ = 0;
+};
+
+// Builds raw events with the x and y valuators of a device.
+class RawEvent {
+public:
+    RawEvent(int deviceid, const double* x, const double* y)
+    {
+        std::memset(&event_, 0, sizeof(event_));
+        std::memset(mask_, 0, sizeof(mask_));
+        event_.sourceid = deviceid;
+        if (x != nullptr) {
+            XISetMask(mask_, 0);
+            values_.push_back(*x);
+        }
+        if (y != nullptr) {
+            XISetMask(mask_, 1);
+            values_.push_back(*y);
+        }
+        event_.valuators.mask_len = sizeof(mask_);
+        event_.valuators.mask = mask_;
+        event_.valuators.values = values_.data();
+    }
+
+    operator const XIRawEvent&() const { return event_; }
+
+private:
+    XIRawEvent event_;
+    unsigned char mask_[XIMaskLen(2)];
+    std::vector<double> values_;
+};
+
+RawEvent motion(int deviceid, double x, double y)
+{
+    return RawEvent(deviceid, &x, &y);
+}
+
+XRectangle rect(short x, short y, unsigned short w, unsigned short h)
+{
+    XRectangle result;
+    result.x = x;
+    result.y = y;
+    result.width = w;
+    result.height = h;
+    return result;
+}
+
+const int kMouse = 10;
+const int kTablet = 11;
+
+} // namespace
+
+TEST(XWindowsRawMotionTests, getMotion_relativeDevice_keepsFractionsForNextMotion)
+{
+    FakeXWindowsImpl impl;
+    impl.add_device(kMouse, false);
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 1920, 1080, {});
+
+    std::int32_t dx, dy;
+    EXPECT_TRUE(rawMotion.getMotion(motion(kMouse, 0.6, -0.6), dx, dy));
+    EXPECT_EQ(0, dx);
+    EXPECT_EQ(0, dy);
+    EXPECT_TRUE(rawMotion.getMotion(motion(kMouse, 0.6, -0.6), dx, dy));
+    EXPECT_EQ(1, dx);
+    EXPECT_EQ(-1, dy);
+    EXPECT_TRUE(rawMotion.getMotion(motion(kMouse, 2.8, 0.0), dx, dy));
+    EXPECT_EQ(3, dx);
+    EXPECT_EQ(0, dy);
+}
+
+TEST(XWindowsRawMotionTests, clearRemainder_pendingFractions_dropped)
+{
+    FakeXWindowsImpl impl;
+    impl.add_device(kMouse, false);
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 1920, 1080, {});
+
+    std::int32_t dx, dy;
+    rawMotion.getMotion(motion(kMouse, 0.9, 0.9), dx, dy);
+    rawMotion.clearRemainder();
+    rawMotion.getMotion(motion(kMouse, 0.9, 0.9), dx, dy);
+
+    EXPECT_EQ(0, dx);
+    EXPECT_EQ(0, dy);
+}
+
+TEST(XWindowsRawMotionTests, getMotion_onlyYChanged_readsFirstValueAsY)
+{
+    FakeXWindowsImpl impl;
+    impl.add_device(kMouse, false);
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 1920, 1080, {});
+
+    double y = 5.0;
+    std::int32_t dx, dy;
+    rawMotion.getMotion(RawEvent(kMouse, nullptr, &y), dx, dy);
+
+    EXPECT_EQ(0, dx);
+    EXPECT_EQ(5, dy);
+}
+
+TEST(XWindowsRawMotionTests, getMotion_sameDevice_queriedOnce)
+{
+    FakeXWindowsImpl impl;
+    impl.add_device(kMouse, false);
+    XWindowsRawMotion rawMotion(&impl);
+
+    std::int32_t dx, dy;
+    rawMotion.getMotion(motion(kMouse, 1.0, 1.0), dx, dy);
+    rawMotion.getMotion(motion(kMouse, 1.0, 1.0), dx, dy);
+    EXPECT_EQ(1, impl.queries());
+
+    rawMotion.forgetDevices();
+    rawMotion.getMotion(motion(kMouse, 1.0, 1.0), dx, dy);
+    EXPECT_EQ(2, impl.queries());
+}
+
+TEST(XWindowsRawMotionTests, getMotion_unknownDevice_noMotion)
+{
+    FakeXWindowsImpl impl;
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 1920, 1080, {});
+
+    std::int32_t dx, dy;
+    EXPECT_FALSE(rawMotion.getMotion(motion(kMouse, 10.0, 10.0), dx, dy));
+    EXPECT_FALSE(rawMotion.getMotion(motion(kMouse, 20.0, 20.0), dx, dy));
+    EXPECT_EQ(0, dx);
+    EXPECT_EQ(0, dy);
+}
+
+TEST(XWindowsRawMotionTests, getMotion_absoluteDevice_positionChangeScaledToScreen)
+{
+    FakeXWindowsImpl impl;
+    impl.add_device(kTablet, true, 4096.0);
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 1920, 1080, {});
+
+    // the first position has nothing to compare with
+    std::int32_t dx, dy;
+    EXPECT_FALSE(rawMotion.getMotion(motion(kTablet, 1024.0, 1024.0), dx, dy));
+    EXPECT_EQ(0, dx);
+    EXPECT_EQ(0, dy);
+
+    EXPECT_FALSE(rawMotion.getMotion(motion(kTablet, 2048.0, 512.0), dx, dy));
+    EXPECT_EQ(480, dx);
+    EXPECT_EQ(-135, dy);
+
+    // 3/4096 of 1920 is 1.40625 pixels; the fractions add up
+    rawMotion.getMotion(motion(kTablet, 2051.0, 512.0), dx, dy);
+    EXPECT_EQ(1, dx);
+    rawMotion.getMotion(motion(kTablet, 2054.0, 512.0), dx, dy);
+    EXPECT_EQ(1, dx);
+    rawMotion.getMotion(motion(kTablet, 2057.0, 512.0), dx, dy);
+    EXPECT_EQ(2, dx);
+}
+
+TEST(XWindowsRawMotionTests, getMotion_absoluteDevice_usesCurrentScreenSize)
+{
+    FakeXWindowsImpl impl;
+    impl.add_device(kTablet, true, 4096.0);
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 1920, 1080, {});
+
+    std::int32_t dx, dy;
+    rawMotion.getMotion(motion(kTablet, 0.0, 0.0), dx, dy);
+    rawMotion.setShape(0, 0, 1024, 768, {});
+    rawMotion.getMotion(motion(kTablet, 2048.0, 2048.0), dx, dy);
+
+    EXPECT_EQ(512, dx);
+    EXPECT_EQ(384, dy);
+}
+
+TEST(XWindowsRawMotionTests, canTrack_withinScreen_true)
+{
+    FakeXWindowsImpl impl;
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 1920, 1080, {});
+
+    EXPECT_TRUE(rawMotion.canTrack(100, 100, 50, -50));
+}
+
+TEST(XWindowsRawMotionTests, canTrack_toScreenEdge_false)
+{
+    FakeXWindowsImpl impl;
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 1920, 1080, { rect(0, 0, 1920, 1080) });
+
+    EXPECT_FALSE(rawMotion.canTrack(10, 100, -10, 0));
+    EXPECT_FALSE(rawMotion.canTrack(1900, 100, 50, 0));
+    EXPECT_FALSE(rawMotion.canTrack(100, 10, 0, -20));
+    EXPECT_FALSE(rawMotion.canTrack(100, 1070, 0, 9));
+    EXPECT_TRUE(rawMotion.canTrack(100, 1070, 0, 8));
+}
+
+TEST(XWindowsRawMotionTests, canTrack_intoAreaWithoutCrtc_false)
+{
+    // a 1920x1080 monitor left of a 1280x1024 one leaves no crtc below 1024 on the right
+    FakeXWindowsImpl impl;
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 3200, 1080,
+                       { rect(0, 0, 1920, 1080), rect(1920, 0, 1280, 1024) });
+
+    EXPECT_TRUE(rawMotion.canTrack(2000, 1000, 0, 20));
+    EXPECT_FALSE(rawMotion.canTrack(2000, 1000, 0, 30));
+}
+
+TEST(XWindowsRawMotionTests, canTrack_fromOutsideCrtcs_false)
+{
+    FakeXWindowsImpl impl;
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 3200, 1080,
+                       { rect(0, 0, 1920, 1080), rect(1920, 0, 1280, 1024) });
+
+    EXPECT_FALSE(rawMotion.canTrack(2000, 1050, 0, -10));
+}
+
+TEST(XWindowsRawMotionTests, canTrack_acrossCrtcs_false)
+{
+    // the server may have stopped the pointer at the bottom of the first monitor
+    FakeXWindowsImpl impl;
+    XWindowsRawMotion rawMotion(&impl);
+    rawMotion.setShape(0, 0, 3200, 1080,
+                       { rect(0, 0, 1920, 1080), rect(1920, 0, 1280, 1024) });
+
+    EXPECT_FALSE(rawMotion.canTrack(1910, 1050, 20, -40));
+    EXPECT_TRUE(rawMotion.canTrack(1900, 1050, 10, -40));
+}
+
+} // namespace inputleap
@@ -0,0 +1,83 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// gtest must be included before Xlib which defines conflicting macros
+#include <gtest/gtest.h>
+#include "platform/XWindowsKeySymTable.h"
+#include "platform/XWindowsUtil.h"
+#include "inputleap/key_types.h"
+
+#include <map>
+
+namespace inputleap {
+
+namespace {
+
+// the lookup mapKeySymToKeyID() used to do for keysyms outside the
+// ranges it handles itself
+std::uint32_t lookup_in_map(KeySym keysym)
+{
+    static std::map<KeySym, std::uint32_t> keysym_to_ucs4;
+    if (keysym_to_ucs4.empty()) {
+        for (const codepair& pair : s_keymap) {
+            keysym_to_ucs4[pair.keysym] = pair.ucs4;
+        }
+    }
+    auto i = keysym_to_ucs4.find(keysym);
+    return i == keysym_to_ucs4.end() ? kKeyNone : i->second;
+}
+
+bool is_mapped_without_table(KeySym keysym)
+{
+    switch (keysym & 0xffffff00) {
+    case 0x0000:
+    case 0xfe00:
+    case 0xff00:
+    case 0x1008ff00:
+    case 0x1009ff00:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+TEST(XWindowsUtilTests, mapKeySymToKeyID_everyTableKeySym_matchesMap)
+{
+    // all of the legacy keysyms and the Unicode keysyms the table uses
+    const KeySym ranges[][2] = { { 0x0000, 0x20000 }, { 0x1000000, 0x1020000 } };
+    int compared = 0;
+    for (const auto& range : ranges) {
+        for (KeySym keysym = range[0]; keysym < range[1]; ++keysym) {
+            if (is_mapped_without_table(keysym)) {
+                continue;
+            }
+            ASSERT_EQ(lookup_in_map(keysym), XWindowsUtil::mapKeySymToKeyID(keysym))
+                << "keysym 0x" << std::hex << keysym;
+            ++compared;
+        }
+    }
+    for (const codepair& pair : s_keymap) {
+        if (!is_mapped_without_table(pair.keysym)) {
+            EXPECT_EQ(pair.ucs4, XWindowsUtil::mapKeySymToKeyID(pair.keysym));
+        }
+    }
+    EXPECT_GT(compared, 0x20000);
+}
+
+} // namespace inputleap
@@ -0,0 +1,168 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "test/mock/inputleap/MockEventQueue.h"
+#include "server/Config.h"
+#include "server/ConfigDiff.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+using ::testing::NiceMock;
+
+namespace inputleap {
+
+namespace {
+
+// A row of screens, each linked to its neighbours, with an option on each screen and a hotkey
+// switching to each screen.  The parameters change one thing at a time.
+std::string make_config_text(int screens, int changed_option_screen = -1,
+                             bool extra_alias = false, bool reverse_rules = false,
+                             int switch_delay = 250)
+{
+    std::ostringstream text;
+    text << "section: screens\n";
+    for (int i = 0; i < screens; i++) {
+        text << "\tscreen" << i << ":\n"
+             << "\t\tswitchCorners = " << (i == changed_option_screen ? "all" : "none") << "\n";
+    }
+    text << "end\nsection: links\n";
+    for (int i = 0; i < screens; i++) {
+        text << "\tscreen" << i << ":\n";
+        if (i > 0) {
+            text << "\t\tleft = screen" << i - 1 << "\n";
+        }
+        if (i + 1 < screens) {
+            text << "\t\tright = screen" << i + 1 << "\n";
+        }
+    }
+    text << "end\n";
+    if (extra_alias) {
+        text << "section: aliases\n\tscreen0:\n\t\tlaptop\nend\n";
+    }
+    text << "section: options\n\tswitchDelay = " << switch_delay << "\n";
+    for (int n = 0; n < screens; n++) {
+        int i = reverse_rules ? screens - 1 - n : n;
+        text << "\tkeystroke(control+alt+f" << i % 12 + 1 << ") = switchToScreen(screen" << i
+             << ")\n";
+    }
+    text << "end\n";
+    return text.str();
+}
+
+void read_config(Config& config, const std::string& text)
+{
+    std::istringstream input(text);
+    input >> config;
+}
+
+} // namespace
+
+TEST(ConfigDiffTests, construct_sameConfig_isEmpty)
+{
+    NiceMock<MockEventQueue> events;
+    Config from(&events), to(&events);
+    read_config(from, make_config_text(60));
+    read_config(to, make_config_text(60));
+
+    ConfigDiff diff(from, to);
+
+    EXPECT_TRUE(diff.empty());
+    EXPECT_FALSE(diff.options_changed("screen7"));
+    EXPECT_EQ(diff.to_string(), "no changes");
+}
+
+TEST(ConfigDiffTests, construct_oneScreenOptionChanged_onlyThatScreenChanged)
+{
+    NiceMock<MockEventQueue> events;
+    Config from(&events), to(&events);
+    read_config(from, make_config_text(60));
+    read_config(to, make_config_text(60, 42));
+
+    ConfigDiff diff(from, to);
+
+    EXPECT_FALSE(diff.empty());
+    EXPECT_FALSE(diff.topology_changed());
+    EXPECT_FALSE(diff.global_options_changed());
+    EXPECT_FALSE(diff.filter_changed());
+    EXPECT_EQ(diff.changed_options_screens(), ConfigDiff::ScreenSet({ "screen42" }));
+    EXPECT_TRUE(diff.options_changed("SCREEN42"));
+    EXPECT_FALSE(diff.options_changed("screen41"));
+}
+
+TEST(ConfigDiffTests, construct_globalOptionChanged_allScreensChanged)
+{
+    NiceMock<MockEventQueue> events;
+    Config from(&events), to(&events);
+    read_config(from, make_config_text(3));
+    read_config(to, make_config_text(3, -1, false, false, 100));
+
+    ConfigDiff diff(from, to);
+
+    EXPECT_TRUE(diff.global_options_changed());
+    EXPECT_TRUE(diff.changed_options_screens().empty());
+    EXPECT_TRUE(diff.options_changed("screen0"));
+    EXPECT_FALSE(diff.topology_changed());
+}
+
+TEST(ConfigDiffTests, construct_screenRemoved_topologyChanged)
+{
+    NiceMock<MockEventQueue> events;
+    Config from(&events), to(&events);
+    read_config(from, make_config_text(60));
+    read_config(to, make_config_text(59));
+
+    ConfigDiff diff(from, to);
+
+    EXPECT_EQ(diff.removed_screens(), ConfigDiff::ScreenSet({ "screen59" }));
+    EXPECT_TRUE(diff.added_screens().empty());
+    // screen58 lost its link to the right
+    EXPECT_TRUE(diff.links_changed());
+    EXPECT_TRUE(diff.topology_changed());
+    EXPECT_TRUE(diff.filter_changed());
+    EXPECT_FALSE(diff.options_changed("screen58"));
+}
+
+TEST(ConfigDiffTests, construct_aliasAdded_aliasesChanged)
+{
+    NiceMock<MockEventQueue> events;
+    Config from(&events), to(&events);
+    read_config(from, make_config_text(3));
+    read_config(to, make_config_text(3, -1, true));
+
+    ConfigDiff diff(from, to);
+
+    EXPECT_TRUE(diff.aliases_changed());
+    EXPECT_FALSE(diff.links_changed());
+    EXPECT_TRUE(diff.removed_screens().empty());
+}
+
+TEST(ConfigDiffTests, construct_rulesReordered_filterChanged)
+{
+    NiceMock<MockEventQueue> events;
+    Config from(&events), to(&events);
+    read_config(from, make_config_text(3));
+    read_config(to, make_config_text(3, -1, false, true));
+
+    ConfigDiff diff(from, to);
+
+    // the first matching rule wins so the order matters
+    EXPECT_TRUE(diff.filter_changed());
+    EXPECT_FALSE(diff.topology_changed());
+}
+
+} // namespace inputleap
@@ -0,0 +1,408 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "test/mock/inputleap/MockEventQueue.h"
+#include "test/mock/server/MockPrimaryClient.h"
+#include "server/Config.h"
+#include "server/InputFilter.h"
+#include "server/Server.h"
+#include "base/Log.h"
+#include "base/Stopwatch.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+namespace inputleap {
+
+namespace {
+
+// Hands out hotkey ids like a primary screen and keeps the handlers the input filter installs so
+// tests can send events to it.
+class InputFilterHarness {
+public:
+    InputFilterHarness()
+    {
+        ON_CALL(events_, add_handler(_, _, _)).WillByDefault(Invoke(
+            [this](EventType type, void*, const IEventQueue::EventHandler& handler) {
+                handlers_[type] = handler;
+            }));
+        ON_CALL(events_, add_event(_)).WillByDefault(Invoke([this](Event&& event) {
+            passed_.push_back(event.getType());
+        }));
+        ON_CALL(primary_, getEventTarget()).WillByDefault(Return(&primary_));
+        ON_CALL(primary_, registerHotKey(_, _)).WillByDefault(Invoke(
+            [this](KeyID key, KeyModifierMask mask) {
+                std::uint32_t id = ++last_hotkey_id_;
+                hotkeys_[std::make_pair(key, mask)] = id;
+                return id;
+            }));
+        ON_CALL(primary_, unregisterHotKey(_)).WillByDefault(Invoke(
+            [this](std::uint32_t id) { unregistered_.push_back(id); }));
+    }
+
+    IEventQueue* events() { return &events_; }
+    PrimaryClient* primary() { return &primary_; }
+
+    std::uint32_t hotkey(KeyID key, KeyModifierMask mask) const
+    {
+        return hotkeys_.at(std::make_pair(key, mask));
+    }
+
+    std::uint32_t registrations() const { return last_hotkey_id_; }
+
+    void send(const Event& event)
+    {
+        handlers_.at(event.getType())(event);
+    }
+
+    void send(EventType type, EventDataBase* data)
+    {
+        send(Event(type, &primary_, data));
+    }
+
+    void send_hotkey(KeyID key, KeyModifierMask mask)
+    {
+        send(EventType::PRIMARY_SCREEN_HOTKEY_DOWN,
+             create_event_data<IPlatformScreen::HotKeyInfo>(
+                 IPlatformScreen::HotKeyInfo{hotkey(key, mask)}));
+    }
+
+    void send_button(ButtonID button, KeyModifierMask mask)
+    {
+        send(EventType::PRIMARY_SCREEN_BUTTON_DOWN,
+             create_event_data<IPlatformScreen::ButtonInfo>(
+                 IPlatformScreen::ButtonInfo{button, mask}));
+    }
+
+    void send_key(KeyID key)
+    {
+        send(EventType::KEY_STATE_KEY_DOWN,
+             create_event_data<IPlatformScreen::KeyInfo>(IPlatformScreen::KeyInfo(key, 0, 1, 1)));
+    }
+
+    // types of the events the filter passed on or posted
+    std::vector<EventType> passed_;
+    // ids of the unregistered hotkeys
+    std::vector<std::uint32_t> unregistered_;
+
+private:
+    NiceMock<MockEventQueue> events_;
+    NiceMock<MockPrimaryClient> primary_;
+    std::map<EventType, IEventQueue::EventHandler> handlers_;
+    std::map<std::pair<KeyID, KeyModifierMask>, std::uint32_t> hotkeys_;
+    std::uint32_t last_hotkey_id_ = 0;
+};
+
+// Records which rule fired
+class RecordingAction : public InputFilter::Action {
+public:
+    RecordingAction(int rule, std::vector<int>* fired) : rule_(rule), fired_(fired) {}
+
+    InputFilter::Action* clone() const override { return new RecordingAction(*this); }
+    std::string format() const override { return "record(" + std::to_string(rule_) + ")"; }
+    void perform(const Event&) override { fired_->push_back(rule_); }
+
+private:
+    int rule_;
+    std::vector<int>* fired_;
+};
+
+// Matches every key down event.  Doesn't support the index so it's tried on every event.
+class AnyKeyDownCondition : public InputFilter::Condition {
+public:
+    InputFilter::Condition* clone() const override { return new AnyKeyDownCondition; }
+    std::string format() const override { return "anykeydown"; }
+    InputFilter::EFilterStatus match(const Event& event) override
+    {
+        return event.getType() == EventType::KEY_STATE_KEY_DOWN ? InputFilter::kActivate
+                                                                : InputFilter::kNoMatch;
+    }
+};
+
+InputFilter::Rule make_rule(InputFilter::Condition* condition, int number, std::vector<int>* fired)
+{
+    InputFilter::Rule rule(condition);
+    rule.adoptAction(new RecordingAction(number, fired), true);
+    return rule;
+}
+
+} // namespace
+
+TEST(InputFilterTests, handleEvent_hotkeyAndButton_runsMatchingRule)
+{
+    InputFilterHarness harness;
+    std::vector<int> fired;
+    InputFilter filter(harness.events());
+    filter.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(), 'a',
+                                                                       KeyModifierControl),
+                                   0, &fired));
+    filter.addFilterRule(make_rule(new InputFilter::MouseButtonCondition(harness.events(), 2,
+                                                                         KeyModifierShift),
+                                   1, &fired));
+    filter.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(), 'b', 0),
+                                   2, &fired));
+    filter.setPrimaryClient(harness.primary());
+
+    harness.send_hotkey('b', 0);
+    harness.send_hotkey('a', KeyModifierControl);
+    // caps lock doesn't matter for mouse buttons
+    harness.send_button(2, KeyModifierShift | KeyModifierCapsLock);
+    harness.send_button(2, KeyModifierControl);
+
+    EXPECT_EQ(fired, std::vector<int>({ 2, 0, 1 }));
+    EXPECT_EQ(harness.passed_, std::vector<EventType>({ EventType::PRIMARY_SCREEN_BUTTON_DOWN }));
+}
+
+TEST(InputFilterTests, handleEvent_keyWithoutRule_passesThrough)
+{
+    InputFilterHarness harness;
+    std::vector<int> fired;
+    InputFilter filter(harness.events());
+    filter.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(), 'a', 0),
+                                   0, &fired));
+    filter.setPrimaryClient(harness.primary());
+
+    harness.send_key('a');
+
+    EXPECT_TRUE(fired.empty());
+    EXPECT_EQ(harness.passed_, std::vector<EventType>({ EventType::KEY_STATE_KEY_DOWN }));
+}
+
+TEST(InputFilterTests, handleEvent_unindexedCondition_keepsRuleOrder)
+{
+    InputFilterHarness harness;
+    std::vector<int> fired;
+    InputFilter filter(harness.events());
+    filter.addFilterRule(make_rule(new InputFilter::MouseButtonCondition(harness.events(), 1, 0),
+                                   0, &fired));
+    filter.addFilterRule(make_rule(new AnyKeyDownCondition, 1, &fired));
+    filter.addFilterRule(make_rule(new InputFilter::MouseButtonCondition(harness.events(), 1, 0),
+                                   2, &fired));
+    filter.setPrimaryClient(harness.primary());
+
+    harness.send_key('x');
+    harness.send_button(1, 0);
+
+    // the first matching rule wins
+    EXPECT_EQ(fired, std::vector<int>({ 1, 0 }));
+}
+
+TEST(InputFilterTests, handleEvent_ruleRemoved_indexUpdated)
+{
+    InputFilterHarness harness;
+    std::vector<int> fired;
+    InputFilter filter(harness.events());
+    filter.addFilterRule(make_rule(new InputFilter::MouseButtonCondition(harness.events(), 1, 0),
+                                   0, &fired));
+    filter.addFilterRule(make_rule(new InputFilter::MouseButtonCondition(harness.events(), 1, 0),
+                                   1, &fired));
+    filter.setPrimaryClient(harness.primary());
+
+    harness.send_button(1, 0);
+    filter.removeFilterRule(0);
+    harness.send_button(1, 0);
+
+    EXPECT_EQ(fired, std::vector<int>({ 0, 1 }));
+}
+
+TEST(InputFilterTests, addFilterRule_whileEnabled_keepsEarlierHotkeys)
+{
+    InputFilterHarness harness;
+    std::vector<int> fired;
+    InputFilter filter(harness.events());
+    filter.setPrimaryClient(harness.primary());
+    for (int i = 0; i < 10; i++) {
+        filter.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(),
+                                                                           'a' + i, 0),
+                                       i, &fired));
+    }
+
+    harness.send_hotkey('a', 0);
+
+    EXPECT_EQ(fired, std::vector<int>({ 0 }));
+    EXPECT_TRUE(harness.unregistered_.empty());
+}
+
+TEST(InputFilterTests, updateRules_someRulesUnchanged_reregistersOnlyChangedHotkeys)
+{
+    InputFilterHarness harness;
+    std::vector<int> fired;
+    InputFilter filter(harness.events());
+    filter.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(), 'a', 0),
+                                   0, &fired));
+    filter.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(), 'b', 0),
+                                   1, &fired));
+    filter.setPrimaryClient(harness.primary());
+    std::uint32_t hotkey_a = harness.hotkey('a', 0);
+    std::uint32_t hotkey_b = harness.hotkey('b', 0);
+
+    InputFilter other(harness.events());
+    other.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(), 'c', 0),
+                                  2, &fired));
+    other.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(), 'b', 0),
+                                  1, &fired));
+    filter.updateRules(other);
+
+    EXPECT_EQ(harness.unregistered_, std::vector<std::uint32_t>({ hotkey_a }));
+    EXPECT_EQ(harness.registrations(), 3u);
+    EXPECT_EQ(harness.hotkey('b', 0), hotkey_b);
+    EXPECT_EQ(filter.format(""), other.format(""));
+
+    harness.send_hotkey('b', 0);
+    harness.send_hotkey('c', 0);
+    EXPECT_EQ(fired, std::vector<int>({ 1, 2 }));
+}
+
+TEST(InputFilterTests, updateRules_actionChanged_replacesRule)
+{
+    InputFilterHarness harness;
+    std::vector<int> fired;
+    InputFilter filter(harness.events());
+    filter.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(), 'a', 0),
+                                   0, &fired));
+    filter.setPrimaryClient(harness.primary());
+    std::uint32_t old_hotkey = harness.hotkey('a', 0);
+
+    InputFilter other(harness.events());
+    other.addFilterRule(make_rule(new InputFilter::KeystrokeCondition(harness.events(), 'a', 0),
+                                  1, &fired));
+    filter.updateRules(other);
+    harness.send_hotkey('a', 0);
+
+    // the old hotkey is released before the new rule grabs the same key
+    EXPECT_EQ(harness.unregistered_, std::vector<std::uint32_t>({ old_hotkey }));
+    EXPECT_EQ(fired, std::vector<int>({ 1 }));
+}
+
+// Matches events against a generated configuration with 500 hotkey and mouse button rules, with
+// the index and by trying every rule like the filter did before.  The timings are recorded as
+// test properties.
+TEST(InputFilterTests, handleEvent_500Rules_indexedFasterThanScan)
+{
+    const char* kMaskNames[] = { "control", "alt", "shift", "super", "control+alt",
+                                 "control+shift", "alt+shift", "control+alt+shift" };
+    const KeyModifierMask kMasks[] = {
+        KeyModifierControl, KeyModifierAlt, KeyModifierShift, KeyModifierSuper,
+        KeyModifierControl | KeyModifierAlt, KeyModifierControl | KeyModifierShift,
+        KeyModifierAlt | KeyModifierShift, KeyModifierControl | KeyModifierAlt | KeyModifierShift
+    };
+    std::vector<std::string> keys;
+    for (char c = 'a'; c <= 'z'; c++) {
+        keys.push_back(std::string(1, c));
+    }
+    for (char c = '0'; c <= '9'; c++) {
+        keys.push_back(std::string(1, c));
+    }
+    for (int f = 1; f <= 12; f++) {
+        keys.push_back("f" + std::to_string(f));
+    }
+    keys.push_back("space");
+    keys.push_back("tab");
+
+    // 8 modifier combinations with 50 keys and 4 with 25 mouse buttons
+    std::ostringstream text;
+    text << "section: screens\n\tserver:\n\tclient:\nend\n"
+         << "section: options\n";
+    for (const char* mask : kMaskNames) {
+        for (const auto& key : keys) {
+            text << "\tkeystroke(" << mask << "+" << key << ") = switchToScreen(client)\n";
+        }
+    }
+    for (int mask = 0; mask < 4; mask++) {
+        for (int button = 1; button <= 25; button++) {
+            text << "\tmousebutton(" << kMaskNames[mask] << "+" << button
+                 << ") = switchToScreen(server)\n";
+        }
+    }
+    text << "end\n";
+
+    InputFilterHarness harness;
+    Config config(harness.events());
+    std::istringstream input(text.str());
+    input >> config;
+    InputFilter* filter = config.getInputFilter();
+    ASSERT_EQ(filter->getNumRules(), 500u);
+    filter->setPrimaryClient(harness.primary());
+
+    // a realistic mix: mostly plain keys and clicks that match nothing, some hotkeys
+    const int kEvents = 20000;
+    std::mt19937 random(42);
+    std::vector<int> kinds(kEvents);
+    for (int& kind : kinds) {
+        kind = static_cast<int>(random() % 10);
+    }
+    auto make_event = [&](int i) {
+        switch (kinds[i]) {
+        case 0: {
+            IPlatformScreen::HotKeyInfo info{harness.hotkey('a' + i % 26, kMasks[i % 8])};
+            return Event(EventType::PRIMARY_SCREEN_HOTKEY_DOWN, harness.primary(),
+                         create_event_data<IPlatformScreen::HotKeyInfo>(info));
+        }
+        case 1:
+        case 2: {
+            IPlatformScreen::ButtonInfo info{static_cast<ButtonID>(1 + i % 30), kMasks[i % 4]};
+            return Event(EventType::PRIMARY_SCREEN_BUTTON_DOWN, harness.primary(),
+                         create_event_data<IPlatformScreen::ButtonInfo>(info));
+        }
+        default:
+            return Event(EventType::KEY_STATE_KEY_DOWN, harness.primary(),
+                         create_event_data<IPlatformScreen::KeyInfo>(
+                             IPlatformScreen::KeyInfo('a' + i % 26, 0, 1, 1)));
+        }
+    };
+
+    // keep the debug logging of the actions out of the timings
+    int saved_filter = CLOG->getFilter();
+    CLOG->setFilter(kINFO);
+
+    Stopwatch timer(false);
+    for (int i = 0; i < kEvents; i++) {
+        harness.send(make_event(i));
+    }
+    double indexed = timer.getTime();
+
+    // the same events matched by trying every rule in turn
+    std::vector<EventType> indexed_passed;
+    indexed_passed.swap(harness.passed_);
+    timer.reset();
+    for (int i = 0; i < kEvents; i++) {
+        Event event = make_event(i);
+        bool handled = false;
+        for (std::uint32_t rule = 0; rule < filter->getNumRules() && !handled; rule++) {
+            handled = filter->getRule(rule).handleEvent(event);
+        }
+        if (!handled) {
+            harness.passed_.push_back(event.getType());
+        }
+    }
+    double scanned = timer.getTime();
+    CLOG->setFilter(saved_filter);
+
+    RecordProperty("indexed_us_per_event", std::to_string(indexed * 1e6 / kEvents));
+    RecordProperty("scanned_us_per_event", std::to_string(scanned * 1e6 / kEvents));
+    // the posted switchToScreen events are the same, too
+    EXPECT_EQ(indexed_passed, harness.passed_);
+}
+
+} // namespace inputleap
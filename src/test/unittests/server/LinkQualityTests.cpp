@@ -0,0 +1,95 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "server/LinkQuality.h"
+
+#include <gtest/gtest.h>
+
+namespace inputleap {
+
+TEST(LinkQualityTests, probeAnswered_nothingOutstanding_returnsFalse)
+{
+    LinkQuality link;
+    EXPECT_FALSE(link.probe_answered(1.0));
+    EXPECT_EQ(0u, link.samples());
+}
+
+TEST(LinkQualityTests, probeAnswered_firstSample_setsEstimate)
+{
+    LinkQuality link;
+    link.probe_sent(1.0);
+    EXPECT_TRUE(link.probe_answered(1.1));
+
+    EXPECT_EQ(1u, link.samples());
+    EXPECT_NEAR(0.1, link.rtt(), 1e-9);
+    EXPECT_NEAR(0.05, link.jitter(), 1e-9);
+}
+
+TEST(LinkQualityTests, probeAnswered_outstandingProbes_answeredInOrder)
+{
+    LinkQuality link;
+    link.probe_sent(1.0);
+    link.probe_sent(2.0);
+    EXPECT_TRUE(link.probe_answered(2.5));
+    EXPECT_NEAR(1.5, link.rtt(), 1e-9);
+    EXPECT_TRUE(link.probe_answered(2.5));
+    EXPECT_FALSE(link.probe_answered(2.5));
+
+    // 1.5 + (0.5 - 1.5) / 8
+    EXPECT_NEAR(1.375, link.rtt(), 1e-9);
+    // 0.75 + (1.0 - 0.75) / 4
+    EXPECT_NEAR(0.8125, link.jitter(), 1e-9);
+}
+
+TEST(LinkQualityTests, isDegraded_slowLinkThenFastLink_degradesAndRecovers)
+{
+    LinkQuality link;
+    double time = 0.0;
+    auto probe = [&](double rtt) {
+        link.probe_sent(time);
+        link.probe_answered(time + rtt);
+        time += 3.0;
+    };
+
+    for (int i = 0; i < 10; ++i) {
+        probe(0.001);
+    }
+    EXPECT_FALSE(link.is_degraded());
+
+    while (!link.is_degraded() && time < 1000.0) {
+        probe(0.4);
+    }
+    EXPECT_TRUE(link.is_degraded());
+
+    while (link.is_degraded() && time < 2000.0) {
+        probe(0.001);
+    }
+    EXPECT_FALSE(link.is_degraded());
+    EXPECT_LT(link.rtt() + 4.0 * link.jitter(), LinkQuality::kRecoveredDelay);
+}
+
+TEST(LinkQualityTests, isDegraded_firstSamplesSlow_notJudged)
+{
+    LinkQuality link;
+    for (int i = 0; i < 3; ++i) {
+        link.probe_sent(i);
+        link.probe_answered(i + 0.5);
+    }
+    EXPECT_FALSE(link.is_degraded());
+}
+
+} // namespace inputleap
@@ -0,0 +1,205 @@
+/*
+    InputLeap -- mouse and keyboard sharing utility
+    Copyright (C) InputLeap contributors
+
+    This package is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License
+    found in the file LICENSE that should have accompanied this file.
+
+    This package is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "server/Config.h"
+#include "server/ScreenTopology.h"
+#include "base/Stopwatch.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+namespace inputleap {
+
+namespace {
+
+const int kWallColumns = 10;
+const int kWallRows = 10;
+
+std::string wall_screen_name(int column, int row)
+{
+    return "screen-" + std::to_string(row) + "-" + std::to_string(column);
+}
+
+// A wall of 10x10 screens.  Horizontal neighbors are linked edge to edge.  The bottom edge of
+// every screen is split in two halves that lead to the left and right half of the screen below,
+// so that lookups have to search several links on a side.
+void make_wall_config(Config& config)
+{
+    for (int row = 0; row < kWallRows; row++) {
+        for (int column = 0; column < kWallColumns; column++) {
+            config.addScreen(wall_screen_name(column, row));
+        }
+    }
+    config.addAlias(wall_screen_name(0, 0), "first-screen-alias");
+
+    for (int row = 0; row < kWallRows; row++) {
+        for (int column = 0; column < kWallColumns; column++) {
+            std::string name = wall_screen_name(column, row);
+            if (column > 0) {
+                config.connect(name, kLeft, 0.0f, 1.0f, wall_screen_name(column - 1, row),
+                               0.0f, 1.0f);
+            }
+            if (column + 1 < kWallColumns) {
+                config.connect(name, kRight, 0.0f, 1.0f, wall_screen_name(column + 1, row),
+                               0.0f, 1.0f);
+            }
+            if (row > 0) {
+                config.connect(name, kTop, 0.0f, 1.0f, wall_screen_name(column, row - 1),
+                               0.0f, 1.0f);
+            }
+            if (row + 1 < kWallRows) {
+                config.connect(name, kBottom, 0.0f, 0.5f, wall_screen_name(column, row + 1),
+                               0.0f, 0.5f);
+                config.connect(name, kBottom, 0.5f, 1.0f, wall_screen_name(column, row + 1),
+                               0.5f, 1.0f);
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST(ScreenTopologyTests, find_canonicalNameOrAlias_returnsSameScreen)
+{
+    Config config(nullptr);
+    make_wall_config(config);
+    ScreenTopology topology(config);
+
+    ScreenId screen = topology.find(wall_screen_name(0, 0));
+    ASSERT_NE(screen, kNoScreenId);
+    EXPECT_EQ(topology.find("FIRST-SCREEN-ALIAS"), screen);
+    EXPECT_EQ(ScreenIds::name(screen), wall_screen_name(0, 0));
+    EXPECT_EQ(topology.find("unknown"), kNoScreenId);
+    EXPECT_EQ(topology.size(), static_cast<std::size_t>(kWallColumns * kWallRows));
+}
+
+TEST(ScreenTopologyTests, neighbor_partialEdges_matchesConfig)
+{
+    Config config(nullptr);
+    config.addScreen("a");
+    config.addScreen("b");
+    config.addScreen("c");
+    config.connect("a", kRight, 0.25f, 0.5f, "b", 0.0f, 1.0f);
+    config.connect("a", kRight, 0.5f, 0.75f, "c", 0.5f, 1.0f);
+    config.connect("a", kLeft, 0.0f, 1.0f, "missing", 0.0f, 1.0f);
+    ScreenTopology topology(config);
+    ScreenId a = topology.find("a");
+
+    for (float position : { 0.0f, 0.2f, 0.25f, 0.3f, 0.5f, 0.6f, 0.75f, 0.99f }) {
+        for (EDirection side : { kLeft, kRight, kTop, kBottom }) {
+            float expected_position = -1.0f;
+            float actual_position = -1.0f;
+            std::string expected = config.getNeighbor("a", side, position, &expected_position);
+            ScreenId actual = topology.neighbor(a, side, position, &actual_position);
+            if (expected.empty()) {
+                EXPECT_EQ(actual, kNoScreenId);
+            } else {
+                ASSERT_NE(actual, kNoScreenId);
+                EXPECT_EQ(ScreenIds::name(actual), expected);
+                EXPECT_FLOAT_EQ(actual_position, expected_position);
+            }
+        }
+    }
+
+    EXPECT_TRUE(topology.has_neighbor(a, kLeft));
+    EXPECT_TRUE(topology.has_neighbor(a, kRight));
+    EXPECT_FALSE(topology.has_neighbor(a, kTop));
+    EXPECT_FALSE(topology.has_neighbor(topology.find("b"), kLeft));
+}
+
+TEST(ScreenTopologyTests, neighbor_screenNotInConfig_returnsNoScreen)
+{
+    Config config(nullptr);
+    config.addScreen("left-of-nothing");
+    ScreenTopology topology(config);
+
+    ScreenId other = ScreenIds::intern("screen-not-in-topology");
+    EXPECT_EQ(topology.neighbor(other, kLeft, 0.5f, nullptr), kNoScreenId);
+    EXPECT_FALSE(topology.has_neighbor(other, kLeft));
+    EXPECT_EQ(topology.neighbor(kNoScreenId, kRight, 0.5f, nullptr), kNoScreenId);
+}
+
+// Compares edge crossing lookups on a 100-screen wall through Config, as Server did before, and
+// through the precompiled topology.  The timings are recorded as test properties.
+TEST(ScreenTopologyTests, neighbor_wall100Screens_matchesConfigAndIsFaster)
+{
+    Config config(nullptr);
+    make_wall_config(config);
+    ScreenTopology topology(config);
+
+    const int kLookups = 100000;
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> screen_distribution(0, kWallColumns * kWallRows - 1);
+    std::uniform_int_distribution<int> side_distribution(kFirstDirection, kLastDirection);
+    std::uniform_real_distribution<float> position_distribution(0.0f, 1.0f);
+
+    struct Lookup {
+        int screen;
+        EDirection side;
+        float position;
+    };
+    std::vector<Lookup> lookups;
+    std::vector<std::string> names;
+    for (int i = 0; i < kWallColumns * kWallRows; i++) {
+        names.push_back(wall_screen_name(i % kWallColumns, i / kWallColumns));
+    }
+    for (int i = 0; i < kLookups; i++) {
+        lookups.push_back({screen_distribution(random),
+                           static_cast<EDirection>(side_distribution(random)),
+                           position_distribution(random)});
+    }
+
+    Stopwatch timer(false);
+    std::vector<std::string> config_results;
+    config_results.reserve(kLookups);
+    for (const auto& lookup : lookups) {
+        float position;
+        config_results.push_back(config.getNeighbor(names[lookup.screen], lookup.side,
+                                                    lookup.position, &position));
+    }
+    double config_time = timer.getTime();
+
+    std::vector<ScreenId> screens;
+    for (const auto& name : names) {
+        screens.push_back(topology.find(name));
+    }
+
+    timer.reset();
+    std::vector<ScreenId> topology_results;
+    topology_results.reserve(kLookups);
+    for (const auto& lookup : lookups) {
+        float position;
+        topology_results.push_back(topology.neighbor(screens[lookup.screen], lookup.side,
+                                                     lookup.position, &position));
+    }
+    double topology_time = timer.getTime();
+
+    RecordProperty("config_ns_per_lookup", static_cast<int>(config_time * 1e9 / kLookups));
+    RecordProperty("topology_ns_per_lookup", static_cast<int>(topology_time * 1e9 / kLookups));
+
+    for (int i = 0; i < kLookups; i++) {
+        if (config_results[i].empty()) {
+            EXPECT_EQ(topology_results[i], kNoScreenId);
+        } else {
+            ASSERT_NE(topology_results[i], kNoScreenId);
+            EXPECT_EQ(ScreenIds::name(topology_results[i]), config_results[i]);
+        }
+    }
+}
+
+} // namespace inputleap